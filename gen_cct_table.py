@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+色温表生成脚本
+读取实测数据 src/INDEX DUV R G B.txt，生成 src/cct_table.h（色温RGB表、档位色温、色温->档位映射）。
+作为 PlatformIO 的 pre 脚本在每次编译前运行，也可直接执行；内容未变时不改写文件，不触发重新编译。
+"""
+
+import os
+import sys
+
+try:
+    Import("env")  # noqa: F821  PlatformIO pre 脚本
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.abspath(__file__))
+
+SRC_TXT = os.path.join(PROJECT_DIR, "src", "INDEX DUV R G B.txt")
+OUT_H = os.path.join(PROJECT_DIR, "src", "cct_table.h")
+
+STEP_COUNT = 61
+DUV_VARIANTS = 5
+DUV_E5 = [600, 300, 0, -300, -600]   # 每档内 DUV 列顺序（1e-5）
+
+
+def step_kelvin(step):
+    """档位（1-61）的标称色温：1600-6500K 步长100K，7000-12000K 步长500K（与电流值表一致）"""
+    if step <= 50:
+        return 1600 + (step - 1) * 100
+    return 6500 + (step - 50) * 500
+
+
+def load_rows(path):
+    """读取并校验实测表，返回 [(r, g, b), ...]"""
+    rows = []
+    with open(path, encoding="utf-8") as f:
+        header = f.readline().split()
+        if header != ["INDEX", "DUV", "R", "G", "B"]:
+            raise ValueError("unexpected header: %r" % header)
+        for lineno, line in enumerate(f, start=2):
+            if not line.strip():
+                continue
+            idx, duv, r, g, b = line.split()
+            idx = int(idx)
+            if idx != len(rows) + 1:
+                raise ValueError("line %d: index %d out of sequence" % (lineno, idx))
+            duv_e5 = int(round(float(duv) * 100000))
+            if duv_e5 != DUV_E5[(idx - 1) % DUV_VARIANTS]:
+                raise ValueError("line %d: DUV %s does not match column order" % (lineno, duv))
+            rgb = (int(r), int(g), int(b))
+            if any(v < 0 or v > 255 for v in rgb):
+                raise ValueError("line %d: RGB out of range" % lineno)
+            rows.append(rgb)
+    if len(rows) != STEP_COUNT * DUV_VARIANTS:
+        raise ValueError("expected %d rows, got %d" % (STEP_COUNT * DUV_VARIANTS, len(rows)))
+    return rows
+
+
+def render(rows):
+    kelvins = [step_kelvin(s) for s in range(1, STEP_COUNT + 1)]
+    # 色温（按100K取整）-> 最近档位；相等距离取较低档
+    lut = []
+    for k100 in range(kelvins[0] // 100, kelvins[-1] // 100 + 1):
+        k = k100 * 100
+        best = min(range(STEP_COUNT), key=lambda i: (abs(kelvins[i] - k), i))
+        lut.append(best + 1)
+
+    out = []
+    out.append("// 由 gen_cct_table.py 根据 src/INDEX DUV R G B.txt 生成，请勿手工修改")
+    out.append("#pragma once")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("#define CCT_TABLE_STEPS %d" % STEP_COUNT)
+    out.append("#define CCT_TABLE_DUV_VARIANTS %d" % DUV_VARIANTS)
+    out.append("#define CCT_TABLE_KELVIN_LUT_BASE %d   // CCT_KELVIN_TO_STEP[0] 对应的色温/100" % (kelvins[0] // 100))
+    out.append("#define CCT_TABLE_KELVIN_LUT_SIZE %d" % len(lut))
+    out.append("")
+    out.append("// 色温RGB表：每%d行为一档色温的DUV变体（%s）" % (DUV_VARIANTS, ", ".join("%+.3f" % (d / 100000.0) for d in DUV_E5)))
+    out.append("static const uint8_t CCT_TABLE_RGB[%d][3] = {" % len(rows))
+    for step in range(STEP_COUNT):
+        out.append("    // %dK" % kelvins[step])
+        for d in range(DUV_VARIANTS):
+            r, g, b = rows[step * DUV_VARIANTS + d]
+            out.append("    {%d, %d, %d}," % (r, g, b))
+    out.append("};")
+    out.append("")
+    out.append("// DUV 列（1e-5）")
+    out.append("static const int16_t CCT_TABLE_DUV_E5[%d] = {%s};" % (DUV_VARIANTS, ", ".join(str(d) for d in DUV_E5)))
+    out.append("")
+    out.append("// 档位（1-%d）的标称色温，下标为档位-1" % STEP_COUNT)
+    out.append("static const uint16_t CCT_STEP_KELVIN[%d] = {" % STEP_COUNT)
+    for i in range(0, STEP_COUNT, 10):
+        out.append("    " + " ".join("%d," % k for k in kelvins[i:i + 10]))
+    out.append("};")
+    out.append("")
+    out.append("// 档位名称")
+    out.append("static const char* const CCT_STEP_NAME[%d] = {" % STEP_COUNT)
+    for i in range(0, STEP_COUNT, 10):
+        out.append("    " + " ".join('"%dK",' % k for k in kelvins[i:i + 10]))
+    out.append("};")
+    out.append("")
+    out.append("// 色温/100 - CCT_TABLE_KELVIN_LUT_BASE -> 最近档位（1-%d）" % STEP_COUNT)
+    out.append("static const uint8_t CCT_KELVIN_TO_STEP[%d] = {" % len(lut))
+    for i in range(0, len(lut), 20):
+        out.append("    " + " ".join("%d," % s for s in lut[i:i + 20]))
+    out.append("};")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    text = render(load_rows(SRC_TXT))
+    old = None
+    if os.path.exists(OUT_H):
+        with open(OUT_H, encoding="utf-8") as f:
+            old = f.read()
+    if old != text:
+        with open(OUT_H, "w", encoding="utf-8", newline="\n") as f:
+            f.write(text)
+        print("gen_cct_table: wrote %s" % OUT_H)
+
+
+try:
+    main()
+except (OSError, ValueError) as e:
+    print("gen_cct_table: %s" % e)
+    sys.exit(1)
@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+#include "timeline.h"
+
+// 亮度斜坡：按时间线而非帧数推进，帧率变化不影响时长；
+// 不读取系统时间，由调用方传入当前时刻，可在主机上直接编译
+
+// 亮度以 Q8 定点保存（0..100<<8），斜坡途中逐帧取值不会因取整而停顿；
+// EASE_PERCEPTUAL 在 CIE L* 空间匀速插值，升降两个方向视觉上都匀速；
+// 暂停期间斜坡时钟停在 pausedUs，恢复时时间线整体后移暂停时长
+struct BrightnessRamp {
+    uint32_t fromQ8;
+    uint32_t toQ8;
+    Timeline timeline;
+    bool paused;
+    uint64_t pausedUs;
+};
+
+// 立即停在 level（0..100）
+void brightness_ramp_init(BrightnessRamp* ramp, uint8_t level);
+// 从 nowUs 时刻的当前值出发，在 durationMs 内按 ease 过渡到 target；
+// 斜坡途中重新定向时起点取当前值，亮度不跳变
+void brightness_ramp_retarget(BrightnessRamp* ramp, uint8_t target, uint32_t durationMs, EaseCurve ease, uint64_t nowUs);
+// nowUs 时刻的亮度（Q8）
+uint32_t brightness_ramp_value_q8(const BrightnessRamp* ramp, uint64_t nowUs);
+// nowUs 时刻的亮度（0..100，四舍五入）
+uint8_t brightness_ramp_value(const BrightnessRamp* ramp, uint64_t nowUs);
+// 斜坡是否已到达目标
+bool brightness_ramp_done(const BrightnessRamp* ramp, uint64_t nowUs);
+// 在 nowUs 时刻暂停：此后取值保持不变，重新定向以暂停时刻为起点；已暂停时不变
+void brightness_ramp_pause(BrightnessRamp* ramp, uint64_t nowUs);
+// 在 nowUs 时刻恢复：从暂停时的值继续走完剩余时长，不跳变；未暂停时不变
+void brightness_ramp_resume(BrightnessRamp* ramp, uint64_t nowUs);
@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+
+// 连续色温/DUV引擎：在实测色温表的格点之间双线性插值，输出12位RGB；
+// 纯定点运算，不依赖平台，可在主机上直接编译
+
+#define CCT_STEP_COUNT 61        // 色温档位数（tempIndex 1..61）
+#define CCT_DUV_VARIANTS 5       // 每档的DUV变体数（duvIndex 1..5）
+#define CCT_KELVIN_MIN 1600
+#define CCT_KELVIN_MAX 12000
+// DUV 以 1e-5 为单位：表中各列为 +0.006、+0.003、0、-0.003、-0.006
+#define CCT_DUV_MAX_E5 600
+#define CCT_DUV_STEP_E5 300
+#define CCT_RGB12_MAX 4095
+
+// 表格点的8位RGB；档位或DUV索引越界返回false
+bool cct_grid_rgb8(uint8_t tempIndex, uint8_t duvIndex, uint8_t* r, uint8_t* g, uint8_t* b);
+// 档位（1..61）的标称色温（K），越界返回0
+uint16_t cct_step_kelvin(uint8_t tempIndex);
+// 档位名称（如 "2700K"），越界返回nullptr
+const char* cct_step_name(uint8_t tempIndex);
+// 色温（K）-> 最近档位（1..61），按100K取整查表，超出范围钳位
+uint8_t cct_kelvin_to_step(uint16_t kelvin);
+// 8位分量对应的12位值：round(v*4095/255)，插值结果在格点上与之逐位一致
+uint16_t cct_rgb8_to_12(uint8_t v);
+
+// 色温（K）-> 连续档位坐标（Q8，0 对应第1档），超出表范围钳位；
+// 1600-6500K 每100K一档，6500-12000K 每500K一档
+uint16_t cct_kelvin_to_pos_q8(uint16_t kelvin);
+// 连续档位坐标（Q8）与连续DUV（1e-5）处的12位RGB，超出表范围钳位到边缘
+void cct_rgb12_at(uint16_t posQ8, int16_t duvE5, uint16_t rgb[3]);
+// 色温（K）与DUV（1e-5）处的12位RGB
+void cct_kelvin_rgb12(uint16_t kelvin, int16_t duvE5, uint16_t rgb[3]);
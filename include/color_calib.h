@@ -0,0 +1,25 @@
+#pragma once
+#include <stdint.h>
+
+// 灯具颜色校准：亮度缩放之后逐芯片做 3x3 矩阵 + 通道偏移，补偿不同批次灯珠的色差；
+// 纯定点运算，不依赖平台，可在主机上直接编译
+
+#define COLOR_CALIB_ONE 4096          // 矩阵系数 Q12（1.0）
+#define COLOR_CALIB_OFFSET_MAX 255    // 偏移范围 ±255（码值）
+#define COLOR_CALIB_WIRE_SIZE 24      // 串口/NVS 序列化长度：9个系数 + 3个偏移，int16 高字节在前
+
+// out[c] = clamp(round(sum_k m[c*3+k]*in[k] / ONE) + offset[c], 0, 255)；输入 (0,0,0) 的芯片保持全黑
+struct ColorCalib {
+    int16_t m[9];        // 行：输出R、G、B；列：输入R、G、B
+    int16_t offset[3];
+};
+
+void color_calib_identity(ColorCalib* calib);
+bool color_calib_is_identity(const ColorCalib* calib);
+// 偏移超出范围时返回false
+bool color_calib_valid(const ColorCalib* calib);
+// 原地校正 chips 颗芯片的RGB
+void color_calib_apply(const ColorCalib* calib, uint8_t* rgb, int chips);
+
+void color_calib_encode(const ColorCalib* calib, uint8_t out[COLOR_CALIB_WIRE_SIZE]);
+void color_calib_decode(const uint8_t in[COLOR_CALIB_WIRE_SIZE], ColorCalib* calib);
@@ -2,87 +2,80 @@
 #include <cstdint>
 
 // 色温系统配置
-#define COLOR_TEMP_STANDARD_COUNT 61    // 标准色温数量 (2700K-6500K)
+#define COLOR_TEMP_STANDARD_COUNT 61    // 标准色温数量 (1600K-12000K)
 #define COLOR_TEMP_DUV_VARIANTS 5       // 每个色温的DUV变体数量
 #define COLOR_TEMP_TOTAL_COUNT (COLOR_TEMP_STANDARD_COUNT * COLOR_TEMP_DUV_VARIANTS)  // 总色温数量
 
-// DUV微调方向
+// DUV微调方向（与实测表的列顺序一致）
 enum DuvDirection {
-    DUV_MINUS_2 = 0,  // 最偏绿
-    DUV_MINUS_1 = 1,  // 偏绿
+    DUV_PLUS_2 = 0,   // DUV=+0.006，最偏绿
+    DUV_PLUS_1 = 1,   // DUV=+0.003，偏绿
     DUV_ZERO = 2,     // 标准 (DUV=0)
-    DUV_PLUS_1 = 3,   // 偏紫
-    DUV_PLUS_2 = 4    // 最偏紫
+    DUV_MINUS_1 = 3,  // DUV=-0.003，偏紫
+    DUV_MINUS_2 = 4   // DUV=-0.006，最偏紫
 };
 
 // 色温结构体
 struct ColorTemperature {
     uint16_t kelvin;      // 色温值 (K)
-    float duv;           // DUV偏移值
-    uint8_t r, g, b;     // RGB值
-    const char* name;    // 色温名称
+    int16_t duvE5;        // DUV偏移值（1e-5）
+    uint8_t r, g, b;      // RGB值
+    const char* name;     // 色温名称
 };
 
-// 色温管理器
+// 色温管理器：数据来自编译前由实测表生成的 cct_table.h，查询均为 O(1)，不做浮点运算。
+// 索引 0-304 = (色温档位-1)*5 + DUV方向
 class ColorTemperatureManager {
 public:
     ColorTemperatureManager();
     ~ColorTemperatureManager();
-    
-    // 初始化色温系统
+
+    // 初始化色温系统（表为编译期常量，始终成功）
     bool init();
-    
+
     // 根据索引获取色温 (0-304)
     bool getColorTempByIndex(uint16_t index, ColorTemperature& colorTemp);
-    
-    // 根据色温和DUV获取RGB值
+
+    // 根据色温（取最近档位）和DUV获取RGB值
     bool getColorTempRGB(uint16_t kelvin, DuvDirection duv, uint8_t* r, uint8_t* g, uint8_t* b);
-    
-    // 根据索引获取RGB值 (兼容旧接口)
+
+    // 根据档位获取RGB值 (兼容旧接口，档位1-61，DUV=0)
     void getColorTempRGB(uint8_t tempIndex, uint8_t* r, uint8_t* g, uint8_t* b);
-    
-    // 获取色温信息
+
+    // 串口协议的色温档位（1-61）与DUV索引（1-5，对应 DuvDirection+1）
+    static bool isValidStep(uint8_t tempIndex, uint8_t duvIndex);
+    // 档位与DUV索引对应的实测RGB，越界输出黑色并返回false
+    static bool getStepRGB(uint8_t tempIndex, uint8_t duvIndex, uint8_t* r, uint8_t* g, uint8_t* b);
+
+    // 获取色温信息（索引越界时返回0 / DUV_ZERO / nullptr）
     uint16_t getKelvinByIndex(uint16_t index);
     DuvDirection getDuvByIndex(uint16_t index);
     const char* getNameByIndex(uint16_t index);
-    
+
     // 色温范围查询
-    uint16_t getMinKelvin() const { return 2700; }
-    uint16_t getMaxKelvin() const { return 6500; }
-    
+    uint16_t getMinKelvin() const { return 1600; }
+    uint16_t getMaxKelvin() const { return 12000; }
+
     // 获取标准色温数量
     uint16_t getStandardCount() const { return COLOR_TEMP_STANDARD_COUNT; }
-    
+
     // 获取总色温数量
     uint16_t getTotalCount() const { return COLOR_TEMP_TOTAL_COUNT; }
-    
+
     // 色温转换工具
+    // 任意色温（DUV=0）在相邻档位间插值得到的RGB
     static void kelvinToRGB(uint16_t kelvin, uint8_t* r, uint8_t* g, uint8_t* b);
-    static void applyDuvAdjustment(uint8_t* r, uint8_t* g, uint8_t* b, float duv);
+    // 任意色温与DUV（1e-5，±600）插值得到的RGB
+    static void kelvinDuvToRGB(uint16_t kelvin, int16_t duvE5, uint8_t* r, uint8_t* g, uint8_t* b);
     static uint16_t indexToKelvin(uint16_t index);
     static DuvDirection indexToDuv(uint16_t index);
+    // 色温取最近档位，超出范围钳位
     static uint16_t kelvinDuvToIndex(uint16_t kelvin, DuvDirection duv);
-    
+
     // 预设色温
     static const uint16_t PRESET_WARM_WHITE = 2700;      // 暖白
     static const uint16_t PRESET_SOFT_WHITE = 3000;      // 软白
     static const uint16_t PRESET_COOL_WHITE = 4000;      // 冷白
     static const uint16_t PRESET_DAYLIGHT = 5000;        // 日光
     static const uint16_t PRESET_COOL_DAYLIGHT = 6500;   // 冷日光
-
-private:
-    // 标准色温表 (61个标准色温)
-    static const uint16_t STANDARD_KELVINS[COLOR_TEMP_STANDARD_COUNT];
-    
-    // DUV偏移值表
-    static const float DUV_OFFSETS[COLOR_TEMP_DUV_VARIANTS];
-    
-    // 色温名称表
-    static const char* TEMP_NAMES[COLOR_TEMP_STANDARD_COUNT];
-    
-    // 计算色温到RGB的转换
-    static void calculateKelvinRGB(uint16_t kelvin, uint8_t* r, uint8_t* g, uint8_t* b);
-    
-    // 应用DUV调整
-    static void applyDuvShift(uint8_t* r, uint8_t* g, uint8_t* b, float duv, uint16_t kelvin);
-}; 
\ No newline at end of file
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <stdint.h>
+
+// gamma 2.2 查表混合：8位sRGB <-> 16位线性，逐帧定点插值，不调用 powf
+
+// 插值系数的定点1.0（12位小数）
+#define GAMMA_BLEND_ONE 4096
+
+// 8位sRGB -> 16位线性：round((i/255)^2.2 * 65535)
+extern const uint16_t GAMMA_TO_LINEAR[256];
+// 16位线性的高12位 -> 8位sRGB：取每段线性区间中点的反变换
+extern const uint8_t GAMMA_FROM_LINEAR[4096];
+
+static inline uint16_t gamma_to_linear(uint8_t c)
+{
+    return GAMMA_TO_LINEAR[c];
+}
+
+static inline uint8_t gamma_from_linear(uint16_t lin)
+{
+    return GAMMA_FROM_LINEAR[lin >> 4];
+}
+
+// 在线性空间混合两个8位值，t 为 0..GAMMA_BLEND_ONE；
+// 两端精确返回 a/b，结果限制在 [a,b] 区间内（低亮度段反查表精度有限，避免黑色被抬亮）
+uint8_t gamma_blend(uint8_t a, uint8_t b, uint32_t t);
+// 逐字节混合 len 字节；linear=false 时直接在sRGB空间线性插值
+void gamma_blend_frame(const uint8_t* from, const uint8_t* to, uint8_t* dst, int len, uint32_t t, bool linear);
@@ -0,0 +1,21 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// images.h 动画素材格式：
+// 第1-2字节：帧数N（大端），第3字节：帧延迟MS，其后为 N 帧 6x6 矩阵序RGB
+#define IMAGE_ASSET_HEADER_SIZE 3
+#define IMAGE_ASSET_WIDTH 6
+#define IMAGE_ASSET_HEIGHT 6
+#define IMAGE_ASSET_FRAME_SIZE (IMAGE_ASSET_WIDTH * IMAGE_ASSET_HEIGHT * 3)
+
+// 解析后的素材；frames 指向原数组（映射在flash中，不复制）
+struct ImageAssetInfo {
+    const uint8_t* frames;
+    uint16_t frameCount;
+    uint8_t frameDelayMs;
+};
+
+// 校验素材头：帧数非0，帧延迟非0（1-255ms），且负载长度恰为 帧数*IMAGE_ASSET_FRAME_SIZE
+// （size 为整个数组字节数）；失败时返回false，error 指出原因，out 清零
+bool image_asset_parse(const uint8_t* data, size_t size, ImageAssetInfo* out, const char** error);
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+
+// 面板配置
+#define PANEL_MAX_CHIPS 1024        // 链上芯片数上限
+#define PANEL_DEFAULT_WIDTH 6       // 默认面板：6x6
+#define PANEL_DEFAULT_HEIGHT 6
+#define PANEL_MAX_CHANNELS 4        // 并行输出的RMT通道数上限
+#define PANEL_DEFAULT_GPIO 25       // 默认单通道输出引脚
+
+// 输出通道：链按顺序切分为若干子链，每个通道驱动一段
+struct PanelChannel {
+    uint16_t chipCount;  // 本通道子链芯片数
+    uint8_t gpio;
+};
+
+// 面板描述符：矩阵尺寸 + 链序映射表 + 输出通道划分
+// chainOrder[i] 为链上第i颗芯片对应的矩阵像素索引（行优先，y*width+x）
+// 通道c驱动链上紧随通道c-1之后的 channels[c].chipCount 颗芯片
+struct PanelDescriptor {
+    uint16_t width;
+    uint16_t height;
+    uint16_t chipCount;
+    uint16_t chainOrder[PANEL_MAX_CHIPS];
+    uint8_t channelCount;
+    PanelChannel channels[PANEL_MAX_CHANNELS];
+};
+
+// 启动时从NVS加载面板描述符；无记录或数据无效时使用默认6x6面板
+bool panel_load(void);
+// 校验并保存面板描述符到NVS，重启后生效（order为空时按行优先直连；
+// channels为空时整条链由默认引脚单通道输出）
+bool panel_save(uint16_t width, uint16_t height, const uint16_t* order,
+                const PanelChannel* channels = nullptr, int channelCount = 0);
+
+// 当前面板
+const PanelDescriptor& panel_get(void);
+int panel_width(void);
+int panel_height(void);
+int panel_chip_count(void);
+int panel_frame_size(void);  // 每帧字节数 = 芯片数*3
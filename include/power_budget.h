@@ -0,0 +1,30 @@
+#pragma once
+#include <stdint.h>
+
+// 功率预算：按各通道码值之和与每码值电流系数估算整帧电流，
+// 超出预算时逐帧平滑收紧一个全局缩放，回落后再缓慢放开；纯定点运算，可在主机上直接编译
+
+#define POWER_SCALE_ONE 4096            // 全局缩放 Q12（1.0）
+#define POWER_ATTACK_SHIFT 1            // 超预算时每帧走剩余差值的 1/2
+#define POWER_RELEASE_SHIFT 3           // 放开时每帧走剩余差值的 1/8
+#define POWER_HYSTERESIS_SHIFT 4        // 回差：估算低于预算的 15/16 才放开
+// 每码值电流的默认值，来自 src/200mA-1600K-12000k 电流值表.xlsx：
+// 表中305行逐行给出单颗芯片 R/G/B 灯电流(mA)，与同一色温/DUV在 src/INDEX DUV R G B.txt 中的码值逐项相等
+// （如 1600K、DUV+0.006：电流 180/16/3mA，码值 180/16/3），每行三路合计 199~201mA 即表名中的 200mA；
+// 故驱动增益为默认值时 电流(mA) = 码值 x 1mA，即每码值 1000µA，三通道相同。更换灯珠或增益时按实测重新标定
+#define POWER_UA_PER_CODE_DEFAULT 1000
+
+struct PowerBudget {
+    uint16_t uaPerCode[3];   // R、G、B 每码值电流（µA，驱动增益为默认值时）
+    uint32_t budgetMa;       // 预算（mA），0 表示不限流
+    uint32_t scaleQ12;       // 当前全局缩放，由发送路径并入亮度缩放表
+    uint32_t estimateMa;     // 最近一帧（已缩放）的估算电流
+};
+
+void power_budget_init(PowerBudget* pb, uint32_t budgetMa);
+// 逐芯片累加 R、G、B 码值到 sums（调用方先清零）
+void power_accumulate(const uint8_t* rgb, int chips, uint32_t sums[3]);
+// 码值和 -> 估算电流（mA，四舍五入）
+uint32_t power_estimate_ma(const PowerBudget* pb, const uint32_t sums[3]);
+// 提交一帧的码值和：记录估算电流，朝预算允许的缩放推进一步，返回下一帧使用的缩放
+uint32_t power_budget_update(PowerBudget* pb, const uint32_t sums[3]);
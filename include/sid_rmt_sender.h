@@ -3,6 +3,10 @@
 #include <stdint.h>
 #include <Arduino.h>
 #include <driver/rmt.h>
+#include "panel_config.h"
+#include "brightness_ramp.h"
+#include "color_calib.h"
+#include "power_budget.h"
 
 // 串口打印控制开关
 #define ENABLE_SERIAL_PRINT 1  // 设置为0可以关闭所有串口打印
@@ -20,22 +24,81 @@ void debug_println(unsigned int value);
 void debug_println(long value);
 void debug_println(unsigned long value);
 
-#define SID_MAX_CHIPS 36 // 可根据实际需求调整
-static const uint8_t LED_MATRIX_PATTERN[SID_MAX_CHIPS] = {
-    0x0C, 0x06, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x0B, 0x11, 0x0D, 0x07,
-    0x08, 0x09, 0x0E, 0x0F, 0x0A, 0x10, 0x17, 0x1D, 0x23, 0x22, 0x21, 0x20,
-    0x1F, 0x1E, 0x18, 0x12, 0x16, 0x1C, 0x1B, 0x1A, 0x15, 0x14, 0x19, 0x13
-};
 // 亮度调节功能 (0-100)
 extern uint8_t global_brightness;
+// 灯开关状态
+extern bool lightPower;
+// 驱动芯片时序档：帧头/帧尾锁存低电平时长（RMT tick，1 tick = 12.5ns）
+struct SidTimingProfile {
+    const char* name;
+    uint32_t headLowTicks;
+    uint32_t tailLowTicks;
+};
+extern const SidTimingProfile SID_TIMING_STANDARD;      // 原有时序（默认）
+extern const SidTimingProfile SID_TIMING_SID_MIN_SAFE;  // SID芯片最小安全锁存
+// 内置时序档编号（串口0xA5与NVS使用）
+#define SID_TIMING_PROFILE_STANDARD 0
+#define SID_TIMING_PROFILE_SID_MIN_SAFE 1
+#define SID_TIMING_PROFILE_COUNT 2
+#define SID_TIMING_PROFILE_CUSTOM 0xFF  // 当前为 sid_rmt_set_timing_profile 设置的自定义时序
+
+// 需在 panel_load() 之后调用：按面板通道划分配置RMT通道并分配发送缓冲
 void sid_rmt_init(void);
+// 切换时序档（复制保存），时长超出item可表示范围时返回false
+bool sid_rmt_set_timing_profile(const SidTimingProfile& profile);
+const SidTimingProfile& sid_rmt_get_timing_profile(void);
+// 按编号切换内置时序档，save为true时同时写入NVS，sid_rmt_init 启动时加载
+bool sid_rmt_select_timing_profile(uint8_t id, bool save);
+uint8_t sid_rmt_get_timing_profile_id(void);
+// 帧线上时长模型（纯计算，不访问硬件）：单条子链时长，以及多通道并行时取最长子链
+uint32_t sid_rmt_chain_wire_us(int chip_count, const SidTimingProfile& timing);
+uint32_t sid_rmt_frame_wire_us(const PanelChannel* channels, int channel_count, const SidTimingProfile& timing);
+// 给定通道划分与时序档下线上时长允许的最高帧率
+uint32_t sid_rmt_max_fps(const PanelChannel* channels, int channel_count, const SidTimingProfile& timing);
+// 当前面板与当前时序档下的帧线上时长 / 最高帧率
+uint32_t sid_rmt_current_frame_wire_us(void);
+uint32_t sid_rmt_current_max_fps(void);
+// buf 为矩阵序（行优先）整帧，发送时按面板链序映射表重排
 void send_data(const uint8_t* buf, int len, uint16_t gain);
+// buf 已是链序（第i个像素即链上第i颗芯片），线性发送
+void send_chain_data(const uint8_t* buf, int len, uint16_t gain);
+// 矩阵序帧转换为链序（src 与 dst 不可重叠）
+void sid_matrix_to_chain(const uint8_t* src, uint8_t* dst, int len);
+// 异步双缓冲发送：开启后 send_data 启动传输即返回，下一帧编码与本帧传输重叠
+void sid_rmt_set_async(bool enabled);
+bool sid_rmt_get_async(void);
+// 颜色校准：亮度缩放后逐芯片应用 3x3 矩阵与偏移，单位矩阵时不参与发送路径。
+// sid_rmt_init 中自动从NVS加载；sid_calib_set 校验失败或写NVS失败时返回false且不生效
+void sid_calib_load(void);
+bool sid_calib_set(const ColorCalib* calib, bool save);
+void sid_calib_get(ColorCalib* calib);
+// 功率预算（mA）默认值，按电源额定电流经编译选项配置；0 表示不限流
+#ifndef SID_POWER_BUDGET_MA
+#define SID_POWER_BUDGET_MA 0
+#endif
+// 发送路径每帧按线上码值估算电流，超出预算时平滑收紧全局缩放（并入亮度缩放表，下一帧生效）
+void sid_power_set_budget_ma(uint32_t budget_ma);
+uint32_t sid_power_get_budget_ma(void);
+// 各通道每码值电流（µA），默认取自电流值表
+void sid_power_set_coefficients(const uint16_t ua_per_code[3]);
+// 最近一帧的估算电流（mA，已含亮度、校准与限流），关灯时为0
+uint32_t sid_power_estimate_ma(void);
+// 当前全局缩放（Q12，POWER_SCALE_ONE 为不限流）
+uint16_t sid_power_scale_q12(void);
+// 重复帧抑制：帧内容不变时跳过发送，每 keepalive_ms 强制刷新一次（0=关闭抑制）
+void sid_rmt_set_keepalive_ms(uint32_t keepalive_ms);
+// 已发送/已跳过帧计数
+void sid_rmt_get_frame_stats(uint32_t* sent, uint32_t* skipped);
+// set_brightness 默认斜坡速度：每级亮度（1%）的过渡时长
+#define SID_BRIGHTNESS_MS_PER_STEP 20
+// 设置目标亮度（0-100），按默认速度匀速过渡，立即返回
 void set_brightness(uint8_t brightness);
+// 目标亮度
 uint8_t get_brightness(void);
-// 帧同步：每次调用推进一步并返回当前应用亮度（±1 或按特殊淡出策略）
+// 发送路径每帧调用：返回斜坡在当前时刻的亮度
 uint8_t get_brightness_frame(void);
-// 启动一个帧同步亮度淡入/淡出到目标值（用于 dimmer_blank 内部调用）
-void start_brightness_fade(uint8_t target, uint8_t frames);
-void getColorTempRGB(uint8_t tempIndex, uint8_t* r, uint8_t* g, uint8_t* b);
-void getColorTempRGBWithDuv(uint8_t tempIndex, uint8_t duvIndex, uint8_t* r, uint8_t* g, uint8_t* b);
+// 在 duration_ms 内按 ease 过渡到目标亮度，立即返回；途中可再次调用重新定向，亮度不跳变
+void start_brightness_ramp(uint8_t target, uint32_t duration_ms, EaseCurve ease);
+// 亮度斜坡是否仍在进行
+bool brightness_ramp_active(void);
 #endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include <stdint.h>
+
+// SID波形解码/校验：输入为 rmt_item32_t 的整字序列（item.val），
+// 不依赖 Arduino 与 RMT 驱动，可在主机上直接编译
+
+// 位时序（RMT tick）与容差；复位低电平不短于 minResetTicks 才视为帧头/帧尾
+struct SidWaveTiming {
+    uint16_t t0h;
+    uint16_t t0l;
+    uint16_t t1h;
+    uint16_t t1l;
+    uint16_t tolerance;
+    uint32_t minResetTicks;
+};
+
+// 解码结果：rgb 由调用方提供，容量 rgbCapacity 字节（链序，每芯片3字节）
+struct SidDecodedFrame {
+    uint8_t* rgb;
+    int rgbCapacity;
+    int chipCount;
+    uint16_t gain;
+    uint32_t headLowTicks;   // 首个数据位之前的低电平
+    uint32_t tailLowTicks;   // 末位低电平之后的低电平
+    uint32_t totalTicks;     // 整帧线上时长
+    int errorPos;            // 出错的电平段序号，-1 表示无错
+    const char* error;
+};
+
+// 解码一帧并逐段校验高/低电平时长；失败时 error/errorPos 指出首个问题
+bool sid_wave_decode(const uint32_t* items, int count, const SidWaveTiming& timing, SidDecodedFrame* out);
@@ -0,0 +1,42 @@
+#pragma once
+#include <stdint.h>
+
+// 时间线与缓动：过渡时长以毫秒指定，按单调微秒时钟求进度，与帧率无关；
+// 全部定点运算，不读取系统时间，由调用方传入当前时刻，可在主机上直接编译
+
+// 进度/缓动值为 Q16（0..TIMELINE_ONE）
+#define TIMELINE_ONE 65536u
+
+// 缓动曲线
+enum EaseCurve {
+    EASE_LINEAR,          // 匀速
+    EASE_IN_CUBIC,        // 先慢后快：t^3
+    EASE_OUT_CUBIC,       // 先快后慢：1-(1-t)^3
+    EASE_IN_OUT_CUBIC,    // 两端慢中间快（三次）
+    EASE_IN_OUT_EXPO,     // 两端极慢中间极快（2^(20t-10)）
+    EASE_PERCEPTUAL,      // CIE L*：明度匀速上升时的相对亮度，0->1 渐亮在视觉上匀速
+};
+
+struct Timeline {
+    uint64_t startUs;
+    uint32_t durationUs;
+    EaseCurve ease;
+};
+
+// 缓动：t 与返回值均为 Q16，端点精确（0->0，ONE->ONE），单调不减
+uint32_t ease_q16(EaseCurve ease, uint32_t t);
+
+// 从 nowUs 起在 durationMs 内走完；durationMs 为0时立即完成
+void timeline_start(Timeline* tl, uint32_t durationMs, EaseCurve ease, uint64_t nowUs);
+// nowUs 时刻的线性进度（Q16，未缓动）
+uint32_t timeline_linear_q16(const Timeline* tl, uint64_t nowUs);
+// nowUs 时刻的缓动进度（Q16）
+uint32_t timeline_progress_q16(const Timeline* tl, uint64_t nowUs);
+// nowUs 时刻是否已走完
+bool timeline_done(const Timeline* tl, uint64_t nowUs);
+// 自开始起经过的毫秒数（开始前为0，走完后不再增长）
+uint32_t timeline_elapsed_ms(const Timeline* tl, uint64_t nowUs);
+
+// CIE 1976 明度与相对亮度互换，均为 Q16（L* 0..100 映射到 0..ONE）
+uint32_t cie_lightness_to_luminance_q16(uint32_t lightness);
+uint32_t cie_luminance_to_lightness_q16(uint32_t luminance);
@@ -39,6 +39,9 @@ class StaticAnimation : public Animation {
 public:
     StaticAnimation(uint8_t r, uint8_t g, uint8_t b, const char* name = "Static");
     StaticAnimation(const uint8_t* rgbData, const char* name = "Static");
+    ~StaticAnimation() override;
+    StaticAnimation(const StaticAnimation&) = delete;
+    StaticAnimation& operator=(const StaticAnimation&) = delete;
     
     void generateFrame(uint8_t* buffer, int frameIndex) override;
     int getFrameCount() const override { return 1; }
@@ -50,7 +53,7 @@ public:
     void getColor(uint8_t& r, uint8_t& g, uint8_t& b) const;
     
 private:
-    uint8_t rgbData_[108];  // 36个LED * 3字节
+    uint8_t* rgbData_;  // 面板芯片数 * 3字节
     const char* name_;
 };
 
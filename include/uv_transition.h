@@ -0,0 +1,36 @@
+#pragma once
+#include <stdint.h>
+
+// 色温过渡的感知路径：起止颜色经灯具 RGB->XYZ 矩阵换算到 CIE 1976 u'v' 与亮度Y，
+// 沿普朗克轨迹按倒数色温（mired）插值，保持相对轨迹的 DUV 偏移，再换回RGB；
+// 避免RGB直线混合时中途偏绿/偏紫。逐帧求值全部为定点运算，可在主机上直接编译
+
+// 灯具色度模型：线性RGB（码值/255，LED驱动按码值线性输出）-> XYZ，Q16
+struct UvFixture {
+    int32_t rgbToXyz[9];
+    int32_t xyzToRgb[9];
+};
+
+// 由实测色温表拟合的默认矩阵（行：X、Y、Z；列：R、G、B，Y(1,1,1)=1）
+extern const float UV_FIXTURE_DEFAULT_MATRIX[9];
+
+// 按 RGB->XYZ 矩阵（行优先）初始化，矩阵不可逆时返回false（仅配置时调用，可用浮点）
+bool uv_fixture_init(UvFixture* fx, const float rgbToXyz[9]);
+
+// 一次过渡的预计算系数：起止点的倒数色温、DUV、亮度及端点残差
+struct UvTransition {
+    const UvFixture* fixture;
+    int32_t miredFromQ8, miredToQ8;    // 倒数色温（Q8）
+    int32_t duvFromQ20, duvToQ20;      // 相对轨迹的 1960 uv 法向偏移（Q20）
+    int32_t yFromQ16, yToQ16;          // 亮度Y
+    int32_t residualFrom[3];           // 端点处路径与实际颜色的线性RGB差（Q16），逐帧插值补偿，端点精确
+    int32_t residualTo[3];
+};
+
+// 为 from -> to（8位RGB）预计算过渡；两端都是黑色时返回false，由调用方退回RGB混合
+bool uv_transition_plan(UvTransition* tr, const UvFixture* fx, const uint8_t from[3], const uint8_t to[3]);
+// 进度 tQ16（0..65536）处的颜色；两端精确返回 from/to
+void uv_transition_eval(const UvTransition* tr, uint32_t tQ16, uint8_t out[3]);
+
+// 8位RGB在灯具模型下的 u'v'（Q20）与Y（Q16），黑色返回false；供诊断与测试
+bool uv_fixture_chromaticity(const UvFixture* fx, const uint8_t rgb[3], int32_t* upQ20, int32_t* vpQ20, int32_t* yQ16);
@@ -1,13 +1,19 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include "image_asset.h"
 
 // 动画效果基类
 class AnimEffect {
 public:
     virtual ~AnimEffect() = default;
     
-    // 生成动画数据的虚函数
-    virtual void generateAnimation(uint8_t* animFrames, int frameCount, int frameSize) = 0;
+    // 渲染第 index 帧（0..getFrameCount()-1）到 dst，由渲染任务在出帧前按需调用
+    virtual void renderFrame(int index, uint8_t* dst, int frameSize) = 0;
+    // 一次生成连续多帧（逐帧调用 renderFrame）
+    virtual void generateAnimation(uint8_t* animFrames, int frameCount, int frameSize);
+    // 第 index 帧已按当前面板尺寸存放在常驻内存（如flash素材）时返回其地址，渲染端直接读取免拷贝；否则返回nullptr
+    virtual const uint8_t* frameData(int /*index*/) const { return nullptr; }
     
     // 获取动画名称
     virtual const char* getName() const = 0;
@@ -15,6 +21,8 @@ public:
     virtual int getFrameCount() const = 0;
     // 帧间延时（毫秒）
     virtual int getFrameDelay() const { return 20; }
+    // 输出像素顺序：false=矩阵序（行优先，需按面板链序映射表重排），true=已是链序
+    virtual bool isChainOrder() const { return false; }
 
     // 类型探测与可选接口（避免使用 RTTI）
     virtual bool isColorTemp() const { return false; }
@@ -29,7 +37,7 @@ class BreathEffect : public AnimEffect {
 public:
     BreathEffect(uint8_t r = 255, uint8_t g = 100, uint8_t b = 50, int frames = 100) : r_(r), g_(g), b_(b), frames_(frames) {}
     
-    void generateAnimation(uint8_t* animFrames, int frameCount, int frameSize) override;
+    void renderFrame(int index, uint8_t* dst, int frameSize) override;
     const char* getName() const override { return "Breath"; }
     int getFrameCount() const override { return frames_; }
     
@@ -43,7 +51,7 @@ class RainbowEffect : public AnimEffect {
 public:
     RainbowEffect(int frames = 120) : frames_(frames) {}
     
-    void generateAnimation(uint8_t* animFrames, int frameCount, int frameSize) override;
+    void renderFrame(int index, uint8_t* dst, int frameSize) override;
     const char* getName() const override { return "Rainbow"; }
     int getFrameCount() const override { return frames_; }
 private:
@@ -55,7 +63,7 @@ class BlinkEffect : public AnimEffect {
 public:
     BlinkEffect(uint8_t r = 255, uint8_t g = 255, uint8_t b = 255, int frames = 60) : r_(r), g_(g), b_(b), frames_(frames) {}
     
-    void generateAnimation(uint8_t* animFrames, int frameCount, int frameSize) override;
+    void renderFrame(int index, uint8_t* dst, int frameSize) override;
     const char* getName() const override { return "Blink"; }
     int getFrameCount() const override { return frames_; }
     
@@ -71,7 +79,7 @@ public:
                    uint8_t r2 = 0, uint8_t g2 = 0, uint8_t b2 = 255, int frames = 80)
         : r1_(r1), g1_(g1), b1_(b1), r2_(r2), g2_(g2), b2_(b2), frames_(frames) {}
     
-    void generateAnimation(uint8_t* animFrames, int frameCount, int frameSize) override;
+    void renderFrame(int index, uint8_t* dst, int frameSize) override;
     const char* getName() const override { return "Gradient"; }
     int getFrameCount() const override { return frames_; }
     
@@ -85,7 +93,7 @@ private:
 class WhiteStaticEffect : public AnimEffect {
 public:
     WhiteStaticEffect(uint8_t w = 255) : w_(w) {}
-    void generateAnimation(uint8_t* animFrames, int frameCount, int frameSize) override;
+    void renderFrame(int index, uint8_t* dst, int frameSize) override;
     const char* getName() const override { return "WhiteStatic"; }
     int getFrameCount() const override { return 1; }
 private:
@@ -96,7 +104,7 @@ private:
 class ColorTempEffect : public AnimEffect {
 public:
     ColorTempEffect(uint8_t tempIndex = 1, uint8_t duvIndex = 3) : tempIndex_(tempIndex), duvIndex_(duvIndex) {}
-    void generateAnimation(uint8_t* animFrames, int frameCount, int frameSize) override;
+    void renderFrame(int index, uint8_t* dst, int frameSize) override;
     const char* getName() const override { return "ColorTemp"; }
     int getFrameCount() const override { return 1; }
     void setColorTemp(uint8_t tempIndex) override { tempIndex_ = tempIndex; }
@@ -109,26 +117,29 @@ private:
     uint8_t duvIndex_;  // DUV索引 (1-5)
 };
 
-// 图像数据效果 - 从images.h加载预定义的动画数据
+// 图像数据效果 - 直接播放images.h中的预定义动画数据（数组留在flash中，不复制到堆）
 class ImageDataEffect : public AnimEffect {
 public:
-    ImageDataEffect(const uint8_t* imageData = nullptr) : imageData_(imageData) {}
-    void generateAnimation(uint8_t* animFrames, int frameCount, int frameSize) override;
+    ImageDataEffect() {}
+    ImageDataEffect(const uint8_t* imageData, size_t size) { setImageData(imageData, size); }
+    // 直接传数组时按数组长度校验
+    template <size_t N>
+    ImageDataEffect(const uint8_t (&imageData)[N]) { setImageData(imageData, N); }
+
+    void renderFrame(int index, uint8_t* dst, int frameSize) override;
+    const uint8_t* frameData(int index) const override;
     const char* getName() const override { return "ImageData"; }
-    int getFrameCount() const override { 
-        if (!imageData_) return 1;
-        // 从数据头部读取帧数 (第1-2字节，大端模式)
-        return (imageData_[0] << 8) | imageData_[1]; 
-    }
-    int getFrameDelay() const override {
-        if (!imageData_) return 50;
-        // 从数据头部读取延迟 (第3字节)
-        return imageData_[2];
-    }
-    void setImageData(const uint8_t* imageData) { imageData_ = imageData; }
+    int getFrameCount() const override { return asset_.frameCount ? asset_.frameCount : 1; }
+    int getFrameDelay() const override { return asset_.frames ? asset_.frameDelayMs : 50; }
+    // 设置素材并校验头部；校验失败时播放黑帧，原因见 getError()
+    bool setImageData(const uint8_t* imageData, size_t size);
     const uint8_t* getImageData() const { return imageData_; }
+    bool isValid() const { return asset_.frames != nullptr; }
+    const char* getError() const { return error_; }
 private:
-    const uint8_t* imageData_;  // 指向images.h中的数组
+    const uint8_t* imageData_ = nullptr;  // 指向images.h中的数组
+    ImageAssetInfo asset_ = {nullptr, 0, 0};
+    const char* error_ = "no data";
 };
 
 // 烛火效果（适配器类，兼容AnimSystem）
@@ -137,7 +148,7 @@ public:
     CandleFlameEffect(uint8_t r = 255, uint8_t g = 100, uint8_t b = 50, int frames = 60) 
         : r_(r), g_(g), b_(b), frames_(frames) {}
     
-    void generateAnimation(uint8_t* animFrames, int frameCount, int frameSize) override;
+    void renderFrame(int index, uint8_t* dst, int frameSize) override;
     const char* getName() const override { return "CandleFlame"; }
     int getFrameCount() const override { return frames_; }
     int getFrameDelay() const override { return 50; }  // 50ms每帧
@@ -151,4 +162,17 @@ private:
     int frames_;
     float flameIntensity_ = 1.0f;
     float windEffect_ = 0.5f;
-}; 
\ No newline at end of file
+};
+
+// 外部帧数据效果：播放调用方持有的矩阵序帧（数据在播放期间须保持有效）
+class FrameDataEffect : public AnimEffect {
+public:
+    void setData(const uint8_t* data, int frameCount) { data_ = data; frames_ = frameCount; }
+    void renderFrame(int index, uint8_t* dst, int frameSize) override;
+    const uint8_t* frameData(int index) const override;
+    const char* getName() const override { return "FrameData"; }
+    int getFrameCount() const override { return frames_ > 0 ? frames_ : 1; }
+private:
+    const uint8_t* data_ = nullptr;
+    int frames_ = 0;
+};
@@ -1,6 +1,11 @@
 #include "anim_system.hpp"
 #include "sid_rmt_sender.h"
+#include "panel_config.h"
+#include "gamma_lut.h"
+#include "color_temperature.h"
 #include <Arduino.h>
+#include <esp_timer.h>
+#include <esp_heap_caps.h>
 #include <math.h>
 #include <string.h>
 #include <stdlib.h>
@@ -14,24 +19,15 @@
 // 全局实例指针，用于任务回调
 static AnimSystem* g_animSystem = nullptr;
 
-// 导出到发送模块的亮度冻结标志与冻结值
+// 导出到发送模块的亮度冻结标志（冻结期间发送路径暂停亮度斜坡）
 bool g_anim_brightnessFreezeActive = false;
-uint8_t g_anim_frozenBrightness = 100;
 
-static inline float toLinear(float c) {
-    // 近似sRGB->Linear，简化：pow(c, 2.2)
-    return powf(c, 2.2f);
-}
-static inline float toSRGB(float c) {
-    // 线性->sRGB
-    return powf(c, 1.0f / 2.2f);
-}
 
 AnimSystem::AnimSystem()
-    : bufferA_(nullptr), bufferB_(nullptr), updateBuffer_(nullptr), sendBuffer_(nullptr), bufferSwapped_(false),
-      animFrames_(nullptr), animFrameCount_(0), currentFrame_(0), animationRunning_(false), currentEffect_(nullptr),
-      animMutex_(nullptr), eventGroup_(nullptr), updateTaskHandle_(nullptr), sendTaskHandle_(nullptr)
+    : animFrameCount_(0), currentFrame_(0), animationRunning_(false), currentEffect_(nullptr),
+      animMutex_(nullptr), updateTaskHandle_(nullptr), sendTaskHandle_(nullptr)
 {
+    uv_fixture_init(&fixture_, UV_FIXTURE_DEFAULT_MATRIX);
 }
 
 AnimSystem::~AnimSystem() {
@@ -39,41 +35,61 @@ AnimSystem::~AnimSystem() {
     if (animMutex_) {
         vSemaphoreDelete(animMutex_);
     }
-    if (eventGroup_) {
-        vEventGroupDelete(eventGroup_);
+}
+
+void AnimSystem::init() {
+    // 帧大小取自面板描述符（需在 panel_load() 之后初始化）
+    frameSize_ = panel_frame_size();
+    // 帧池按帧对齐到4字节后一次性分配，之后切换效果/过渡均不再申请堆
+    size_t slot = ((size_t)frameSize_ + 3) & ~(size_t)3;
+    if (!arena_.init(slot * ANIM_ARENA_FRAMES)) {
+        debug_println("ERROR: Failed to allocate AnimSystem frame arena");
     }
-    if (animFrames_) {
-        free(animFrames_);
+    orderScratch_ = arena_.carve(frameSize_);
+    transitionStart_ = arena_.carve(frameSize_);
+    transitionEnd_ = arena_.carve(frameSize_);
+    shownFrame_ = arena_.carve(frameSize_);
+    if (!orderScratch_ || !transitionStart_ || !transitionEnd_ || !shownFrame_) {
+        debug_println("ERROR: Failed to allocate AnimSystem scratch frames");
     }
-    if (bufferA_) {
-        free(bufferA_);
+    if (!pipeline_.init(arena_.carve(slot * 3), (int)slot)) {
+        debug_println("ERROR: Failed to allocate AnimSystem frame pipeline");
     }
-    if (bufferB_) {
-        free(bufferB_);
+    uint8_t* layerFrames[LAYER_MAX_COUNT];
+    for (int i = 0; i < LAYER_MAX_COUNT; ++i) {
+        layerFrames[i] = arena_.carve(frameSize_);
     }
-}
+    compositor_.init(layerFrames, frameSize_, renderLayerEntry, this);
 
-void AnimSystem::init() {
-    // 创建互斥锁和事件组
+    // 创建互斥锁
     animMutex_ = xSemaphoreCreateMutex();
-    eventGroup_ = xEventGroupCreate();
-    
-    // 检查创建是否成功
     if (!animMutex_) {
         debug_println("ERROR: Failed to create animMutex_");
     }
-    if (!eventGroup_) {
-        debug_println("ERROR: Failed to create eventGroup_");
-    }
     
     // 设置全局实例指针
     g_animSystem = this;    
     // 生成默认测试动画
     generateTestAnimation();    
-    debug_printf("AnimSystem initialized - mutex: %p, eventGroup: %p\n", animMutex_, eventGroup_);
+    debug_printf("AnimSystem initialized - mutex: %p\n", animMutex_);
 }
 
 void AnimSystem::updateColorTemp(uint8_t tempIndex, uint8_t duvIndex, bool useTransition) {
+    // 正在跨淡入到色温效果：新参数直接作用于入场帧，淡入继续进行
+    if (animMutex_) {
+        xSemaphoreTake(animMutex_, portMAX_DELAY);
+        if (transitionActive_ && transitionTarget_ && transitionTarget_->isColorTemp()) {
+            transitionTarget_->setColorTemp(tempIndex);
+            transitionTarget_->setDuvIndex(duvIndex);
+            renderEffectFrame(transitionTarget_, 0, transitionEnd_);
+            contentGen_++;
+            xSemaphoreGive(animMutex_);
+            kickRenderer();
+            return;
+        }
+        xSemaphoreGive(animMutex_);
+    }
+
     // 仅在当前效果是色温（静态）时进行过渡（无RTTI版）
     if (!(currentEffect_ && currentEffect_->isColorTemp())) {
         debug_println("updateColorTemp: current effect is not ColorTempEffect.");
@@ -86,225 +102,271 @@ void AnimSystem::updateColorTemp(uint8_t tempIndex, uint8_t duvIndex, bool useTr
         xSemaphoreTake(animMutex_, portMAX_DELAY);
         colorEff->setColorTemp(tempIndex);
         colorEff->setDuvIndex(duvIndex);
-        colorEff->generateAnimation(animFrames_, 1, FRAME_SIZE);
+        // 直接切换覆盖进行中的过渡
+        finishTransition();
         animFrameCount_ = 1;
         currentFrame_ = 0;
+        setFrameDelay(colorEff->getFrameDelay());
+        contentGen_++;
         xSemaphoreGive(animMutex_);
-
-        // 刷新两个buffer
-        if (eventGroup_) {
-            xEventGroupClearBits(eventGroup_, SEND_COMPLETE_BIT | UPDATE_READY_BIT);
-        }
-        memcpy(bufferA_, &animFrames_[0], FRAME_SIZE);
-        memcpy(bufferB_, &animFrames_[0], FRAME_SIZE);
-        if (eventGroup_) {
-            xEventGroupSetBits(eventGroup_, UPDATE_READY_BIT);
-        }
+        kickRenderer();
         // Serial.printf("ColorTemp set directly: temp=%u duv=%u\n", tempIndex, duvIndex);
         return;
     }
 
-    // 冻结当前亮度，避免过渡期间亮度变化导致可见跳变
-    lastUsedBrightness_ = get_brightness();
-    brightnessFreezeActive_ = true;
-    g_anim_brightnessFreezeActive = true;
-    g_anim_frozenBrightness = lastUsedBrightness_;
-
     // 过渡：从“当前显示颜色”到“目标颜色”，做gamma校正的插值
-    uint8_t curR8=0, curG8=0, curB8=0;
-    // 从当前sendBuffer_拿到正在显示的颜色（任一像素；本模式单色）
+    // 从最近交给发送端的帧拿到正在显示的颜色（任一像素；本模式单色）
     xSemaphoreTake(animMutex_, portMAX_DELAY);
-    if (sendBuffer_) {
-        curR8 = sendBuffer_[0];
-        curG8 = sendBuffer_[1];
-        curB8 = sendBuffer_[2];
-    }
+    uint8_t curR8 = shownFrame_[0], curG8 = shownFrame_[1], curB8 = shownFrame_[2];
     xSemaphoreGive(animMutex_);
 
     // 目标颜色（不应用亮度，这里仅生成原始RGB，亮度在send_data里统一应用）
     uint8_t endR8, endG8, endB8;
-    getColorTempRGBWithDuv(tempIndex, duvIndex, &endR8, &endG8, &endB8);
-
-    // 转为0..1
-    float curR = curR8 / 255.0f, curG = curG8 / 255.0f, curB = curB8 / 255.0f;
-    float endR = endR8 / 255.0f, endG = endG8 / 255.0f, endB = endB8 / 255.0f;
-
-    // 转到线性空间
-    if (gammaBlendEnabled_) {
-        curR = toLinear(curR); curG = toLinear(curG); curB = toLinear(curB);
-        endR = toLinear(endR); endG = toLinear(endG); endB = toLinear(endB);
-    }
+    ColorTemperatureManager::getStepRGB(tempIndex, duvIndex, &endR8, &endG8, &endB8);
 
-    int frames = staticTransitionFrames_;
+    int durationMs = staticTransitionMs_;
     xSemaphoreTake(animMutex_, portMAX_DELAY);
-    if (animFrames_) free(animFrames_);
-    animFrames_ = (uint8_t*)malloc(frames * FRAME_SIZE);
-    animFrameCount_ = frames;
+    // 冻结当前亮度，避免过渡期间亮度变化导致可见跳变
+    lastUsedBrightness_ = get_brightness();
+    brightnessFreezeActive_ = true;
+    g_anim_brightnessFreezeActive = true;
+
+    // 只记录起止颜色，过渡帧由渲染任务逐帧插值
+    colorFrom_[0] = curR8; colorFrom_[1] = curG8; colorFrom_[2] = curB8;
+    colorTo_[0] = endR8; colorTo_[1] = endG8; colorTo_[2] = endB8;
+    uvPathValid_ = perceptualColorTransition_ && uv_transition_plan(&uvPath_, &fixture_, colorFrom_, colorTo_);
     currentFrame_ = 0;
-    frameDelayMs_ = 20; // 固定过渡速度
-
-    for (int f = 0; f < frames; ++f) {
-        float t = (frames > 1) ? ((float)f / (float)(frames - 1)) : 1.0f;
-        float rLin = curR + (endR - curR) * t;
-        float gLin = curG + (endG - curG) * t;
-        float bLin = curB + (endB - curB) * t;
-        if (gammaBlendEnabled_) {
-            rLin = toSRGB(rLin);
-            gLin = toSRGB(gLin);
-            bLin = toSRGB(bLin);
-        }
-        uint8_t r = (uint8_t)lroundf(rLin * 255.0f);
-        uint8_t g = (uint8_t)lroundf(gLin * 255.0f);
-        uint8_t b = (uint8_t)lroundf(bLin * 255.0f);
-        uint8_t* dst = &animFrames_[f * FRAME_SIZE];
-        for (int i = 0; i < FRAME_SIZE; i += 3) {
-            dst[i + 0] = r;
-            dst[i + 1] = g;
-            dst[i + 2] = b;
-        }
-    }
+    setFrameDelay(ANIM_TRANSITION_FRAME_MS);
+    timeline_start(&transition_, (uint32_t)durationMs, transitionEase_, esp_timer_get_time());
 
-    // 标记过渡中，并在过渡结束后应用目标色温
+    // 标记过渡中，并在过渡结束后应用目标色温（覆盖尚未完成的效果过渡）
     transitionActive_ = true;
+    transitionTarget_ = nullptr;
     hasPendingColorTemp_ = true;
     pendingTempIndex_ = tempIndex;
     pendingDuvIndex_ = duvIndex;
+    contentGen_++;
 
-    // 启动过渡：刷新buffer，触发更新
-    bufferUpdateInProgress_ = true;
-    memcpy(bufferA_, &animFrames_[0], FRAME_SIZE);
-    memcpy(bufferB_, &animFrames_[0], FRAME_SIZE);
-    bufferUpdateInProgress_ = false;
+    // 启动过渡：唤醒渲染任务从第0帧开始发布
     xSemaphoreGive(animMutex_);
+    kickRenderer();
 
-    if (eventGroup_) {
-        xEventGroupClearBits(eventGroup_, SEND_COMPLETE_BIT | UPDATE_READY_BIT);
-        xEventGroupSetBits(eventGroup_, UPDATE_READY_BIT);
+    debug_printf("ColorTemp transitioning (%s, brightness freeze %u%%): cur=(%u,%u,%u) -> target=(%u,%u,%u), %dms\n",
+                  uvPathValid_ ? "u'v' locus" : (gammaBlendEnabled_ ? "gamma RGB" : "sRGB"), lastUsedBrightness_, curR8, curG8, curB8, endR8, endG8, endB8, durationMs);
+}
+
+bool AnimSystem::setFixtureColorimetry(const float rgbToXyz[9]) {
+    UvFixture fx;
+    if (!uv_fixture_init(&fx, rgbToXyz)) {
+        debug_println("setFixtureColorimetry: matrix is singular");
+        return false;
+    }
+    if (animMutex_) xSemaphoreTake(animMutex_, portMAX_DELAY);
+    fixture_ = fx;
+    // 进行中的色温过渡按新矩阵重新预计算，起止颜色不变
+    if (uvPathValid_) {
+        uvPathValid_ = uv_transition_plan(&uvPath_, &fixture_, colorFrom_, colorTo_);
+        contentGen_++;
+    }
+    if (animMutex_) xSemaphoreGive(animMutex_);
+    return true;
+}
+
+void AnimSystem::kickRenderer() {
+    if (updateTaskHandle_) {
+        xTaskNotifyGive(updateTaskHandle_);
+    }
+}
+
+void AnimSystem::setFrameDelay(int delayMs) {
+    // 帧间隔不能短于一帧的线上时长，否则发送任务只能拉长帧而非按请求播放；
+    // 0 表示尽快刷新，静默取下限
+    int minDelayMs = (int)((sid_rmt_current_frame_wire_us() + 999) / 1000);
+    if (delayMs < minDelayMs) {
+        if (delayMs > 0) {
+            debug_printf("Frame delay %dms below wire limit, clamped to %dms (max %lu fps)\n",
+                         delayMs, minDelayMs, (unsigned long)sid_rmt_current_max_fps());
+        }
+        delayMs = minDelayMs;
+    }
+    frameDelayMs_ = delayMs;
+}
+
+void AnimSystem::renderEffectFrame(AnimEffect* effect, int index, uint8_t* dst) {
+    // 常驻帧（flash素材）直接从原地址读取，不经过中转缓冲
+    const uint8_t* src = effect->frameData(index);
+    if (src) {
+        if (effect->isChainOrder()) {
+            memcpy(dst, src, frameSize_);
+        } else {
+            sid_matrix_to_chain(src, dst, frameSize_);
+        }
+        return;
+    }
+    if (effect->isChainOrder()) {
+        effect->renderFrame(index, dst, frameSize_);
+        return;
     }
+    effect->renderFrame(index, orderScratch_, frameSize_);
+    sid_matrix_to_chain(orderScratch_, dst, frameSize_);
+}
 
-    debug_printf("ColorTemp transitioning (gamma %s, brightness freeze %u%%): cur=(%u,%u,%u) -> target=(%u,%u,%u), frames=%d\n",
-                  gammaBlendEnabled_?"on":"off", lastUsedBrightness_, curR8, curG8, curB8, endR8, endG8, endB8, frames);
+void AnimSystem::renderPlaybackFrame(int index, uint8_t* dst, uint64_t showUs) {
+    if (!transitionActive_) {
+        if (currentEffect_) {
+            renderEffectFrame(currentEffect_, index, dst);
+        }
+        return;
+    }
+    // 过渡进度：Q16 缓动值，RGB混合用其 Q12
+    uint32_t progress = timeline_progress_q16(&transition_, showUs);
+    uint32_t t = (uint32_t)(((uint64_t)progress * GAMMA_BLEND_ONE) >> 16);
+    if (hasPendingColorTemp_) {
+        // 色温过渡：单色，沿普朗克轨迹插值，或查表在线性空间定点混合
+        uint8_t rgb[3];
+        if (uvPathValid_) {
+            uv_transition_eval(&uvPath_, progress, rgb);
+        } else {
+            gamma_blend_frame(colorFrom_, colorTo_, rgb, 3, t, gammaBlendEnabled_);
+        }
+        for (int i = 0; i < frameSize_; i += 3) {
+            dst[i + 0] = rgb[0];
+            dst[i + 1] = rgb[1];
+            dst[i + 2] = rgb[2];
+        }
+        return;
+    }
+    // 效果跨淡入：出入场效果各按自身节奏渲染一帧，再逐字节混合（与色温过渡共用gamma查表混合）
+    uint32_t elapsedMs = timeline_elapsed_ms(&transition_, showUs);
+    if (fadeFrom_) {
+        renderEffectFrame(fadeFrom_, fadeFrameIndex(fadeFrom_, fadeFromFrame_, elapsedMs), transitionStart_);
+    }
+    if (!fadeToStatic_ && transitionTarget_) {
+        renderEffectFrame(transitionTarget_, fadeFrameIndex(transitionTarget_, 0, elapsedMs), transitionEnd_);
+    }
+    gamma_blend_frame(transitionStart_, transitionEnd_, dst, frameSize_, t, gammaBlendEnabled_);
+}
+
+void AnimSystem::finishTransition() {
+    transitionActive_ = false;
+    hasPendingColorTemp_ = false;
+    transitionTarget_ = nullptr;
+    fadeFrom_ = nullptr;
+
+    // 解除亮度冻结（若期间外部调整过亮度，在此恢复）
+    brightnessFreezeActive_ = false;
+    g_anim_brightnessFreezeActive = false;
+    if (pendingBrightness_ != 0) {
+        set_brightness(pendingBrightness_);
+        pendingBrightness_ = 0;
+    }
+}
+
+int AnimSystem::fadeFrameIndex(AnimEffect* effect, int startFrame, uint32_t elapsedMs) const {
+    int count = effect->getFrameCount();
+    if (count <= 1) {
+        return 0;
+    }
+    int delayMs = effect->getFrameDelay();
+    if (delayMs < 1) delayMs = 1;
+    return (int)((startFrame + elapsedMs / (uint32_t)delayMs) % (uint32_t)count);
+}
+
+void AnimSystem::startCrossfade(AnimEffect* effect) {
+    // 出场画面：正在播放的动画效果继续逐帧渲染；静态效果或上一过渡中途的画面取当前显示帧快照
+    if (!transitionActive_ && currentEffect_ && currentEffect_->getFrameCount() > 1) {
+        fadeFrom_ = currentEffect_;
+        fadeFromFrame_ = currentFrame_;
+    } else {
+        fadeFrom_ = nullptr;
+        memcpy(transitionStart_, shownFrame_, frameSize_);
+    }
+    // 入场静态帧只需渲染一次
+    transitionTarget_ = effect;
+    fadeToStatic_ = effect->getFrameCount() == 1;
+    if (fadeToStatic_) {
+        renderEffectFrame(effect, 0, transitionEnd_);
+    }
+    // 中途的色温过渡被新的跨淡入取代，亮度冻结在淡入结束时解除
+    hasPendingColorTemp_ = false;
+    setFrameDelay(ANIM_TRANSITION_FRAME_MS);
+    timeline_start(&transition_, (uint32_t)crossfadeMs_, transitionEase_, esp_timer_get_time());
+    currentFrame_ = 0;
+    transitionActive_ = true;
 }
 
 void AnimSystem::setEffect(AnimEffect* effect) {
     if (!effect) return;
+    int64_t startUs = esp_timer_get_time();
 
-    bool wantTransition = false;
-    if (animationRunning_ && currentEffect_ && currentEffect_->getFrameCount() == 1 && effect->getFrameCount() == 1) {
-        // 运行中且静态->静态，走20帧过渡
-        wantTransition = true;
-        transitionTarget_ = effect;
-    }
-
-    // 释放旧内存
-    if (animFrames_) free(animFrames_);
-    if (bufferA_) free(bufferA_);
-    if (bufferB_) free(bufferB_);
-
-    // 分配新内存（静态过渡需要20帧容量，否则按目标帧数）
-    int allocateFrames = wantTransition ? staticTransitionFrames_ : effect->getFrameCount();
-    int allocateBytes = allocateFrames * FRAME_SIZE;
-    animFrames_ = (uint8_t*)malloc(allocateBytes);
-    bufferA_ = (uint8_t*)malloc(FRAME_SIZE);
-    bufferB_ = (uint8_t*)malloc(FRAME_SIZE);
-    updateBuffer_ = bufferA_;
-    sendBuffer_ = bufferB_;
-    animFrameCount_ = allocateFrames;
-    currentFrame_ = 0;
+    // 运行中切换（静态或动画均可）走跨淡入
+    bool wantTransition = animationRunning_ && currentEffect_ && crossfadeMs_ > 0;
+
+    // 渲染任务运行中会读取播放状态，替换期间持锁；发送任务只读交接缓冲，不受影响
+    if (animMutex_) xSemaphoreTake(animMutex_, portMAX_DELAY);
 
     if (wantTransition) {
-        // 不立刻切换currentEffect_，等待过渡完成后再切
-        frameDelayMs_ = 20; // 过渡速度（帧间隔可保留20ms）
-        debug_printf("Effect set (pending transition): %s -> %s\n", currentEffect_->getName(), transitionTarget_->getName());
+        // 不立刻切换currentEffect_，淡入完成后再切
+        startCrossfade(effect);
+        contentGen_++;
+        debug_printf("Effect crossfade: %s -> %s, %dms\n", currentEffect_->getName(), effect->getName(), crossfadeMs_);
     } else {
+        finishTransition();
         currentEffect_ = effect;
-        frameDelayMs_ = currentEffect_->getFrameDelay();
-        // 生成新动画
-        currentEffect_->generateAnimation(animFrames_, animFrameCount_, FRAME_SIZE);
-
-        // 直接播放真实数据，不做首尾平滑处理
-        debug_printf("Effect set to: %s, frames=%d, delay=%dms\n", currentEffect_->getName(), animFrameCount_, frameDelayMs_);
+        animFrameCount_ = effect->getFrameCount();
+        currentFrame_ = 0;
+        lastPublishedFrame_ = 0;
+        setFrameDelay(currentEffect_->getFrameDelay());
+        contentGen_++;
+
+        // 不预先生成整段动画：渲染任务被唤醒后渲染第一帧，切换延迟为一帧
+        AnimMemoryStats mem = getMemoryStats();
+        debug_printf("Effect set to: %s, frames=%d, delay=%dms, switch %ldus, heap free %u (min %u, frag %u%%)\n",
+                     currentEffect_->getName(), animFrameCount_, frameDelayMs_,
+                     (long)(esp_timer_get_time() - startUs),
+                     (unsigned)mem.heapFree, (unsigned)mem.heapMinFree, (unsigned)mem.fragmentationPct);
     }
+    if (animMutex_) xSemaphoreGive(animMutex_);
+    kickRenderer();
 }
 
 void AnimSystem::updateCurrentEffect() {
     if (!currentEffect_ || !animationRunning_) return;
     
-    // 等待发送任务完成当前发送
-    if (eventGroup_) {
-        xEventGroupWaitBits(eventGroup_, SEND_COMPLETE_BIT, pdTRUE, pdFALSE, pdMS_TO_TICKS(100));
-    }
-    
-    // 在互斥锁保护下重新生成动画数据
     xSemaphoreTake(animMutex_, portMAX_DELAY);
 
-    // 如果当前效果和目标效果都为静态（帧数=1），构建20帧跨淡入过渡
-    bool doTransition = (currentEffect_ && currentEffect_->getFrameCount() == 1 && transitionTarget_ && transitionTarget_->getFrameCount() == 1);
-    if (doTransition) {
-        // 准备起止帧
-        uint8_t start[FRAME_SIZE];
-        uint8_t end[FRAME_SIZE];
-        // 当前静态帧存到 start
-        memcpy(start, &animFrames_[0], FRAME_SIZE);
-        // 让目标效果生成其静态帧到临时缓冲
-        uint8_t tmpFrames[FRAME_SIZE];
-        transitionTarget_->generateAnimation(tmpFrames, 1, FRAME_SIZE);
-        memcpy(end, tmpFrames, FRAME_SIZE);
-        // 生成20帧过渡到 animFrames_
-        const int transitionFrames = staticTransitionFrames_;
-        animFrameCount_ = transitionFrames;
-        for (int f = 0; f < transitionFrames; ++f) {
-            float t = (float)(f + 1) / (float)transitionFrames; // 0..1
-            uint8_t* dst = &animFrames_[f * FRAME_SIZE];
-            for (int i = 0; i < FRAME_SIZE; ++i) {
-                int a = start[i];
-                int b = end[i];
-                dst[i] = (uint8_t)(a + (int)((b - a) * t));
-            }
+    if (transitionActive_ && transitionTarget_) {
+        // 跨淡入进行中：入场静态帧按当前参数重新生成（动画效果本就逐帧渲染），淡入继续
+        if (fadeToStatic_) {
+            renderEffectFrame(transitionTarget_, 0, transitionEnd_);
         }
-        currentFrame_ = 0;
-        frameDelayMs_ = 20; // 过渡帧间隔 20ms（保留）
-        transitionActive_ = true;
     } else {
-        // 非静态过渡，或无目标：正常重建当前效果动画
-        currentEffect_->generateAnimation(animFrames_, animFrameCount_, FRAME_SIZE);
-        // 直接播放真实数据，不做首尾平滑处理
-        frameDelayMs_ = currentEffect_->getFrameDelay();
+        // 非静态过渡，或无目标：从第一帧重新播放当前效果（效果参数可能已变）
+        finishTransition();
+        animFrameCount_ = currentEffect_->getFrameCount();
+        setFrameDelay(currentEffect_->getFrameDelay());
         currentFrame_ = 0;  // 重置到第一帧
     }
+    contentGen_++;
 
-    // 更新两个buffer为新的第一帧数据
-    bufferUpdateInProgress_ = true;
-    memcpy(bufferA_, &animFrames_[0], FRAME_SIZE);
-    memcpy(bufferB_, &animFrames_[0], FRAME_SIZE);
-    bufferUpdateInProgress_ = false;
     xSemaphoreGive(animMutex_);
-    
-    // 重新置位事件：先清，再置更新就绪
-    if (eventGroup_) {
-        xEventGroupClearBits(eventGroup_, SEND_COMPLETE_BIT | UPDATE_READY_BIT);
-        xEventGroupSetBits(eventGroup_, UPDATE_READY_BIT);
-    }
+    // 唤醒渲染任务立即发布新的第一帧
+    kickRenderer();
     // Serial.printf("Current effect updated: %s\n", currentEffect_->getName());
 }
 
 void AnimSystem::start() {
-    if (!animationRunning_ && currentEffect_ && eventGroup_) {
+    if (!animationRunning_ && currentEffect_ && animMutex_ && shownFrame_) {
         animationRunning_ = true;
         currentFrame_ = 0;
-        // 初始化第一帧数据到两个buffer
-        bufferUpdateInProgress_ = true;
-        memcpy(bufferA_, &animFrames_[0], FRAME_SIZE);
-        memcpy(bufferB_, &animFrames_[0], FRAME_SIZE);
-        bufferUpdateInProgress_ = false;
-        updateBuffer_ = bufferA_;
-        sendBuffer_ = bufferB_;
-        // 事件初始化：清空并宣告有可发送帧
-        xEventGroupClearBits(eventGroup_, SEND_COMPLETE_BIT | UPDATE_READY_BIT);
-        xEventGroupSetBits(eventGroup_, UPDATE_READY_BIT);
+        // 任务创建前先发布第一帧，发送任务启动即有帧可发
+        renderPlaybackFrame(0, pipeline_.writeBuffer(), esp_timer_get_time());
+        memcpy(shownFrame_, pipeline_.writeBuffer(), frameSize_);
+        pipeline_.publish();
+        preparedFrame_ = -1;
         // 创建任务
         xTaskCreate(updateTaskEntry, "AnimUpdate", 4096, this, 3, &updateTaskHandle_);
-        xTaskCreate(sendTaskEntry, "AnimSend", 8192, this, 3, &sendTaskHandle_);
+        xTaskCreate(sendTaskEntry, "AnimSend", 4096, this, 3, &sendTaskHandle_);
         debug_println("Animation started");
     }
 }
@@ -328,10 +390,10 @@ void AnimSystem::stop() {
 }
 
 void AnimSystem::setAnimationData(const uint8_t* data, int frameCount) {
-    if (frameCount > ANIM_FRAMES) {
-        frameCount = ANIM_FRAMES;
-    }
-    memcpy(animFrames_, data, frameCount * FRAME_SIZE);
+    if (!data || frameCount <= 0) return;
+    // 外部数据为矩阵序，播放时逐帧转换为链序
+    dataEffect_.setData(data, frameCount);
+    setEffect(&dataEffect_);
 }
 
 void AnimSystem::generateTestAnimation() {
@@ -347,6 +409,60 @@ bool AnimSystem::isRunning() const {
     return animationRunning_;
 }
 
+int AnimSystem::addLayer(AnimEffect* effect, LayerBlendMode mode, uint8_t opacity) {
+    xSemaphoreTake(animMutex_, portMAX_DELAY);
+    int id = compositor_.add(effect, mode, opacity);
+    xSemaphoreGive(animMutex_);
+    if (id < 0) {
+        debug_println("addLayer: no free layer slot");
+        return -1;
+    }
+    kickRenderer();
+    debug_printf("Layer %d added: %s, mode=%d, opacity=%u\n", id, effect->getName(), (int)mode, opacity);
+    return id;
+}
+
+bool AnimSystem::removeLayer(int id) {
+    xSemaphoreTake(animMutex_, portMAX_DELAY);
+    bool ok = compositor_.remove(id);
+    xSemaphoreGive(animMutex_);
+    if (ok) kickRenderer();
+    return ok;
+}
+
+bool AnimSystem::setLayerOpacity(int id, uint8_t opacity) {
+    xSemaphoreTake(animMutex_, portMAX_DELAY);
+    bool ok = compositor_.setOpacity(id, opacity);
+    xSemaphoreGive(animMutex_);
+    if (ok) kickRenderer();
+    return ok;
+}
+
+void AnimSystem::renderLayerEntry(void* ctx, AnimEffect* effect, int index, uint8_t* dst) {
+    ((AnimSystem*)ctx)->renderEffectFrame(effect, index, dst);
+}
+
+AnimMemoryStats AnimSystem::getMemoryStats() {
+    AnimMemoryStats stats;
+    stats.arenaBytes = (uint32_t)arena_.capacity();
+    stats.arenaUsed = (uint32_t)arena_.used();
+    stats.arenaFailures = arena_.failedCarves();
+    stats.heapFree = (uint32_t)heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    stats.heapMinFree = (uint32_t)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    stats.heapLargestBlock = (uint32_t)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    stats.fragmentationPct = stats.heapFree ? (uint8_t)(100 - (uint64_t)stats.heapLargestBlock * 100 / stats.heapFree) : 0;
+    if (stats.fragmentationPct > peakFragmentationPct_) {
+        peakFragmentationPct_ = stats.fragmentationPct;
+    }
+    stats.peakFragmentationPct = peakFragmentationPct_;
+    return stats;
+}
+
+void AnimSystem::setAsyncSendEnabled(bool enabled) {
+    sid_rmt_set_async(enabled);
+    debug_printf("AnimSystem async send %s\n", sid_rmt_get_async() ? "enabled" : "disabled");
+}
+
 void AnimSystem::setBrightnessSmooth(uint8_t targetBrightness) {
     if (targetBrightness > 100) targetBrightness = 100;
     uint8_t current = get_brightness();
@@ -364,16 +480,8 @@ void AnimSystem::setBrightnessSmooth(uint8_t targetBrightness) {
         return;
     }
 
-    // 进行20帧平滑过渡（跟随sendTask节奏）
-    const int frames = 20;
-    for (int f = 0; f < frames; ++f) {
-        float t = (frames > 1) ? ((float)f / (float)(frames - 1)) : 1.0f;
-        int br = (int)lroundf(current + delta * t);
-        if (br < 0) br = 0; if (br > 100) br = 100;
-        set_brightness((uint8_t)br);
-        // 等待一帧发送间隔
-        vTaskDelay(pdMS_TO_TICKS(frameDelayMs_));
-    }
+    // 大幅变化走缓动斜坡；由发送路径逐帧推进，调用方不阻塞
+    start_brightness_ramp(targetBrightness, ANIM_BRIGHTNESS_RAMP_MS, EASE_PERCEPTUAL);
 }
 
 void AnimSystem::updateTaskEntry(void* parameter) {
@@ -390,125 +498,117 @@ void AnimSystem::sendTaskEntry(void* parameter) {
 
 void AnimSystem::updateTask() {
     debug_println("Animation Update Task Started");
+    int dropFrames = 0;
+    frameClock_.start(esp_timer_get_time());
     while (1) {
         if (animationRunning_) {
-            // 等待一帧发送完成，再准备下一帧
-            EventBits_t bits = xEventGroupWaitBits(
-                eventGroup_,
-                SEND_COMPLETE_BIT,
-                pdTRUE,
-                pdFALSE,
-                portMAX_DELAY
-            );
-            if (bits & SEND_COMPLETE_BIT) {
-                // 设置更新状态标志
-                bufferUpdateInProgress_ = true;
-                
-                xSemaphoreTake(animMutex_, portMAX_DELAY);
-
-                // 写入当前帧到更新buffer
-                memcpy(updateBuffer_, &animFrames_[currentFrame_ * FRAME_SIZE], FRAME_SIZE);
-                // 记录刚写入的帧索引
-                int justCopiedIndex = currentFrame_;
-                // 计算下一帧索引
-                currentFrame_ = (currentFrame_ + 1) % animFrameCount_;
-
-                // 如果刚写入的是最后一帧，则也把该帧写到sendBuffer_，确保交换前后两个buffer一致
-                if (justCopiedIndex == (animFrameCount_ - 1)) {
-                    memcpy(sendBuffer_, &animFrames_[justCopiedIndex * FRAME_SIZE], FRAME_SIZE);
-                }
-
-                xSemaphoreGive(animMutex_);
-                
-                // 清除更新状态标志
-                bufferUpdateInProgress_ = false;
-                
-                // 通知发送任务：更新就绪
-                xEventGroupSetBits(eventGroup_, UPDATE_READY_BIT);
-
-                // 如果处于静态过渡并且已经写完最后一帧，切换到目标静态效果
-                if (transitionActive_ && justCopiedIndex == (animFrameCount_ - 1)) {
-                    if (hasPendingColorTemp_) {
-                        // 处于色温过渡：应用目标色温并回到单帧静态（无RTTI）
-                        if (currentEffect_ && currentEffect_->isColorTemp()) {
-                            ColorTempEffect* colorEff = (ColorTempEffect*)currentEffect_;
-                            colorEff->setColorTemp(pendingTempIndex_);
-                            colorEff->setDuvIndex(pendingDuvIndex_);
-                            colorEff->generateAnimation(animFrames_, 1, FRAME_SIZE);
-                            animFrameCount_ = 1;
-                            currentFrame_ = 0;
-                        }
-                        hasPendingColorTemp_ = false;
-                    } else if (transitionTarget_) {
-                        // 普通静态->静态效果过渡完成：切换效果
-                        currentEffect_ = transitionTarget_;
-                        currentEffect_->generateAnimation(animFrames_, 1, FRAME_SIZE);
-                        animFrameCount_ = 1;
-                        currentFrame_ = 0;
-                        transitionTarget_ = nullptr;
-                    }
-                    frameDelayMs_ = currentEffect_ ? currentEffect_->getFrameDelay() : 20;
-                    transitionActive_ = false;
-
-                    // 过渡结束，解除亮度冻结（若期间外部调整过亮度，可在此恢复）
-                    brightnessFreezeActive_ = false;
-                    g_anim_brightnessFreezeActive = false;
-                    g_anim_frozenBrightness = get_brightness();
-                    if (pendingBrightness_ != 0) {
-                        set_brightness(pendingBrightness_);
-                        pendingBrightness_ = 0;
-                    }
-                }
-            }
+            renderTick(&dropFrames);
         } else {
+            // 停止期间保持时钟对齐当前时刻，恢复播放时不把停顿计为迟到
+            frameClock_.start(esp_timer_get_time());
+            dropFrames = 0;
             vTaskDelay(10 / portTICK_PERIOD_MS);
         }
     }
 }
-uint8_t* temp;
+
+void AnimSystem::renderTick(int* dropFrames) {
+    xSemaphoreTake(animMutex_, portMAX_DELAY);
+
+    // 上一截止时刻已错过的帧直接跳过；过渡按时间线推进，索引只用于判断预渲染帧是否过期
+    if (*dropFrames > 0) {
+        if (transitionActive_) {
+            currentFrame_ += *dropFrames;
+        } else {
+            currentFrame_ = (currentFrame_ + *dropFrames) % animFrameCount_;
+        }
+    }
+
+    // 当前帧写入交接缓冲的后台块：预渲染帧仍有效（内容未变、未跳帧）则直接发布，否则现在渲染
+    uint8_t* out = pipeline_.writeBuffer();
+    uint64_t showUs = preparedUs_;
+    if (preparedFrame_ != currentFrame_ || preparedGen_ != contentGen_) {
+        showUs = esp_timer_get_time();
+        renderPlaybackFrame(currentFrame_, out, showUs);
+    }
+    preparedFrame_ = -1;
+    // 过渡起点取底层画面（叠加层跨效果切换保持不变）
+    memcpy(shownFrame_, out, frameSize_);
+    if (compositor_.active()) {
+        compositor_.composite(out, esp_timer_get_time());
+    }
+    lastPublishedFrame_ = currentFrame_;
+    // 计算下一帧索引
+    if (transitionActive_) {
+        currentFrame_++;
+    } else {
+        currentFrame_ = (currentFrame_ + 1) % animFrameCount_;
+    }
+
+    // 如果处于过渡并且刚写入的帧已到时间线终点，切换到目标效果
+    if (transitionActive_ && timeline_done(&transition_, showUs)) {
+        int nextFrame = 0;
+        if (hasPendingColorTemp_) {
+            // 处于色温过渡：应用目标色温并回到单帧静态（无RTTI）
+            if (currentEffect_ && currentEffect_->isColorTemp()) {
+                ColorTempEffect* colorEff = (ColorTempEffect*)currentEffect_;
+                colorEff->setColorTemp(pendingTempIndex_);
+                colorEff->setDuvIndex(pendingDuvIndex_);
+            }
+        } else if (transitionTarget_) {
+            // 跨淡入完成：切换效果，入场动画从淡入期间已播到的位置接着播放
+            currentEffect_ = transitionTarget_;
+            nextFrame = fadeFrameIndex(currentEffect_, 0, transition_.durationUs / 1000);
+        }
+        animFrameCount_ = currentEffect_ ? currentEffect_->getFrameCount() : 1;
+        currentFrame_ = nextFrame;
+        lastPublishedFrame_ = 0;
+        setFrameDelay(currentEffect_ ? currentEffect_->getFrameDelay() : 20);
+        finishTransition();
+    }
+    int delayMs = frameDelayMs_;
+    xSemaphoreGive(animMutex_);
+
+    // 发布为最新帧并通知发送任务；不等待线上传输
+    pipeline_.publish();
+    if (sendTaskHandle_) {
+        xTaskNotifyGive(sendTaskHandle_);
+    }
+
+    // 先推进帧时钟得到下一截止时刻，等待期间按该时刻提前渲染下一帧，到点只需发布
+    frameClock_.setPeriodUs((uint32_t)delayMs * 1000);
+    uint32_t waitUs = frameClock_.frameDone(esp_timer_get_time(), dropFrames);
+    uint64_t nextUs = esp_timer_get_time() + waitUs;
+    xSemaphoreTake(animMutex_, portMAX_DELAY);
+    renderPlaybackFrame(currentFrame_, pipeline_.writeBuffer(), nextUs);
+    preparedFrame_ = currentFrame_;
+    preparedGen_ = contentGen_;
+    preparedUs_ = nextUs;
+    xSemaphoreGive(animMutex_);
+
+    // 等到下一截止时刻（向上取整到tick，不提前出帧）；
+    // 帧数据被替换时由 kickRenderer 提前唤醒，时间线从唤醒时刻重新开始
+    uint64_t nowUs = esp_timer_get_time();
+    waitUs = nextUs > nowUs ? (uint32_t)(nextUs - nowUs) : 0;
+    if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS((waitUs + 999) / 1000)) > 0) {
+        frameClock_.start(esp_timer_get_time());
+        *dropFrames = 0;
+        // 提前唤醒时预渲染帧的显示时刻尚未到达，重新渲染
+        preparedFrame_ = -1;
+    }
+}
+
 void AnimSystem::sendTask() {
     debug_println("Animation Send Task Started");
     while (1) {
         if (animationRunning_) {
-            // 等待更新任务准备好一帧
-            EventBits_t bits = xEventGroupWaitBits(
-                eventGroup_,
-                UPDATE_READY_BIT,
-                pdTRUE,
-                pdFALSE,
-                pdMS_TO_TICKS(50)  // 添加超时，避免无限等待
-            );
-            
-            if (bits & UPDATE_READY_BIT) {
-                // 检查更新状态和互斥锁状态
-                if (!bufferUpdateInProgress_ && xSemaphoreTake(animMutex_, 0) == pdTRUE) {
-                    // 更新完成且可以安全切换：交换buffer
-                    temp = updateBuffer_;
-                    updateBuffer_ = sendBuffer_;
-                    sendBuffer_ = temp;
-                    xSemaphoreGive(animMutex_);                    
-                    // 发送新切换的buffer数据
-                    send_data(sendBuffer_, FRAME_SIZE, 0xFFFF);
-                    
-                    // 通知更新任务可以准备下一帧
-                    xEventGroupSetBits(eventGroup_, SEND_COMPLETE_BIT);
-                } else {
-                    // 更新进行中或无法获取锁：重复发送当前buffer，避免显示中断
-                    send_data(sendBuffer_, FRAME_SIZE, 0x00F0);
-                    
-                    // 延迟一帧时间，等待更新完成
-                    vTaskDelay(pdMS_TO_TICKS(frameDelayMs_));
-                    continue;  // 继续循环，不设置SEND_COMPLETE_BIT
-                }
-            } else {
-                // 超时或没有更新就绪：重复发送当前buffer保持显示
-                send_data(sendBuffer_, FRAME_SIZE, 0xFFFF);
-                vTaskDelay(pdMS_TO_TICKS(frameDelayMs_));
-                continue;
-            }
-
-            // 使用效果的帧延时
-            vTaskDelay(pdMS_TO_TICKS(frameDelayMs_));
+            // 等渲染任务发布新帧；超时则重发当前帧保持显示（重复帧由发送端抑制）；
+            // 亮度斜坡进行中按过渡帧间隔重发，静态画面的亮度变化也保持平滑
+            int waitMs = brightness_ramp_active() ? ANIM_TRANSITION_FRAME_MS : ANIM_SEND_REFRESH_MS;
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
+            // 取最新完整帧；渲染快于线上传输时中间帧被跳过，不会阻塞渲染
+            pipeline_.acquire();
+            send_chain_data(pipeline_.readBuffer(), frameSize_, 0xFFFF);
         } else {
             vTaskDelay(10 / portTICK_PERIOD_MS);
         }
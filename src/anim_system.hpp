@@ -2,16 +2,33 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
-#include "freertos/event_groups.h"
 #include "anim_effect.hpp"
+#include "frame_triple_buffer.hpp"
+#include "frame_clock.hpp"
+#include "frame_arena.hpp"
+#include "layer_compositor.hpp"
+#include "timeline.h"
+#include "uv_transition.h"
 
-// 动画系统配置
-#define FRAME_SIZE (6 * 6 * 3)  // 6x6点，每点3字节RGB
-#define ANIM_FRAMES 100         // 动画帧数，增加到100帧
+// 动画系统配置（每帧字节数由面板描述符决定，见 panel_config.h）
+#define ANIM_SEND_REFRESH_MS 50  // 无新帧时发送任务重发当前帧的间隔
+#define ANIM_TRANSITION_FRAME_MS 20  // 过渡期间的帧间隔（只决定刷新率，过渡时长按时间线计）
+#define ANIM_BRIGHTNESS_RAMP_MS 400  // setBrightnessSmooth 大幅变化的斜坡时长
+// 帧池容量（帧）：三缓冲3帧 + 链序转换/过渡起点/过渡终点/最近发布帧各1帧 + 每个叠加层1帧；
+// 过渡帧逐帧插值生成，池大小与过渡长度无关
+#define ANIM_ARENA_FRAMES (7 + LAYER_MAX_COUNT)
 
-// 事件组位定义
-#define SEND_COMPLETE_BIT BIT0
-#define UPDATE_READY_BIT  BIT1
+// 内存状态：帧池占用与堆水位/碎片
+struct AnimMemoryStats {
+    uint32_t arenaBytes;          // 帧池容量
+    uint32_t arenaUsed;           // 已切分字节
+    uint32_t arenaFailures;       // 切分失败次数（非0说明init时池不足）
+    uint32_t heapFree;            // 当前空闲堆
+    uint32_t heapMinFree;         // 启动以来最低空闲堆（堆占用高水位）
+    uint32_t heapLargestBlock;    // 最大连续空闲块
+    uint8_t fragmentationPct;     // 当前碎片率：100 - 最大块/空闲堆
+    uint8_t peakFragmentationPct; // 历次采样的最高碎片率
+};
 
 class AnimSystem {
 public:
@@ -29,7 +46,7 @@ public:
     // 更新当前效果（不重启动画）
     void updateCurrentEffect();
     
-    // 设置动画数据
+    // 设置动画数据（矩阵序；按帧引用，不复制，播放期间须保持有效）
     void setAnimationData(const uint8_t* data, int frameCount);
     
     // 生成测试动画（默认呼吸灯）
@@ -38,62 +55,140 @@ public:
     // 运行状态查询
     bool isRunning() const;
 
-    // 配置：静态变化是否使用过渡、过渡帧数
+    // 配置：色温变化是否使用过渡、过渡时长（毫秒）
     void setStaticTransitionEnabled(bool enabled) { staticTransitionEnabled_ = enabled; }
-    void setStaticTransitionFrames(int frames) { if (frames > 0) staticTransitionFrames_ = frames; }
+    void setStaticTransitionMs(int ms) { if (ms > 0) staticTransitionMs_ = ms; }
+    // 配置：运行中切换效果的跨淡入时长（毫秒），0 表示直接切换
+    void setCrossfadeMs(int ms) { crossfadeMs_ = ms > 0 ? ms : 0; }
+    // 配置：色温过渡与跨淡入的缓动曲线（下一次过渡生效）
+    void setTransitionEase(EaseCurve ease) { transitionEase_ = ease; }
+    // 过渡是否在线性空间（gamma 2.2 查表）混合，关闭时直接在sRGB空间插值
     void setGammaBlendEnabled(bool enabled) { gammaBlendEnabled_ = enabled; }
+    // 色温过渡是否沿普朗克轨迹在 u'v' 空间插值（关闭或无法换算时退回RGB混合）
+    void setPerceptualColorTransition(bool enabled) { perceptualColorTransition_ = enabled; }
+    // 灯具 RGB->XYZ 矩阵（行优先，线性RGB=码值/255），矩阵不可逆时返回false并保持原矩阵
+    bool setFixtureColorimetry(const float rgbToXyz[9]);
+    // 配置：发送任务是否使用异步双缓冲RMT发送（编码与线上传输重叠）
+    void setAsyncSendEnabled(bool enabled);
+    // 配置：渲染落后时跳帧保持时间线（DROP）或顺延时间线（STRETCH）
+    void setLatePolicy(FrameClock::LatePolicy policy) { frameClock_.setLatePolicy(policy); }
+    // 帧时钟统计：逐帧迟到量、迟到/跳帧/顺延次数
+    const FrameClockStats& getFrameClockStats() const { return frameClock_.stats(); }
+    void resetFrameClockStats() { frameClock_.resetStats(); }
+    // 内存状态：帧池占用、堆高水位与碎片率（每次调用采样一次堆）
+    AnimMemoryStats getMemoryStats();
+
+    // 叠加层：位于当前效果之上，按添加顺序自下而上合成，各层按自身帧间隔推进；
+    // addLayer 返回层号，层数已满时返回-1
+    int addLayer(AnimEffect* effect, LayerBlendMode mode, uint8_t opacity);
+    bool removeLayer(int id);
+    bool setLayerOpacity(int id, uint8_t opacity);
 
     // 业务：色温调整（可选择是否过渡）
     void updateColorTemp(uint8_t tempIndex, uint8_t duvIndex, bool useTransition);
 
-    // 业务：亮度设置（当与当前亮度差值>10时，内部20帧平滑过渡）
+    // 业务：亮度设置（当与当前亮度差值>10时走缓动斜坡，立即返回）
     void setBrightnessSmooth(uint8_t targetBrightness);
 
 private:
-    // 双buffer
-    uint8_t* bufferA_ = nullptr;
-    uint8_t* bufferB_ = nullptr;
-    uint8_t* updateBuffer_ = nullptr;
-    uint8_t* sendBuffer_ = nullptr;
-    bool bufferSwapped_ = false;
+    // 每帧字节数（init时取自面板描述符）
+    int frameSize_ = 0;
+    // 所有帧缓冲在 init 时从帧池切出，运行期不再分配
+    FrameArena arena_;
+    uint8_t peakFragmentationPct_ = 0;
+    // 单帧临时缓冲：链序转换、静态过渡起止帧、最近发布帧副本（避免按面板大小占用调用方栈）
+    uint8_t* orderScratch_ = nullptr;
+    uint8_t* transitionStart_ = nullptr;
+    uint8_t* transitionEnd_ = nullptr;
+    uint8_t* shownFrame_ = nullptr;
+
+    // 渲染任务 -> 发送任务的帧交接（无锁三缓冲）
+    FrameTripleBuffer pipeline_;
+    // 底层画面发布前叠加各图层
+    LayerCompositor compositor_;
     
-    // 动画数据
-    uint8_t* animFrames_ = nullptr;
+    // 播放状态（帧在出帧前按需渲染，不预先生成整段动画）
     int animFrameCount_ = 0;
     int currentFrame_ = 0;
+    int lastPublishedFrame_ = 0;  // 最近交给发送端的帧索引
+    // 预渲染：发布后提前渲染下一帧到交接缓冲后台块，截止时刻到达时直接发布
+    uint32_t contentGen_ = 0;     // 播放内容版本，外部修改效果/过渡时递增使预渲染帧失效
+    uint32_t preparedGen_ = 0;
+    int preparedFrame_ = -1;
+    uint64_t preparedUs_ = 0;     // 预渲染帧对应的显示时刻（下一截止时刻）
+    // setAnimationData 使用的外部帧数据效果
+    FrameDataEffect dataEffect_;
     bool animationRunning_ = false;
     
     // 动画效果
     AnimEffect* currentEffect_ = nullptr;
     int frameDelayMs_ = 20;
-    // 静态动画切换的过渡状态
+    // 渲染任务按绝对截止时刻出帧
+    FrameClock frameClock_;
+    // 过渡状态：效果跨淡入（transitionTarget_ 非空）或色温过渡（hasPendingColorTemp_）；
+    // 进度按帧的显示时刻在时间线上取值，时长不随帧间隔变化
     bool transitionActive_ = false;
+    Timeline transition_ = {0, 0, EASE_LINEAR};
+    EaseCurve transitionEase_ = EASE_IN_OUT_CUBIC;
     AnimEffect* transitionTarget_ = nullptr;
+    int crossfadeMs_ = 1200;
+    AnimEffect* fadeFrom_ = nullptr;  // 出场效果，过渡中继续逐帧渲染；为空时出场画面取 transitionStart_ 快照
+    int fadeFromFrame_ = 0;           // 出场效果在过渡开始时的帧索引
+    bool fadeToStatic_ = false;       // 入场效果为静态时只在开始时渲染一次到 transitionEnd_
     bool staticTransitionEnabled_ = true;
-    int staticTransitionFrames_ = 60;
+    int staticTransitionMs_ = 1200;
     bool hasPendingColorTemp_ = false;
     uint8_t pendingTempIndex_ = 0;
     uint8_t pendingDuvIndex_ = 0;
+    uint8_t colorFrom_[3] = {0, 0, 0};  // 色温过渡起止颜色（sRGB）
+    uint8_t colorTo_[3] = {0, 0, 0};
     bool gammaBlendEnabled_ = true;
+    // 色温过渡的 u'v' 路径：开始时预计算，逐帧定点求值
+    bool perceptualColorTransition_ = true;
+    UvFixture fixture_;
+    UvTransition uvPath_;
+    bool uvPathValid_ = false;
     // 亮度冻结控制（避免色温过渡时亮度同步变化导致跳变）
     bool brightnessFreezeActive_ = false;
     uint8_t lastUsedBrightness_ = 100;
     uint8_t pendingBrightness_ = 0;
-    // 缓冲区更新状态控制
-    volatile bool bufferUpdateInProgress_ = false;
     
     // 亮度控制
     uint8_t brightness_ = 100;
     
-    // 同步和任务
+    // 同步和任务（animMutex_ 只保护帧数据与播放状态，发送任务不取锁）
     SemaphoreHandle_t animMutex_;
-    EventGroupHandle_t eventGroup_;  // 事件组用于任务同步
     TaskHandle_t updateTaskHandle_;
     TaskHandle_t sendTaskHandle_;
     
+    // 帧数据变化后唤醒渲染任务，立即发布新内容而不等当前帧间隔结束
+    void kickRenderer();
+
+    // 设置帧间隔，按当前面板与时序档的最高帧率钳位
+    void setFrameDelay(int delayMs);
+
+    // 渲染效果的单帧并统一转换为链序，发送端直接线性读取
+    void renderEffectFrame(AnimEffect* effect, int index, uint8_t* dst);
+    // 渲染播放序列的第 index 帧，过渡中按显示时刻 showUs 取进度；调用方持 animMutex_
+    void renderPlaybackFrame(int index, uint8_t* dst, uint64_t showUs);
+    // 结束（或中止）过渡：清除过渡状态并解除亮度冻结；调用方持 animMutex_
+    void finishTransition();
+    // 从当前画面跨淡入到 effect：出入场两个效果同时逐帧渲染并在线性空间混合；调用方持 animMutex_
+    void startCrossfade(AnimEffect* effect);
+    // 过渡开始 elapsedMs 后效果按自身帧间隔应播放的帧索引
+    int fadeFrameIndex(AnimEffect* effect, int startFrame, uint32_t elapsedMs) const;
+
+    // 图层渲染回调：按效果帧序渲染并转换为链序
+    static void renderLayerEntry(void* ctx, AnimEffect* effect, int index, uint8_t* dst);
+
     // 任务函数
     static void updateTaskEntry(void* parameter);
     static void sendTaskEntry(void* parameter);
     void updateTask();
     void sendTask();
+    // 播放循环的一拍：发布当前帧、推进帧时钟、预渲染下一帧并等待到下一截止时刻
+    void renderTick(int* dropFrames);
+
+    // 主机测试通过它在假时钟下逐拍驱动播放循环（test/support/anim_test_access.h）
+    friend struct AnimSystemTestAccess;
 }; 
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "brightness_ramp.h"
+
+#define BRIGHTNESS_FULL_Q8 (100u << 8)
+
+// Q8 亮度 <-> Q16 相对亮度
+static uint32_t q8_to_luminance(uint32_t q8)
+{
+    return (uint32_t)(((uint64_t)q8 << 16) / BRIGHTNESS_FULL_Q8);
+}
+
+static uint32_t luminance_to_q8(uint32_t y)
+{
+    return (uint32_t)(((uint64_t)y * BRIGHTNESS_FULL_Q8 + (TIMELINE_ONE / 2)) >> 16);
+}
+
+// 斜坡时钟：暂停期间停在暂停时刻
+static uint64_t ramp_clock(const BrightnessRamp* ramp, uint64_t nowUs)
+{
+    return ramp->paused ? ramp->pausedUs : nowUs;
+}
+
+void brightness_ramp_init(BrightnessRamp* ramp, uint8_t level)
+{
+    if (level > 100) level = 100;
+    ramp->fromQ8 = (uint32_t)level << 8;
+    ramp->toQ8 = ramp->fromQ8;
+    ramp->paused = false;
+    ramp->pausedUs = 0;
+    timeline_start(&ramp->timeline, 0, EASE_LINEAR, 0);
+}
+
+void brightness_ramp_retarget(BrightnessRamp* ramp, uint8_t target, uint32_t durationMs, EaseCurve ease, uint64_t nowUs)
+{
+    if (target > 100) target = 100;
+    nowUs = ramp_clock(ramp, nowUs);
+    ramp->fromQ8 = brightness_ramp_value_q8(ramp, nowUs);
+    ramp->toQ8 = (uint32_t)target << 8;
+    timeline_start(&ramp->timeline, durationMs, ease, nowUs);
+}
+
+uint32_t brightness_ramp_value_q8(const BrightnessRamp* ramp, uint64_t nowUs)
+{
+    nowUs = ramp_clock(ramp, nowUs);
+    if (timeline_done(&ramp->timeline, nowUs)) {
+        return ramp->toQ8;
+    }
+    if (ramp->timeline.ease == EASE_PERCEPTUAL) {
+        // 起止亮度换算到明度，按时间匀速插值后换回亮度
+        int32_t l0 = (int32_t)cie_luminance_to_lightness_q16(q8_to_luminance(ramp->fromQ8));
+        int32_t l1 = (int32_t)cie_luminance_to_lightness_q16(q8_to_luminance(ramp->toQ8));
+        uint32_t t = timeline_linear_q16(&ramp->timeline, nowUs);
+        int32_t l = l0 + (int32_t)(((int64_t)(l1 - l0) * t) >> 16);
+        return luminance_to_q8(cie_lightness_to_luminance_q16((uint32_t)l));
+    }
+    uint32_t e = timeline_progress_q16(&ramp->timeline, nowUs);
+    int32_t delta = (int32_t)ramp->toQ8 - (int32_t)ramp->fromQ8;
+    return (uint32_t)((int32_t)ramp->fromQ8 + (int32_t)(((int64_t)delta * e) >> 16));
+}
+
+uint8_t brightness_ramp_value(const BrightnessRamp* ramp, uint64_t nowUs)
+{
+    return (uint8_t)((brightness_ramp_value_q8(ramp, nowUs) + 128) >> 8);
+}
+
+bool brightness_ramp_done(const BrightnessRamp* ramp, uint64_t nowUs)
+{
+    return timeline_done(&ramp->timeline, ramp_clock(ramp, nowUs));
+}
+
+void brightness_ramp_pause(BrightnessRamp* ramp, uint64_t nowUs)
+{
+    if (ramp->paused) {
+        return;
+    }
+    ramp->paused = true;
+    ramp->pausedUs = nowUs;
+}
+
+void brightness_ramp_resume(BrightnessRamp* ramp, uint64_t nowUs)
+{
+    if (!ramp->paused) {
+        return;
+    }
+    ramp->paused = false;
+    if (nowUs > ramp->pausedUs) {
+        ramp->timeline.startUs += nowUs - ramp->pausedUs;
+    }
+}
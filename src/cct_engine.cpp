@@ -0,0 +1,98 @@
+#include "cct_engine.h"
+#include "cct_table.h"
+
+// 色温表由 gen_cct_table.py 在编译前根据实测数据（src/INDEX DUV R G B.txt）生成
+static_assert(CCT_TABLE_STEPS == CCT_STEP_COUNT && CCT_TABLE_DUV_VARIANTS == CCT_DUV_VARIANTS,
+              "cct_table.h does not match cct_engine.h");
+
+#define CCT_LAST_POS_Q8 ((CCT_STEP_COUNT - 1) << 8)
+
+bool cct_grid_rgb8(uint8_t tempIndex, uint8_t duvIndex, uint8_t* r, uint8_t* g, uint8_t* b)
+{
+    if (tempIndex < 1 || tempIndex > CCT_STEP_COUNT || duvIndex < 1 || duvIndex > CCT_DUV_VARIANTS) {
+        return false;
+    }
+    const uint8_t* c = CCT_TABLE_RGB[(tempIndex - 1) * CCT_DUV_VARIANTS + (duvIndex - 1)];
+    *r = c[0];
+    *g = c[1];
+    *b = c[2];
+    return true;
+}
+
+uint16_t cct_step_kelvin(uint8_t tempIndex)
+{
+    if (tempIndex < 1 || tempIndex > CCT_STEP_COUNT) {
+        return 0;
+    }
+    return CCT_STEP_KELVIN[tempIndex - 1];
+}
+
+const char* cct_step_name(uint8_t tempIndex)
+{
+    if (tempIndex < 1 || tempIndex > CCT_STEP_COUNT) {
+        return nullptr;
+    }
+    return CCT_STEP_NAME[tempIndex - 1];
+}
+
+uint8_t cct_kelvin_to_step(uint16_t kelvin)
+{
+    int k100 = (kelvin + 50) / 100 - CCT_TABLE_KELVIN_LUT_BASE;
+    if (k100 < 0) k100 = 0;
+    if (k100 >= CCT_TABLE_KELVIN_LUT_SIZE) k100 = CCT_TABLE_KELVIN_LUT_SIZE - 1;
+    return CCT_KELVIN_TO_STEP[k100];
+}
+
+uint16_t cct_rgb8_to_12(uint8_t v)
+{
+    // 4095/255 = 16 + 1/17
+    return (uint16_t)((((uint32_t)v << 20) + ((uint32_t)v << 16) / 17 + 32768) >> 16);
+}
+
+uint16_t cct_kelvin_to_pos_q8(uint16_t kelvin)
+{
+    if (kelvin <= CCT_KELVIN_MIN) {
+        return 0;
+    }
+    if (kelvin >= CCT_KELVIN_MAX) {
+        return CCT_LAST_POS_Q8;
+    }
+    if (kelvin <= 6500) {
+        return (uint16_t)((uint32_t)(kelvin - CCT_KELVIN_MIN) * 64 / 25);    // *256/100
+    }
+    return (uint16_t)((49 << 8) + (uint32_t)(kelvin - 6500) * 64 / 125);    // *256/500
+}
+
+void cct_rgb12_at(uint16_t posQ8, int16_t duvE5, uint16_t rgb[3])
+{
+    if (posQ8 > CCT_LAST_POS_Q8) posQ8 = CCT_LAST_POS_Q8;
+    if (duvE5 > CCT_DUV_MAX_E5) duvE5 = CCT_DUV_MAX_E5;
+    if (duvE5 < -CCT_DUV_MAX_E5) duvE5 = -CCT_DUV_MAX_E5;
+    // 表列从 +0.006 排到 -0.006
+    uint32_t colQ8 = (uint32_t)(CCT_DUV_MAX_E5 - duvE5) * 64 / 75;    // *256/300
+
+    uint32_t row = posQ8 >> 8, fx = posQ8 & 0xFF;
+    uint32_t col = colQ8 >> 8, fy = colQ8 & 0xFF;
+    // 落在最后一档/最后一列时取前一格的右端点，避免越界读取
+    if (row == CCT_STEP_COUNT - 1) { row--; fx = 256; }
+    if (col == CCT_DUV_VARIANTS - 1) { col--; fy = 256; }
+
+    const uint8_t* c00 = CCT_TABLE_RGB[row * CCT_DUV_VARIANTS + col];
+    const uint8_t* c01 = c00 + 3;                        // 下一列（DUV）
+    const uint8_t* c10 = c00 + CCT_DUV_VARIANTS * 3;     // 下一档（色温）
+    const uint8_t* c11 = c10 + 3;
+    uint32_t w00 = (256 - fx) * (256 - fy);
+    uint32_t w01 = (256 - fx) * fy;
+    uint32_t w10 = fx * (256 - fy);
+    uint32_t w11 = fx * fy;
+    for (int i = 0; i < 3; ++i) {
+        // s 为 Q16 的8位值，换算到12位：s*4095/255 = s*16 + s/17
+        uint32_t s = c00[i] * w00 + c01[i] * w01 + c10[i] * w10 + c11[i] * w11;
+        rgb[i] = (uint16_t)(((s << 4) + s / 17 + 32768) >> 16);
+    }
+}
+
+void cct_kelvin_rgb12(uint16_t kelvin, int16_t duvE5, uint16_t rgb[3])
+{
+    cct_rgb12_at(cct_kelvin_to_pos_q8(kelvin), duvE5, rgb);
+}
@@ -0,0 +1,413 @@
+// 由 gen_cct_table.py 根据 src/INDEX DUV R G B.txt 生成，请勿手工修改
+#pragma once
+#include <stdint.h>
+
+#define CCT_TABLE_STEPS 61
+#define CCT_TABLE_DUV_VARIANTS 5
+#define CCT_TABLE_KELVIN_LUT_BASE 16   // CCT_KELVIN_TO_STEP[0] 对应的色温/100
+#define CCT_TABLE_KELVIN_LUT_SIZE 105
+
+// 色温RGB表：每5行为一档色温的DUV变体（+0.006, +0.003, +0.000, -0.003, -0.006）
+static const uint8_t CCT_TABLE_RGB[305][3] = {
+    // 1600K
+    {180, 16, 3},
+    {181, 13, 6},
+    {182, 10, 9},
+    {182, 7, 12},
+    {183, 3, 14},
+    // 1700K
+    {172, 26, 3},
+    {173, 21, 7},
+    {173, 16, 11},
+    {175, 11, 15},
+    {175, 6, 19},
+    // 1800K
+    {163, 35, 2},
+    {164, 30, 6},
+    {165, 24, 10},
+    {166, 19, 15},
+    {168, 14, 19},
+    // 1900K
+    {155, 42, 3},
+    {156, 36, 7},
+    {158, 31, 12},
+    {159, 25, 16},
+    {160, 20, 20},
+    // 2000K
+    {147, 50, 3},
+    {149, 44, 7},
+    {150, 38, 12},
+    {152, 32, 16},
+    {153, 27, 20},
+    // 2100K
+    {140, 58, 3},
+    {141, 52, 7},
+    {143, 45, 12},
+    {145, 39, 16},
+    {146, 33, 21},
+    // 2200K
+    {132, 65, 3},
+    {134, 58, 7},
+    {136, 52, 12},
+    {138, 46, 17},
+    {139, 39, 21},
+    // 2300K
+    {125, 72, 3},
+    {127, 65, 8},
+    {129, 58, 13},
+    {131, 52, 17},
+    {133, 45, 22},
+    // 2400K
+    {118, 80, 2},
+    {120, 73, 7},
+    {122, 66, 12},
+    {125, 59, 16},
+    {127, 52, 21},
+    // 2500K
+    {111, 86, 2},
+    {114, 79, 7},
+    {116, 71, 12},
+    {119, 64, 17},
+    {121, 57, 22},
+    // 2600K
+    {105, 92, 3},
+    {108, 84, 8},
+    {110, 77, 13},
+    {113, 69, 18},
+    {116, 62, 23},
+    // 2700K
+    {98, 100, 2},
+    {101, 92, 7},
+    {104, 84, 12},
+    {107, 76, 17},
+    {109, 69, 22},
+    // 2800K
+    {93, 102, 5},
+    {96, 94, 10},
+    {99, 86, 15},
+    {102, 78, 20},
+    {105, 70, 25},
+    // 2900K
+    {89, 103, 8},
+    {92, 95, 13},
+    {95, 87, 18},
+    {98, 79, 23},
+    {101, 72, 27},
+    // 3000K
+    {85, 105, 11},
+    {88, 97, 16},
+    {91, 89, 21},
+    {94, 80, 25},
+    {97, 73, 30},
+    // 3100K
+    {81, 106, 14},
+    {84, 97, 19},
+    {87, 89, 23},
+    {91, 81, 28},
+    {94, 73, 33},
+    // 3200K
+    {77, 107, 16},
+    {81, 98, 21},
+    {84, 90, 26},
+    {88, 82, 31},
+    {91, 74, 36},
+    // 3300K
+    {74, 107, 19},
+    {77, 98, 24},
+    {81, 90, 29},
+    {85, 82, 34},
+    {88, 74, 38},
+    // 3400K
+    {70, 107, 22},
+    {74, 99, 27},
+    {78, 90, 32},
+    {82, 82, 37},
+    {85, 74, 41},
+    // 3500K
+    {67, 107, 26},
+    {71, 98, 30},
+    {75, 90, 35},
+    {79, 82, 39},
+    {83, 73, 44},
+    // 3600K
+    {65, 107, 29},
+    {69, 98, 33},
+    {73, 90, 38},
+    {77, 81, 42},
+    {80, 73, 47},
+    // 3700K
+    {62, 107, 32},
+    {66, 98, 36},
+    {70, 89, 41},
+    {74, 81, 45},
+    {78, 73, 49},
+    // 3800K
+    {60, 106, 35},
+    {64, 97, 39},
+    {68, 88, 43},
+    {72, 80, 48},
+    {76, 72, 52},
+    // 3900K
+    {57, 105, 38},
+    {62, 96, 42},
+    {66, 88, 46},
+    {70, 79, 50},
+    {75, 71, 55},
+    // 4000K
+    {55, 104, 40},
+    {60, 95, 45},
+    {64, 87, 49},
+    {69, 78, 53},
+    {73, 70, 57},
+    // 4100K
+    {53, 103, 43},
+    {58, 95, 48},
+    {63, 86, 52},
+    {67, 78, 56},
+    {71, 69, 60},
+    // 4200K
+    {52, 102, 46},
+    {56, 93, 50},
+    {61, 85, 54},
+    {65, 76, 58},
+    {70, 68, 62},
+    // 4300K
+    {50, 101, 49},
+    {55, 92, 53},
+    {59, 84, 57},
+    {64, 75, 61},
+    {68, 67, 64},
+    // 4400K
+    {48, 100, 52},
+    {53, 91, 56},
+    {58, 83, 59},
+    {63, 74, 63},
+    {67, 66, 67},
+    // 4500K
+    {47, 99, 54},
+    {52, 90, 58},
+    {57, 81, 62},
+    {61, 73, 66},
+    {66, 65, 69},
+    // 4600K
+    {46, 97, 57},
+    {51, 89, 61},
+    {56, 80, 64},
+    {60, 72, 68},
+    {65, 64, 71},
+    // 4700K
+    {44, 96, 60},
+    {49, 87, 63},
+    {54, 79, 67},
+    {59, 71, 70},
+    {64, 63, 74},
+    // 4800K
+    {43, 95, 62},
+    {48, 86, 66},
+    {53, 78, 69},
+    {58, 70, 72},
+    {63, 62, 76},
+    // 4900K
+    {42, 93, 65},
+    {47, 85, 68},
+    {52, 76, 71},
+    {57, 68, 75},
+    {62, 60, 78},
+    // 5000K
+    {41, 92, 67},
+    {46, 83, 70},
+    {52, 75, 74},
+    {56, 67, 77},
+    {61, 59, 80},
+    // 5100K
+    {40, 91, 69},
+    {45, 82, 73},
+    {51, 74, 76},
+    {56, 66, 79},
+    {60, 58, 82},
+    // 5200K
+    {39, 89, 72},
+    {45, 80, 75},
+    {50, 72, 78},
+    {55, 64, 81},
+    {60, 57, 84},
+    // 5300K
+    {39, 87, 74},
+    {44, 79, 77},
+    {49, 71, 80},
+    {54, 63, 83},
+    {59, 55, 86},
+    // 5400K
+    {38, 86, 76},
+    {43, 78, 79},
+    {49, 70, 82},
+    {54, 62, 85},
+    {59, 54, 87},
+    // 5500K
+    {37, 85, 78},
+    {43, 76, 81},
+    {48, 68, 84},
+    {53, 60, 87},
+    {58, 53, 89},
+    // 5600K
+    {36, 83, 80},
+    {42, 75, 83},
+    {47, 67, 86},
+    {52, 59, 88},
+    {57, 52, 91},
+    // 5700K
+    {36, 82, 82},
+    {41, 74, 85},
+    {47, 66, 88},
+    {52, 58, 90},
+    {57, 50, 93},
+    // 5800K
+    {35, 80, 84},
+    {41, 72, 87},
+    {46, 64, 90},
+    {51, 57, 92},
+    {57, 49, 94},
+    // 5900K
+    {35, 79, 86},
+    {40, 71, 89},
+    {46, 63, 91},
+    {51, 55, 94},
+    {56, 48, 96},
+    // 6000K
+    {34, 77, 88},
+    {40, 69, 91},
+    {45, 62, 93},
+    {51, 54, 95},
+    {56, 47, 98},
+    // 6100K
+    {34, 76, 90},
+    {40, 68, 92},
+    {45, 60, 95},
+    {50, 53, 97},
+    {55, 46, 99},
+    // 6200K
+    {34, 75, 92},
+    {39, 67, 94},
+    {45, 59, 96},
+    {50, 52, 98},
+    {55, 44, 101},
+    // 6300K
+    {33, 73, 94},
+    {39, 66, 96},
+    {44, 58, 98},
+    {50, 50, 100},
+    {55, 43, 102},
+    // 6400K
+    {33, 72, 95},
+    {39, 64, 97},
+    {44, 57, 99},
+    {49, 49, 102},
+    {54, 42, 103},
+    // 6500K
+    {32, 71, 97},
+    {38, 63, 99},
+    {44, 55, 101},
+    {49, 48, 103},
+    {54, 41, 105},
+    // 7000K
+    {31, 64, 104},
+    {37, 57, 106},
+    {43, 50, 108},
+    {48, 43, 110},
+    {53, 36, 111},
+    // 7500K
+    {30, 59, 111},
+    {36, 51, 113},
+    {42, 44, 114},
+    {47, 38, 116},
+    {52, 31, 117},
+    // 8000K
+    {30, 53, 117},
+    {35, 46, 118},
+    {41, 39, 120},
+    {47, 33, 121},
+    {52, 26, 122},
+    // 8500K
+    {29, 48, 122},
+    {35, 42, 123},
+    {41, 35, 124},
+    {46, 28, 125},
+    {52, 22, 126},
+    // 9000K
+    {29, 44, 127},
+    {35, 37, 128},
+    {41, 31, 129},
+    {46, 25, 130},
+    {51, 18, 130},
+    // 9500K
+    {29, 40, 131},
+    {35, 33, 132},
+    {41, 27, 132},
+    {46, 21, 134},
+    {51, 15, 134},
+    // 10000K
+    {29, 36, 135},
+    {35, 30, 135},
+    {40, 24, 136},
+    {46, 18, 136},
+    {51, 12, 137},
+    // 10500K
+    {29, 33, 138},
+    {35, 27, 139},
+    {41, 21, 139},
+    {46, 15, 139},
+    {51, 9, 140},
+    // 11000K
+    {29, 30, 141},
+    {35, 24, 142},
+    {41, 18, 142},
+    {46, 12, 142},
+    {51, 6, 142},
+    // 11500K
+    {30, 27, 144},
+    {35, 21, 144},
+    {41, 15, 144},
+    {46, 9, 145},
+    {51, 4, 145},
+    // 12000K
+    {29, 24, 146},
+    {35, 18, 146},
+    {41, 13, 146},
+    {46, 7, 147},
+    {51, 2, 147},
+};
+
+// DUV 列（1e-5）
+static const int16_t CCT_TABLE_DUV_E5[5] = {600, 300, 0, -300, -600};
+
+// 档位（1-61）的标称色温，下标为档位-1
+static const uint16_t CCT_STEP_KELVIN[61] = {
+    1600, 1700, 1800, 1900, 2000, 2100, 2200, 2300, 2400, 2500,
+    2600, 2700, 2800, 2900, 3000, 3100, 3200, 3300, 3400, 3500,
+    3600, 3700, 3800, 3900, 4000, 4100, 4200, 4300, 4400, 4500,
+    4600, 4700, 4800, 4900, 5000, 5100, 5200, 5300, 5400, 5500,
+    5600, 5700, 5800, 5900, 6000, 6100, 6200, 6300, 6400, 6500,
+    7000, 7500, 8000, 8500, 9000, 9500, 10000, 10500, 11000, 11500,
+    12000,
+};
+
+// 档位名称
+static const char* const CCT_STEP_NAME[61] = {
+    "1600K", "1700K", "1800K", "1900K", "2000K", "2100K", "2200K", "2300K", "2400K", "2500K",
+    "2600K", "2700K", "2800K", "2900K", "3000K", "3100K", "3200K", "3300K", "3400K", "3500K",
+    "3600K", "3700K", "3800K", "3900K", "4000K", "4100K", "4200K", "4300K", "4400K", "4500K",
+    "4600K", "4700K", "4800K", "4900K", "5000K", "5100K", "5200K", "5300K", "5400K", "5500K",
+    "5600K", "5700K", "5800K", "5900K", "6000K", "6100K", "6200K", "6300K", "6400K", "6500K",
+    "7000K", "7500K", "8000K", "8500K", "9000K", "9500K", "10000K", "10500K", "11000K", "11500K",
+    "12000K",
+};
+
+// 色温/100 - CCT_TABLE_KELVIN_LUT_BASE -> 最近档位（1-61）
+static const uint8_t CCT_KELVIN_TO_STEP[105] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+    21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 50, 50, 51, 51, 51, 51, 51, 52, 52, 52,
+    52, 52, 53, 53, 53, 53, 53, 54, 54, 54, 54, 54, 55, 55, 55, 55, 55, 56, 56, 56,
+    56, 56, 57, 57, 57, 57, 57, 58, 58, 58, 58, 58, 59, 59, 59, 59, 59, 60, 60, 60,
+    60, 60, 61, 61, 61,
+};
@@ -0,0 +1,86 @@
+#include "color_calib.h"
+
+void color_calib_identity(ColorCalib* calib)
+{
+    for (int i = 0; i < 9; ++i) {
+        calib->m[i] = (i % 4 == 0) ? COLOR_CALIB_ONE : 0;
+    }
+    calib->offset[0] = calib->offset[1] = calib->offset[2] = 0;
+}
+
+bool color_calib_is_identity(const ColorCalib* calib)
+{
+    for (int i = 0; i < 9; ++i) {
+        if (calib->m[i] != ((i % 4 == 0) ? COLOR_CALIB_ONE : 0)) {
+            return false;
+        }
+    }
+    return calib->offset[0] == 0 && calib->offset[1] == 0 && calib->offset[2] == 0;
+}
+
+bool color_calib_valid(const ColorCalib* calib)
+{
+    for (int c = 0; c < 3; ++c) {
+        if (calib->offset[c] < -COLOR_CALIB_OFFSET_MAX || calib->offset[c] > COLOR_CALIB_OFFSET_MAX) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline uint8_t clamp_u8(int32_t v)
+{
+    return (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+void color_calib_apply(const ColorCalib* calib, uint8_t* rgb, int chips)
+{
+    // 系数与舍入/偏移常量提到循环外；每颗芯片9次 16x8 位乘加（Xtensa 上为 MUL16S），累加不超出32位
+    const int32_t m0 = calib->m[0], m1 = calib->m[1], m2 = calib->m[2];
+    const int32_t m3 = calib->m[3], m4 = calib->m[4], m5 = calib->m[5];
+    const int32_t m6 = calib->m[6], m7 = calib->m[7], m8 = calib->m[8];
+    const int32_t b0 = ((int32_t)calib->offset[0] << 12) + COLOR_CALIB_ONE / 2;
+    const int32_t b1 = ((int32_t)calib->offset[1] << 12) + COLOR_CALIB_ONE / 2;
+    const int32_t b2 = ((int32_t)calib->offset[2] << 12) + COLOR_CALIB_ONE / 2;
+    for (int i = 0; i < chips; ++i, rgb += 3) {
+        int32_t r = rgb[0], g = rgb[1], b = rgb[2];
+        // 熄灭的芯片保持全黑，偏移不能把它点亮
+        if ((r | g | b) == 0) {
+            continue;
+        }
+        rgb[0] = clamp_u8((m0 * r + m1 * g + m2 * b + b0) >> 12);
+        rgb[1] = clamp_u8((m3 * r + m4 * g + m5 * b + b1) >> 12);
+        rgb[2] = clamp_u8((m6 * r + m7 * g + m8 * b + b2) >> 12);
+    }
+}
+
+static inline void put_i16(uint8_t* out, int16_t v)
+{
+    out[0] = (uint8_t)((uint16_t)v >> 8);
+    out[1] = (uint8_t)((uint16_t)v & 0xFF);
+}
+
+static inline int16_t get_i16(const uint8_t* in)
+{
+    return (int16_t)(((uint16_t)in[0] << 8) | in[1]);
+}
+
+void color_calib_encode(const ColorCalib* calib, uint8_t out[COLOR_CALIB_WIRE_SIZE])
+{
+    for (int i = 0; i < 9; ++i) {
+        put_i16(out + i * 2, calib->m[i]);
+    }
+    for (int c = 0; c < 3; ++c) {
+        put_i16(out + 18 + c * 2, calib->offset[c]);
+    }
+}
+
+void color_calib_decode(const uint8_t in[COLOR_CALIB_WIRE_SIZE], ColorCalib* calib)
+{
+    for (int i = 0; i < 9; ++i) {
+        calib->m[i] = get_i16(in + i * 2);
+    }
+    for (int c = 0; c < 3; ++c) {
+        calib->offset[c] = get_i16(in + 18 + c * 2);
+    }
+}
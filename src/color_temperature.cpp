@@ -0,0 +1,104 @@
+#include "color_temperature.h"
+#include "cct_engine.h"
+
+static_assert(COLOR_TEMP_STANDARD_COUNT == CCT_STEP_COUNT && COLOR_TEMP_DUV_VARIANTS == CCT_DUV_VARIANTS,
+              "color_temperature.h does not match cct_engine.h");
+
+// 12位 -> 8位，四舍五入
+static uint8_t rgb12_to_8(uint16_t v)
+{
+    return (uint8_t)(((uint32_t)v * 255 + CCT_RGB12_MAX / 2) / CCT_RGB12_MAX);
+}
+
+ColorTemperatureManager::ColorTemperatureManager() {}
+
+ColorTemperatureManager::~ColorTemperatureManager() {}
+
+bool ColorTemperatureManager::init() {
+    return true;
+}
+
+bool ColorTemperatureManager::getColorTempByIndex(uint16_t index, ColorTemperature& colorTemp) {
+    if (index >= COLOR_TEMP_TOTAL_COUNT) {
+        return false;
+    }
+    uint8_t step = (uint8_t)(index / COLOR_TEMP_DUV_VARIANTS + 1);
+    uint8_t duv = (uint8_t)(index % COLOR_TEMP_DUV_VARIANTS);
+    colorTemp.kelvin = cct_step_kelvin(step);
+    colorTemp.duvE5 = (int16_t)(CCT_DUV_MAX_E5 - duv * CCT_DUV_STEP_E5);
+    colorTemp.name = cct_step_name(step);
+    return cct_grid_rgb8(step, (uint8_t)(duv + 1), &colorTemp.r, &colorTemp.g, &colorTemp.b);
+}
+
+bool ColorTemperatureManager::getColorTempRGB(uint16_t kelvin, DuvDirection duv, uint8_t* r, uint8_t* g, uint8_t* b) {
+    if ((unsigned)duv >= COLOR_TEMP_DUV_VARIANTS || kelvin < getMinKelvin() || kelvin > getMaxKelvin()) {
+        return false;
+    }
+    return cct_grid_rgb8(cct_kelvin_to_step(kelvin), (uint8_t)(duv + 1), r, g, b);
+}
+
+void ColorTemperatureManager::getColorTempRGB(uint8_t tempIndex, uint8_t* r, uint8_t* g, uint8_t* b) {
+    if (!cct_grid_rgb8(tempIndex, DUV_ZERO + 1, r, g, b)) {
+        *r = *g = *b = 0;
+    }
+}
+
+bool ColorTemperatureManager::isValidStep(uint8_t tempIndex, uint8_t duvIndex) {
+    return tempIndex >= 1 && tempIndex <= COLOR_TEMP_STANDARD_COUNT && duvIndex >= 1 && duvIndex <= COLOR_TEMP_DUV_VARIANTS;
+}
+
+bool ColorTemperatureManager::getStepRGB(uint8_t tempIndex, uint8_t duvIndex, uint8_t* r, uint8_t* g, uint8_t* b) {
+    if (cct_grid_rgb8(tempIndex, duvIndex, r, g, b)) {
+        return true;
+    }
+    *r = *g = *b = 0;
+    return false;
+}
+
+uint16_t ColorTemperatureManager::getKelvinByIndex(uint16_t index) {
+    return indexToKelvin(index);
+}
+
+DuvDirection ColorTemperatureManager::getDuvByIndex(uint16_t index) {
+    return indexToDuv(index);
+}
+
+const char* ColorTemperatureManager::getNameByIndex(uint16_t index) {
+    if (index >= COLOR_TEMP_TOTAL_COUNT) {
+        return nullptr;
+    }
+    return cct_step_name((uint8_t)(index / COLOR_TEMP_DUV_VARIANTS + 1));
+}
+
+void ColorTemperatureManager::kelvinToRGB(uint16_t kelvin, uint8_t* r, uint8_t* g, uint8_t* b) {
+    kelvinDuvToRGB(kelvin, 0, r, g, b);
+}
+
+void ColorTemperatureManager::kelvinDuvToRGB(uint16_t kelvin, int16_t duvE5, uint8_t* r, uint8_t* g, uint8_t* b) {
+    uint16_t rgb[3];
+    cct_kelvin_rgb12(kelvin, duvE5, rgb);
+    *r = rgb12_to_8(rgb[0]);
+    *g = rgb12_to_8(rgb[1]);
+    *b = rgb12_to_8(rgb[2]);
+}
+
+uint16_t ColorTemperatureManager::indexToKelvin(uint16_t index) {
+    if (index >= COLOR_TEMP_TOTAL_COUNT) {
+        return 0;
+    }
+    return cct_step_kelvin((uint8_t)(index / COLOR_TEMP_DUV_VARIANTS + 1));
+}
+
+DuvDirection ColorTemperatureManager::indexToDuv(uint16_t index) {
+    if (index >= COLOR_TEMP_TOTAL_COUNT) {
+        return DUV_ZERO;
+    }
+    return (DuvDirection)(index % COLOR_TEMP_DUV_VARIANTS);
+}
+
+uint16_t ColorTemperatureManager::kelvinDuvToIndex(uint16_t kelvin, DuvDirection duv) {
+    if ((unsigned)duv >= COLOR_TEMP_DUV_VARIANTS) {
+        duv = DUV_ZERO;
+    }
+    return (uint16_t)((cct_kelvin_to_step(kelvin) - 1) * COLOR_TEMP_DUV_VARIANTS + duv);
+}
@@ -1,6 +1,7 @@
 #include "dynamic_animations.h"
 #include <Arduino.h>
 #include <cmath>
+#include "panel_config.h"
 
 // ==================== BlinkAnimation 实现 ====================
 
@@ -11,7 +12,7 @@ BlinkAnimation::BlinkAnimation(uint8_t r, uint8_t g, uint8_t b, int frameCount)
 void BlinkAnimation::generateFrame(uint8_t* buffer, int frameIndex) {
     bool isOn = (frameIndex < frameCount_ * dutyCycle_);
     
-    for (int led = 0; led < 36; led++) {
+    for (int led = 0; led < panel_chip_count(); led++) {
         int baseIndex = led * 3;
         if (isOn) {
             buffer[baseIndex + 0] = r_;
@@ -41,7 +42,7 @@ GradientAnimation::GradientAnimation(uint8_t r1, uint8_t g1, uint8_t b1,
 void GradientAnimation::generateFrame(uint8_t* buffer, int frameIndex) {
     float progress = (float)frameIndex / (frameCount_ - 1);
     
-    for (int led = 0; led < 36; led++) {
+    for (int led = 0; led < panel_chip_count(); led++) {
         int baseIndex = led * 3;
         buffer[baseIndex + 0] = (uint8_t)(r1_ + (r2_ - r1_) * progress);
         buffer[baseIndex + 1] = (uint8_t)(g1_ + (g2_ - g1_) * progress);
@@ -69,10 +70,10 @@ WaveAnimation::WaveAnimation(uint8_t r, uint8_t g, uint8_t b, int frameCount)
 }
 
 void WaveAnimation::generateFrame(uint8_t* buffer, int frameIndex) {
-    for (int led = 0; led < 36; led++) {
-        // 计算LED在6x6矩阵中的位置
-        int row = led / 6;
-        int col = led % 6;
+    for (int led = 0; led < panel_chip_count(); led++) {
+        // 计算LED在面板矩阵中的位置
+        int row = led / panel_width();
+        int col = led % panel_width();
         
         // 创建波浪效果
         float wave = sin((row + col + frameIndex * waveSpeed_) * 0.5f) * waveAmplitude_ + 0.5f;
@@ -99,14 +100,15 @@ RotateAnimation::RotateAnimation(uint8_t r, uint8_t g, uint8_t b, int frameCount
 
 void RotateAnimation::generateFrame(uint8_t* buffer, int frameIndex) {
     // 清空缓冲区
-    memset(buffer, 0, 108);
+    memset(buffer, 0, panel_frame_size());
     
     // 计算旋转角度
     float angle = frameIndex * rotationSpeed_ * 10.0f;
-    int centerX = 3, centerY = 3;  // 6x6矩阵的中心
+    const int W = panel_width(), H = panel_height();
+    int centerX = W / 2, centerY = H / 2;  // 面板矩阵的中心
     
     // 在中心位置放置一个LED
-    int ledIndex = centerY * 6 + centerX;
+    int ledIndex = centerY * W + centerX;
     int baseIndex = ledIndex * 3;
     buffer[baseIndex + 0] = r_;
     buffer[baseIndex + 1] = g_;
@@ -117,8 +119,8 @@ void RotateAnimation::generateFrame(uint8_t* buffer, int frameIndex) {
     int x = centerX + (int)(2 * cos(rad));
     int y = centerY + (int)(2 * sin(rad));
     
-    if (x >= 0 && x < 6 && y >= 0 && y < 6) {
-        ledIndex = y * 6 + x;
+    if (x >= 0 && x < W && y >= 0 && y < H) {
+        ledIndex = y * W + x;
         baseIndex = ledIndex * 3;
         buffer[baseIndex + 0] = r_;
         buffer[baseIndex + 1] = g_;
@@ -143,7 +145,7 @@ void PulseAnimation::generateFrame(uint8_t* buffer, int frameIndex) {
     float pulse = sin(frameIndex * pulseCount_ * 2 * PI / frameCount_);
     uint8_t intensity = (uint8_t)((pulse + 1) * 127.5f);
     
-    for (int led = 0; led < 36; led++) {
+    for (int led = 0; led < panel_chip_count(); led++) {
         int baseIndex = led * 3;
         buffer[baseIndex + 0] = (uint8_t)(r_ * intensity / 255.0f);
         buffer[baseIndex + 1] = (uint8_t)(g_ * intensity / 255.0f);
@@ -166,18 +168,18 @@ CandleFlameAnimation::CandleFlameAnimation(uint8_t r, uint8_t g, uint8_t b, int
 
 void CandleFlameAnimation::generateFrame(uint8_t* buffer, int frameIndex) {
     // 清空缓冲区
-    memset(buffer, 0, 108);
+    memset(buffer, 0, panel_frame_size());
     
     // 计算时间因子
     float time = frameIndex * 0.2f;  // 控制晃动速度
     
-    // 烛火中心位置（6x6矩阵的中心）
-    int centerX = 3, centerY = 3;
+    // 烛火中心位置（面板矩阵的中心）
+    int centerX = panel_width() / 2, centerY = panel_height() / 2;
     
     // 生成烛火形状和晃动效果
-    for (int led = 0; led < 36; led++) {
-        int row = led / 6;
-        int col = led % 6;
+    for (int led = 0; led < panel_chip_count(); led++) {
+        int row = led / panel_width();
+        int col = led % panel_width();
         
         // 计算到中心的距离
         float dx = (col - centerX) * 0.5f;
@@ -242,10 +244,10 @@ RandomBlinkAnimation::RandomBlinkAnimation(uint8_t r, uint8_t g, uint8_t b, int
 
 void RandomBlinkAnimation::generateFrame(uint8_t* buffer, int frameIndex) {
     // 清空缓冲区
-    memset(buffer, 0, 108);
+    memset(buffer, 0, panel_frame_size());
     
     // 为每个LED生成随机状态
-    for (int led = 0; led < 36; led++) {
+    for (int led = 0; led < panel_chip_count(); led++) {
         // 使用简单的伪随机数生成器
         randomSeed_ = (randomSeed_ * 1103515245 + 12345) & 0x7fffffff;
         float randomValue = (float)(randomSeed_ & 0xFFFF) / 65535.0f;
@@ -284,13 +286,13 @@ void generateCandleFlameData(uint8_t* buffer, int frameCount, uint8_t r, uint8_t
         // 计算时间因子
         float time = frame * 0.2f;  // 控制晃动速度
         
-        // 烛火中心位置（6x6矩阵的中心）
-        int centerX = 3, centerY = 3;
+        // 烛火中心位置（面板矩阵的中心）
+        int centerX = panel_width() / 2, centerY = panel_height() / 2;
         
         // 生成烛火形状和晃动效果
-        for (int led = 0; led < 36; led++) {
-            int row = led / 6;
-            int col = led % 6;
+        for (int led = 0; led < panel_chip_count(); led++) {
+            int row = led / panel_width();
+            int col = led % panel_width();
             
             // 计算到中心的距离
             float dx = (col - centerX) * 0.5f;
@@ -320,7 +322,7 @@ void generateCandleFlameData(uint8_t* buffer, int frameCount, uint8_t r, uint8_t
             if (intensity < 0.0f) intensity = 0.0f;
             
             // 应用颜色和强度
-            int baseIndex = frame * 108 + led * 3;
+            int baseIndex = frame * panel_frame_size() + led * 3;
             buffer[baseIndex + 0] = (uint8_t)(r * intensity);  // R
             buffer[baseIndex + 1] = (uint8_t)(g * intensity);  // G
             buffer[baseIndex + 2] = (uint8_t)(b * intensity);  // B
@@ -338,16 +340,19 @@ void generateOptimizedCandleFlameData(uint8_t* buffer, int frameCount, uint8_t r
     float flickerRate = 0.15f;      // 闪烁频率
     float flameHeight = 0.8f;       // 火焰高度因子
     
+    const float halfW = (panel_width() - 1) / 2.0f;
+    const float halfH = (panel_height() - 1) / 2.0f;
+    
     for (int frame = 0; frame < frameCount; frame++) {
         float time = frame * 0.15f;  // 时间因子
         
-        for (int led = 0; led < 36; led++) {
-            int row = led / 6;
-            int col = led % 6;
+        for (int led = 0; led < panel_chip_count(); led++) {
+            int row = led / panel_width();
+            int col = led % panel_width();
             
             // 计算相对位置
-            float x = (col - 2.5f) / 2.5f;  // -1.0 到 1.0
-            float y = (row - 2.5f) / 2.5f;  // -1.0 到 1.0
+            float x = halfW > 0 ? (col - halfW) / halfW : 0.0f;  // -1.0 到 1.0
+            float y = halfH > 0 ? (row - halfH) / halfH : 0.0f;  // -1.0 到 1.0
             
             // 基础火焰形状（锥形）
             float flameBase = 1.0f - (x * x) / 1.5f;
@@ -375,7 +380,7 @@ void generateOptimizedCandleFlameData(uint8_t* buffer, int frameCount, uint8_t r
             if (intensity < 0.0f) intensity = 0.0f;
             
             // 写入数据
-            int baseIndex = frame * 108 + led * 3;
+            int baseIndex = frame * panel_frame_size() + led * 3;
             buffer[baseIndex + 0] = (uint8_t)(r * intensity);  // R
             buffer[baseIndex + 1] = (uint8_t)(g * intensity);  // G
             buffer[baseIndex + 2] = (uint8_t)(b * intensity);  // B
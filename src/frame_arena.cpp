@@ -0,0 +1,25 @@
+#include "frame_arena.hpp"
+#include <stdlib.h>
+
+FrameArena::~FrameArena() {
+    free(base_);
+}
+
+bool FrameArena::init(size_t capacity) {
+    free(base_);
+    used_ = 0;
+    failedCarves_ = 0;
+    base_ = (uint8_t*)calloc(capacity, 1);
+    capacity_ = base_ ? capacity : 0;
+    return base_ != nullptr;
+}
+
+uint8_t* FrameArena::carve(size_t bytes) {
+    size_t offset = (used_ + 3) & ~(size_t)3;
+    if (!base_ || offset + bytes > capacity_) {
+        failedCarves_++;
+        return nullptr;
+    }
+    used_ = offset + bytes;
+    return base_ + offset;
+}
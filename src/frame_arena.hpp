@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// 帧缓冲池：init 时一次性向堆申请，之后各缓冲从中切分，运行期不再分配或释放，
+// 长时间频繁切换效果也不会造成堆碎片
+class FrameArena {
+public:
+    FrameArena() = default;
+    ~FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // 分配 capacity 字节的池（已清零）；重复调用会释放旧池，已切出的缓冲随之失效
+    bool init(size_t capacity);
+    // 切出 bytes 字节（4字节对齐）；池不足时返回nullptr并计入 failedCarves
+    uint8_t* carve(size_t bytes);
+
+    size_t capacity() const { return capacity_; }
+    size_t used() const { return used_; }
+    uint32_t failedCarves() const { return failedCarves_; }
+
+private:
+    uint8_t* base_ = nullptr;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    uint32_t failedCarves_ = 0;
+};
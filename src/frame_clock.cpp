@@ -0,0 +1,37 @@
+#include "frame_clock.hpp"
+
+uint32_t FrameClock::frameDone(uint64_t nowUs, int* dropFrames) {
+    uint32_t lateness = nowUs > deadlineUs_ ? (uint32_t)(nowUs - deadlineUs_) : 0;
+    stats_.frames++;
+    stats_.lastLatenessUs = lateness;
+    if (lateness > stats_.maxLatenessUs) {
+        stats_.maxLatenessUs = lateness;
+    }
+    if (lateness > lateToleranceUs_) {
+        stats_.lateFrames++;
+    }
+
+    uint64_t next = deadlineUs_ + periodUs_;
+    int drop = 0;
+    if (nowUs >= next) {
+        // 已错过下一截止时刻
+        if (policy_ == DROP) {
+            uint64_t missed = (nowUs - next) / periodUs_ + 1;
+            next += missed * periodUs_;
+            drop = (int)missed;
+            stats_.droppedFrames += (uint32_t)missed;
+        } else {
+            next = nowUs;
+            stats_.stretchedFrames++;
+        }
+    }
+    deadlineUs_ = next;
+    if (dropFrames) {
+        *dropFrames = drop;
+    }
+    return next > nowUs ? (uint32_t)(next - nowUs) : 0;
+}
+
+void FrameClock::resetStats() {
+    stats_ = FrameClockStats();
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+// 帧时钟统计（微秒）
+struct FrameClockStats {
+    uint32_t frames;           // 已计时的帧数
+    uint32_t lateFrames;       // 迟到超过容差的帧数
+    uint32_t droppedFrames;    // DROP 策略下跳过的动画帧数
+    uint32_t stretchedFrames;  // STRETCH 策略下顺延时间线的次数
+    uint32_t lastLatenessUs;
+    uint32_t maxLatenessUs;
+};
+
+// 按绝对截止时刻推进的帧时钟：第n帧应在 start + n*period 发出，周期不随渲染/发送耗时漂移。
+// 不读取系统时间，由调用方传入当前时刻，主机上可用虚拟时钟驱动
+class FrameClock {
+public:
+    // 渲染落后超过一个周期时的处理：DROP 跳过动画帧保持时间线，STRETCH 从当前时刻顺延时间线
+    enum LatePolicy { DROP, STRETCH };
+
+    explicit FrameClock(uint32_t lateToleranceUs = 1000) : lateToleranceUs_(lateToleranceUs) {}
+
+    // 从 nowUs 开始计时，第一帧立即到期
+    void start(uint64_t nowUs) { deadlineUs_ = nowUs; }
+    // 新周期从下一个截止时刻起生效
+    void setPeriodUs(uint32_t periodUs) { periodUs_ = periodUs ? periodUs : 1; }
+    uint32_t periodUs() const { return periodUs_; }
+    void setLatePolicy(LatePolicy policy) { policy_ = policy; }
+    LatePolicy latePolicy() const { return policy_; }
+
+    // 当前到期帧在 nowUs 发出后调用：记录迟到量，返回距下一截止时刻的等待时长；
+    // dropFrames 为下一帧之前应跳过的动画帧数（仅 DROP 策略可能非0）
+    uint32_t frameDone(uint64_t nowUs, int* dropFrames);
+
+    const FrameClockStats& stats() const { return stats_; }
+    void resetStats();
+
+private:
+    uint64_t deadlineUs_ = 0;
+    uint32_t periodUs_ = 20000;
+    uint32_t lateToleranceUs_;
+    LatePolicy policy_ = DROP;
+    FrameClockStats stats_ = {};
+};
@@ -0,0 +1,30 @@
+#include "frame_triple_buffer.hpp"
+
+bool FrameTripleBuffer::init(uint8_t* storage, int frameSize) {
+    if (!storage) {
+        return false;
+    }
+    for (int i = 0; i < 3; ++i) {
+        buffers_[i] = storage + i * frameSize;
+    }
+    back_ = 0;
+    front_ = 1;
+    middle_.store(2, std::memory_order_relaxed);
+    return true;
+}
+
+void FrameTripleBuffer::publish() {
+    // release：本帧写入对取到该块的消费者可见
+    uint32_t prev = middle_.exchange(back_ | FRESH_BIT, std::memory_order_acq_rel);
+    back_ = prev & INDEX_MASK;
+}
+
+bool FrameTripleBuffer::acquire() {
+    if (!(middle_.load(std::memory_order_relaxed) & FRESH_BIT)) {
+        return false;
+    }
+    // acquire：与生产者的 publish 配对，换入后读到的是完整帧
+    uint32_t prev = middle_.exchange(front_, std::memory_order_acq_rel);
+    front_ = prev & INDEX_MASK;
+    return true;
+}
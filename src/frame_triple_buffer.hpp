@@ -0,0 +1,34 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// 单生产者/单消费者三缓冲：渲染端写后台块并发布，发送端随时取最新完整帧。
+// 两端都不加锁、不等待对方；中间块的索引与“有新帧”标志放在同一个原子字里交换
+class FrameTripleBuffer {
+public:
+    FrameTripleBuffer() = default;
+    FrameTripleBuffer(const FrameTripleBuffer&) = delete;
+    FrameTripleBuffer& operator=(const FrameTripleBuffer&) = delete;
+
+    // 使用调用方提供的 3*frameSize 字节存放三块帧缓冲（不持有、不释放）；两端开始工作前调用
+    bool init(uint8_t* storage, int frameSize);
+
+    // 生产者：当前可写的后台块
+    uint8_t* writeBuffer() { return buffers_[back_]; }
+    // 生产者：把后台块发布为最新帧，换回上一块中间块继续写
+    void publish();
+
+    // 消费者：若有新帧则换入前台并返回true，否则保持当前前台块
+    bool acquire();
+    // 消费者：当前前台块（上一次 acquire 得到的帧）
+    const uint8_t* readBuffer() const { return buffers_[front_]; }
+
+private:
+    static const uint32_t FRESH_BIT = 0x4;
+    static const uint32_t INDEX_MASK = 0x3;
+
+    uint8_t* buffers_[3] = {nullptr, nullptr, nullptr};
+    uint32_t back_ = 0;                  // 仅生产者访问
+    uint32_t front_ = 1;                 // 仅消费者访问
+    std::atomic<uint32_t> middle_{2};    // 中间块索引 | FRESH_BIT
+};
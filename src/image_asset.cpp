@@ -0,0 +1,42 @@
+#include "image_asset.h"
+
+static bool fail(ImageAssetInfo* out, const char** error, const char* reason)
+{
+    out->frames = nullptr;
+    out->frameCount = 0;
+    out->frameDelayMs = 0;
+    if (error) {
+        *error = reason;
+    }
+    return false;
+}
+
+bool image_asset_parse(const uint8_t* data, size_t size, ImageAssetInfo* out, const char** error)
+{
+    if (!data) {
+        return fail(out, error, "no data");
+    }
+    if (size < IMAGE_ASSET_HEADER_SIZE) {
+        return fail(out, error, "truncated header");
+    }
+    uint16_t frameCount = (uint16_t)((data[0] << 8) | data[1]);
+    if (frameCount == 0) {
+        return fail(out, error, "zero frame count");
+    }
+    // 帧数不能超出负载，否则播放会读出数组之外；多余的尾部数据同样视为格式错误
+    size_t payload = size - IMAGE_ASSET_HEADER_SIZE;
+    if (payload != (size_t)frameCount * IMAGE_ASSET_FRAME_SIZE) {
+        return fail(out, error, "payload length does not match frame count");
+    }
+    // 延迟0无法按帧率播放；1-255ms 均有效，短于线上时长的由 AnimSystem::setFrameDelay 钳位
+    if (data[2] == 0) {
+        return fail(out, error, "zero frame delay");
+    }
+    out->frames = data + IMAGE_ASSET_HEADER_SIZE;
+    out->frameCount = frameCount;
+    out->frameDelayMs = data[2];
+    if (error) {
+        *error = nullptr;
+    }
+    return true;
+}
@@ -0,0 +1,214 @@
+#include "layer_compositor.hpp"
+#include <string.h>
+
+static const uint32_t LANE_LO = 0x00FF00FFu;
+static const uint32_t LANE_MSB = 0x80808080u;
+
+static inline uint32_t load32(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline void store32(uint8_t* p, uint32_t v)
+{
+    memcpy(p, &v, 4);
+}
+
+// 4个通道同乘 alpha/256（alpha 0..256），奇偶字节分两组在16位槽内相乘，互不进位
+static inline uint32_t swar_scale(uint32_t x, uint32_t alpha)
+{
+    uint32_t even = ((x & LANE_LO) * alpha >> 8) & LANE_LO;
+    uint32_t odd = (((x >> 8) & LANE_LO) * alpha) & ~LANE_LO;
+    return even | odd;
+}
+
+// 逐字节饱和相加
+static inline uint32_t swar_add_sat(uint32_t a, uint32_t b)
+{
+    uint32_t sum = ((a & ~LANE_MSB) + (b & ~LANE_MSB)) ^ ((a ^ b) & LANE_MSB);
+    uint32_t carry = ((a & b) | ((a | b) & ~sum)) & LANE_MSB;
+    return sum | ((carry << 1) - (carry >> 7));
+}
+
+// 逐字节饱和相减 a-b
+static inline uint32_t swar_sub_sat(uint32_t a, uint32_t b)
+{
+    uint32_t diff = ((a | LANE_MSB) - (b & ~LANE_MSB)) ^ ((a ^ ~b) & LANE_MSB);
+    uint32_t borrow = ((~a & b) | ((~a | b) & diff)) & LANE_MSB;
+    return diff & ~((borrow << 1) - (borrow >> 7));
+}
+
+static inline uint8_t scale8(uint8_t x, uint32_t alpha)
+{
+    return (uint8_t)((x * alpha) >> 8);
+}
+
+static inline uint8_t blend_byte(uint8_t a, uint8_t b, LayerBlendMode mode, uint32_t alpha)
+{
+    switch (mode) {
+    case LAYER_ADD: {
+        uint32_t v = a + scale8(b, alpha);
+        return v > 255 ? 255 : (uint8_t)v;
+    }
+    case LAYER_MAX: {
+        uint8_t s = scale8(b, alpha);
+        return s > a ? s : a;
+    }
+    case LAYER_MULTIPLY: {
+        // 乘数按不透明度从255（不变）过渡到层值
+        uint32_t m = 255 - scale8(255 - b, alpha);
+        return (uint8_t)((a * m + 127) / 255);
+    }
+    default:  // ALPHA
+        return (uint8_t)(scale8(a, 256 - alpha) + scale8(b, alpha));
+    }
+}
+
+void layer_blend(uint8_t* dst, const uint8_t* src, int len, LayerBlendMode mode, uint8_t opacity)
+{
+    if (opacity == 0) {
+        return;
+    }
+    // 不透明度 0..255 映射到 alpha 0..256，255 时恰为1.0
+    uint32_t alpha = opacity + (opacity >> 7);
+    if (mode == LAYER_REPLACE) {
+        // 透明与否按像素（3字节）判断，与4字节分组不对齐，逐像素处理
+        for (int i = 0; i + 2 < len; i += 3) {
+            if (src[i] | src[i + 1] | src[i + 2]) {
+                for (int c = i; c < i + 3; ++c) {
+                    dst[c] = alpha == 256 ? src[c] : blend_byte(dst[c], src[c], LAYER_ALPHA, alpha);
+                }
+            }
+        }
+        return;
+    }
+    if (alpha == 256 && mode == LAYER_ALPHA) {
+        memcpy(dst, src, len);
+        return;
+    }
+
+    int i = 0;
+    switch (mode) {
+    case LAYER_ADD:
+        for (; i + 4 <= len; i += 4) {
+            uint32_t b = alpha == 256 ? load32(src + i) : swar_scale(load32(src + i), alpha);
+            store32(dst + i, swar_add_sat(load32(dst + i), b));
+        }
+        break;
+    case LAYER_MAX:
+        for (; i + 4 <= len; i += 4) {
+            uint32_t a = load32(dst + i);
+            uint32_t b = alpha == 256 ? load32(src + i) : swar_scale(load32(src + i), alpha);
+            // max(a,b) = a + sat(b-a)，各通道结果不超过255，不会跨通道进位
+            store32(dst + i, a + swar_sub_sat(b, a));
+        }
+        break;
+    case LAYER_MULTIPLY:
+        // 各通道乘数不同，无法共用一次32位乘法，逐字节处理
+        break;
+    default:  // ALPHA
+        for (; i + 4 <= len; i += 4) {
+            uint32_t a = load32(dst + i);
+            uint32_t b = load32(src + i);
+            store32(dst + i, swar_scale(a, 256 - alpha) + swar_scale(b, alpha));
+        }
+        break;
+    }
+    for (; i < len; ++i) {
+        dst[i] = blend_byte(dst[i], src[i], mode, alpha);
+    }
+}
+
+void LayerCompositor::init(uint8_t* const* buffers, int frameSize, RenderFn render, void* ctx)
+{
+    for (int i = 0; i < LAYER_MAX_COUNT; ++i) {
+        pixels_[i] = buffers[i];
+        layers_[i] = Layer();
+    }
+    frameSize_ = frameSize;
+    render_ = render;
+    ctx_ = ctx;
+}
+
+int LayerCompositor::add(AnimEffect* effect, LayerBlendMode mode, uint8_t opacity)
+{
+    if (!effect) {
+        return -1;
+    }
+    for (int i = 0; i < LAYER_MAX_COUNT; ++i) {
+        if (!layers_[i].effect && pixels_[i]) {
+            layers_[i] = Layer();
+            layers_[i].effect = effect;
+            layers_[i].mode = mode;
+            layers_[i].opacity = opacity;
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool LayerCompositor::remove(int id)
+{
+    if (id < 0 || id >= LAYER_MAX_COUNT || !layers_[id].effect) {
+        return false;
+    }
+    layers_[id] = Layer();
+    return true;
+}
+
+bool LayerCompositor::setOpacity(int id, uint8_t opacity)
+{
+    if (id < 0 || id >= LAYER_MAX_COUNT || !layers_[id].effect) {
+        return false;
+    }
+    layers_[id].opacity = opacity;
+    return true;
+}
+
+bool LayerCompositor::setMode(int id, LayerBlendMode mode)
+{
+    if (id < 0 || id >= LAYER_MAX_COUNT || !layers_[id].effect) {
+        return false;
+    }
+    layers_[id].mode = mode;
+    return true;
+}
+
+bool LayerCompositor::active() const
+{
+    for (int i = 0; i < LAYER_MAX_COUNT; ++i) {
+        if (layers_[i].effect && layers_[i].opacity) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void LayerCompositor::composite(uint8_t* frame, uint64_t nowUs)
+{
+    for (int i = 0; i < LAYER_MAX_COUNT; ++i) {
+        Layer& layer = layers_[i];
+        if (!layer.effect || layer.opacity == 0) {
+            continue;
+        }
+        // 只在层自身的下一帧到期时重新渲染；静态层只渲染一次
+        int count = layer.effect->getFrameCount();
+        int delayMs = layer.effect->getFrameDelay();
+        uint32_t periodUs = (uint32_t)(delayMs > 0 ? delayMs : 1) * 1000;
+        if (!layer.rendered) {
+            layer.frame = 0;
+            layer.nextFrameUs = nowUs + periodUs;
+            layer.rendered = true;
+            render_(ctx_, layer.effect, layer.frame, pixels_[i]);
+        } else if (count > 1 && nowUs >= layer.nextFrameUs) {
+            // 错过的层帧直接跳过，保持层自身时间线
+            uint64_t steps = (nowUs - layer.nextFrameUs) / periodUs + 1;
+            layer.frame = (int)((layer.frame + steps) % count);
+            layer.nextFrameUs += steps * periodUs;
+            render_(ctx_, layer.effect, layer.frame, pixels_[i]);
+        }
+        layer_blend(frame, pixels_[i], frameSize_, layer.mode, layer.opacity);
+    }
+}
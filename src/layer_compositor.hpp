@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include "anim_effect.hpp"
+
+// 叠加层上限（每层占帧池一帧）
+#define LAYER_MAX_COUNT 3
+
+// 叠加层混合方式（opacity 为层不透明度 0..255）
+enum LayerBlendMode {
+    LAYER_REPLACE,   // 层中非黑像素按不透明度覆盖下层，黑色像素视为透明
+    LAYER_ADD,       // 饱和相加
+    LAYER_MULTIPLY,  // 相乘（调暗/染色）
+    LAYER_ALPHA,     // 整帧按不透明度插值
+    LAYER_MAX,       // 逐通道取大
+};
+
+// 把 src 按 mode/opacity 混合到 dst（len 字节，逐通道）；4字节一组做32位SWAR运算
+void layer_blend(uint8_t* dst, const uint8_t* src, int len, LayerBlendMode mode, uint8_t opacity);
+
+// 图层合成：当前效果作为底层，叠加层按添加顺序自下而上合成；
+// 每层按自身帧间隔推进，未到下一帧的层沿用已渲染的帧，不透明度为0的层跳过
+class LayerCompositor {
+public:
+    // 渲染层帧（链序）的回调
+    typedef void (*RenderFn)(void* ctx, AnimEffect* effect, int index, uint8_t* dst);
+
+    // buffers 为 LAYER_MAX_COUNT 块帧缓冲（由调用方持有）
+    void init(uint8_t* const* buffers, int frameSize, RenderFn render, void* ctx);
+
+    // 添加层，返回层号；已满时返回-1
+    int add(AnimEffect* effect, LayerBlendMode mode, uint8_t opacity);
+    bool remove(int id);
+    bool setOpacity(int id, uint8_t opacity);
+    bool setMode(int id, LayerBlendMode mode);
+    // 是否有需要合成的层
+    bool active() const;
+
+    // 推进到期的层并把所有可见层合成到 frame（链序，原地修改）
+    void composite(uint8_t* frame, uint64_t nowUs);
+
+private:
+    struct Layer {
+        AnimEffect* effect;
+        LayerBlendMode mode;
+        uint8_t opacity;
+        int frame;
+        uint64_t nextFrameUs;
+        bool rendered;
+    };
+
+    Layer layers_[LAYER_MAX_COUNT] = {};
+    uint8_t* pixels_[LAYER_MAX_COUNT] = {nullptr, nullptr, nullptr};
+    int frameSize_ = 0;
+    RenderFn render_ = nullptr;
+    void* ctx_ = nullptr;
+};
@@ -11,10 +11,12 @@
 #include <IRutils.h>
 #include <driver/rmt.h>
 #include <soc/rmt_reg.h>
+#include "panel_config.h"
 #include "sid_rmt_sender.h"
 #include "images.h"
 #include "anim_system.hpp"
 #include "anim_effect.hpp"
+#include "color_temperature.h"
 #include "gradient_rgb_pattern.h"
 
 
@@ -23,7 +25,6 @@
 
 
 
-#define SID_MAX_CHIPS 36
 #define IR_RECV_PIN 26
 #define BUTTON_PIN 33
 #define LED_PIN    0
@@ -35,6 +36,10 @@
 #define SERIAL_CMD_DD 0xdd      // 设置动态场景
 #define SERIAL_CMD_A2 0xa2      // 查询灯运行状态
 #define SERIAL_CMD_A0 0xa0      // 设置灯亮度、色温、DUV值
+#define SERIAL_CMD_A3 0xa3      // 设置/查询颜色校准矩阵
+#define SERIAL_CMD_A4 0xa4      // 设置/查询面板描述符（尺寸、链序映射表、输出通道）
+#define SERIAL_CMD_A5 0xa5      // 设置/查询驱动时序档
+#define SERIAL_CMD_A6 0xa6      // 查询功率状态（估算电流、预算、限流缩放）
 #define SERIAL_MAX_DATA_LEN 64
 #define SERIAL_BUFFER_SIZE 128
 
@@ -62,11 +67,27 @@ uint8_t calculatedChecksum = 0;
 unsigned long lastSerialReceiveTime = 0;
 const unsigned long SERIAL_TIMEOUT_MS = 1000; // 1秒超时
 
+// 0xA4 面板描述符分段写入的暂存区：开始时分配，提交或重新开始时释放
+#define PANEL_CMD_BEGIN    0x01
+#define PANEL_CMD_ORDER    0x02
+#define PANEL_CMD_CHANNELS 0x03
+#define PANEL_CMD_COMMIT   0x04
+#define PANEL_ORDER_MAX_PER_FRAME 30  // 每帧最多30个映射项（2+2*30 < 数据上限）
+struct PanelStaging {
+  uint16_t width;
+  uint16_t height;
+  uint16_t* order;        // 为空表示未写映射表，按行优先直连
+  PanelChannel channels[PANEL_MAX_CHANNELS];
+  uint8_t channelCount;   // 为0表示未写通道划分，单通道输出
+};
+PanelStaging panelStaging = {0, 0, nullptr, {}, 0};
+
 // 函数声明
 void setLedMode(int mode);
 void switchAnimationEffect();
 void handleSerialCommand();
 void sendSerialResponse(uint8_t cmd, uint8_t* data, uint8_t length);
+bool handlePanelCommand(const uint8_t* data, uint8_t length);
 void handleIRCode(uint32_t code);
 void setLightPower(bool power, uint8_t brightness);  // 开关屏接口函数
 
@@ -105,7 +126,6 @@ const int MAX_ANIM_EFFECTS = 11;  // 增加了6个动画效果（包括新的烛
 uint8_t currentColorTemp = 1;    // 当前色温索引 (1-61)
 uint8_t currentDuvIndex = 3;     // 当前DUV索引 (1-5)
 uint8_t currentScene = 0;        // 当前场景 (0-30)
-bool lightPower = true;         // 灯开关状态
 bool colorTempMode = false;      // 是否处于色温模式
 
 // 声明外部变量，供sid_rmt_sender.cpp使用
@@ -166,7 +186,8 @@ void processSerialData(uint8_t data) {
       break;
       
     case WAIT_CMD:
-      if (data == SERIAL_CMD_D7 || data == SERIAL_CMD_DA || data == SERIAL_CMD_DD || data == SERIAL_CMD_A2 || data == SERIAL_CMD_A0) {
+      if (data == SERIAL_CMD_D7 || data == SERIAL_CMD_DA || data == SERIAL_CMD_DD || data == SERIAL_CMD_A2 || data == SERIAL_CMD_A0 ||
+          data == SERIAL_CMD_A3 || data == SERIAL_CMD_A4 || data == SERIAL_CMD_A5 || data == SERIAL_CMD_A6) {
         serialBuffer[1] = data;
         serialBufferIndex = 2;
         calculatedChecksum += data;
@@ -183,7 +204,8 @@ void processSerialData(uint8_t data) {
         serialBuffer[2] = data;
         serialBufferIndex = 3;
         calculatedChecksum += data;
-        serialState = WAIT_DATA;
+        // 无数据的命令（如查询）直接等待校验和
+        serialState = (data == 0) ? WAIT_CHECKSUM : WAIT_DATA;
       } else {
         // 数据长度无效，重置状态机
         serialState = WAIT_HEADER;
@@ -258,7 +280,7 @@ void handleSerialCommand() {
       /* serial log removed */
       if (length >= 1) {
         uint8_t ct = serialBuffer[3];
-        if (ct >= 1 && ct <= 61) {
+        if (ColorTemperatureManager::isValidStep(ct, 1)) {
           currentColorTemp = ct;
           colorTempMode = true; // 进入色温模式
           lightPower = true;    // 确保灯是打开的          
@@ -339,15 +361,20 @@ void handleSerialCommand() {
       // 处理0xA2命令 - 查询灯运行状态
       /* serial log removed */
       
-      // 发送状态响应
+      // 发送状态响应：前5字节与旧版本一致，之后为估算电流
+      uint32_t currentMa = sid_power_estimate_ma();
       uint8_t status[] = {
         static_cast<uint8_t>(lightPower ? 0x01 : 0x00),  // 开关状态
         get_brightness(),                    // 当前亮度
         currentColorTemp,                    // 当前色温
         currentScene,                        // 当前场景
-        static_cast<uint8_t>(colorTempMode ? 0xFF : currentAnimEffect)  // 当前模式/动画效果
+        static_cast<uint8_t>(colorTempMode ? 0xFF : currentAnimEffect),  // 当前模式/动画效果
+        static_cast<uint8_t>(currentMa >> 24),  // 估算电流（mA），高字节在前
+        static_cast<uint8_t>(currentMa >> 16),
+        static_cast<uint8_t>(currentMa >> 8),
+        static_cast<uint8_t>(currentMa)
       };
-      sendSerialResponse(SERIAL_CMD_A2, status, 5);
+      sendSerialResponse(SERIAL_CMD_A2, status, sizeof(status));
       break;
     }
     
@@ -367,7 +394,7 @@ void handleSerialCommand() {
         uint16_t brightness = (brightnessHigh << 8) | brightnessLow;
         
         // 验证参数范围
-        if (brightness <= 1000 && colorTemp >= 1 && colorTemp <= 61 && duvValue >= 0x01 && duvValue <= 0x05) {
+        if (brightness <= 1000 && ColorTemperatureManager::isValidStep(colorTemp, duvValue)) {
           // 设置亮度（转换为0-100范围）
           uint8_t brightnessPercent = (brightness * 100) / 1000;
           if (brightnessPercent > 100) brightnessPercent = 100;
@@ -412,6 +439,102 @@ void handleSerialCommand() {
       }
       break;
     }
+
+    case SERIAL_CMD_A3: {
+      // 处理0xA3命令 - 颜色校准矩阵：长度0为查询，长度24为设置并保存
+      if (length == 0) {
+        ColorCalib calib;
+        uint8_t data[COLOR_CALIB_WIRE_SIZE];
+        sid_calib_get(&calib);
+        color_calib_encode(&calib, data);
+        sendSerialResponse(SERIAL_CMD_A3, data, COLOR_CALIB_WIRE_SIZE);
+      } else if (length == COLOR_CALIB_WIRE_SIZE) {
+        ColorCalib calib;
+        color_calib_decode(&serialBuffer[3], &calib);
+        if (sid_calib_set(&calib, true)) {
+          Serial.printf("Color calibration %s\n", color_calib_is_identity(&calib) ? "cleared" : "updated");
+          uint8_t response[] = {0xA3};
+          sendSerialResponse(SERIAL_CMD_A3, response, 1);
+        } else {
+          Serial.println("0xA3 command: invalid calibration or save failed");
+          uint8_t response[] = {0xFF}; // 0xFF表示参数错误或保存失败
+          sendSerialResponse(SERIAL_CMD_A3, response, 1);
+        }
+      } else {
+        Serial.println("0xA3 command: invalid data length");
+        uint8_t response[] = {0xFF}; // 0xFF表示数据长度错误
+        sendSerialResponse(SERIAL_CMD_A3, response, 1);
+      }
+      break;
+    }
+
+    case SERIAL_CMD_A4: {
+      // 处理0xA4命令 - 面板描述符：长度0为查询，否则按首字节子命令分段写入，提交后重启生效
+      if (length == 0) {
+        const PanelDescriptor& panel = panel_get();
+        uint8_t data[7 + PANEL_MAX_CHANNELS * 3];
+        uint8_t n = 0;
+        data[n++] = panel.width >> 8;
+        data[n++] = panel.width & 0xFF;
+        data[n++] = panel.height >> 8;
+        data[n++] = panel.height & 0xFF;
+        data[n++] = panel.chipCount >> 8;
+        data[n++] = panel.chipCount & 0xFF;
+        data[n++] = panel.channelCount;
+        for (int c = 0; c < panel.channelCount; ++c) {
+          data[n++] = panel.channels[c].chipCount >> 8;
+          data[n++] = panel.channels[c].chipCount & 0xFF;
+          data[n++] = panel.channels[c].gpio;
+        }
+        sendSerialResponse(SERIAL_CMD_A4, data, n);
+      } else {
+        uint8_t response[] = {0xA4};
+        if (!handlePanelCommand(&serialBuffer[3], length)) {
+          response[0] = 0xFF; // 0xFF表示参数错误、未开始写入或保存失败
+        }
+        sendSerialResponse(SERIAL_CMD_A4, response, 1);
+      }
+      break;
+    }
+
+    case SERIAL_CMD_A5: {
+      // 处理0xA5命令 - 驱动时序档：长度0为查询，长度1为切换并保存（0=标准，1=SID最小安全）
+      if (length == 0) {
+        uint8_t response[] = {sid_rmt_get_timing_profile_id()};
+        sendSerialResponse(SERIAL_CMD_A5, response, 1);
+      } else if (length == 1 && sid_rmt_select_timing_profile(serialBuffer[3], true)) {
+        Serial.printf("SID timing profile: %s, max %lu fps\n", sid_rmt_get_timing_profile().name,
+                      (unsigned long)sid_rmt_current_max_fps());
+        uint8_t response[] = {0xA5};
+        sendSerialResponse(SERIAL_CMD_A5, response, 1);
+      } else {
+        Serial.println("0xA5 command: invalid profile or save failed");
+        uint8_t response[] = {0xFF}; // 0xFF表示档位无效、长度错误或保存失败
+        sendSerialResponse(SERIAL_CMD_A5, response, 1);
+      }
+      break;
+    }
+
+    case SERIAL_CMD_A6: {
+      // 处理0xA6命令 - 查询功率状态：估算电流(4) + 预算(4) + 限流缩放Q12(2)，高字节在前
+      if (length == 0) {
+        uint32_t currentMa = sid_power_estimate_ma();
+        uint32_t budgetMa = sid_power_get_budget_ma();
+        uint16_t scale = sid_power_scale_q12();
+        uint8_t response[] = {
+          static_cast<uint8_t>(currentMa >> 24), static_cast<uint8_t>(currentMa >> 16),
+          static_cast<uint8_t>(currentMa >> 8), static_cast<uint8_t>(currentMa),
+          static_cast<uint8_t>(budgetMa >> 24), static_cast<uint8_t>(budgetMa >> 16),
+          static_cast<uint8_t>(budgetMa >> 8), static_cast<uint8_t>(budgetMa),
+          static_cast<uint8_t>(scale >> 8), static_cast<uint8_t>(scale)
+        };
+        sendSerialResponse(SERIAL_CMD_A6, response, sizeof(response));
+      } else {
+        uint8_t response[] = {0xFF}; // 0xFF表示长度错误
+        sendSerialResponse(SERIAL_CMD_A6, response, 1);
+      }
+      break;
+    }
       
     default:
               Serial.println("Unknown command");
@@ -426,6 +549,70 @@ void handleSerialCommand() {
       Serial.println("");
 }
 
+// 0xA4 子命令：开始(宽高) / 映射表分段(起始下标+若干项) / 通道划分 / 提交保存
+bool handlePanelCommand(const uint8_t* data, uint8_t length) {
+  switch (data[0]) {
+    case PANEL_CMD_BEGIN: {
+      if (length != 5) return false;
+      uint16_t width = (data[1] << 8) | data[2];
+      uint16_t height = (data[3] << 8) | data[4];
+      uint32_t count = (uint32_t)width * height;
+      if (width == 0 || height == 0 || count > PANEL_MAX_CHIPS) return false;
+      free(panelStaging.order);
+      panelStaging.order = nullptr;
+      panelStaging.width = width;
+      panelStaging.height = height;
+      panelStaging.channelCount = 0;
+      Serial.printf("Panel staging: %ux%u\n", width, height);
+      return true;
+    }
+    case PANEL_CMD_ORDER: {
+      uint32_t count = (uint32_t)panelStaging.width * panelStaging.height;
+      if (count == 0 || length < 5 || (length - 3) % 2 != 0) return false;
+      uint16_t offset = (data[1] << 8) | data[2];
+      int entries = (length - 3) / 2;
+      if (entries > PANEL_ORDER_MAX_PER_FRAME || offset + entries > count) return false;
+      if (!panelStaging.order) {
+        // 未写到的项保持0xFFFF，提交时校验不通过
+        panelStaging.order = (uint16_t*)malloc(count * sizeof(uint16_t));
+        if (!panelStaging.order) return false;
+        memset(panelStaging.order, 0xFF, count * sizeof(uint16_t));
+      }
+      for (int i = 0; i < entries; ++i) {
+        panelStaging.order[offset + i] = (data[3 + i * 2] << 8) | data[4 + i * 2];
+      }
+      return true;
+    }
+    case PANEL_CMD_CHANNELS: {
+      if (panelStaging.width == 0 || length < 2) return false;
+      uint8_t count = data[1];
+      if (count < 1 || count > PANEL_MAX_CHANNELS || length != 2 + count * 3) return false;
+      for (int c = 0; c < count; ++c) {
+        panelStaging.channels[c].chipCount = (data[2 + c * 3] << 8) | data[3 + c * 3];
+        panelStaging.channels[c].gpio = data[4 + c * 3];
+      }
+      panelStaging.channelCount = count;
+      return true;
+    }
+    case PANEL_CMD_COMMIT: {
+      if (panelStaging.width == 0 || length != 1) return false;
+      bool ok = panel_save(panelStaging.width, panelStaging.height, panelStaging.order,
+                           panelStaging.channelCount ? panelStaging.channels : nullptr,
+                           panelStaging.channelCount);
+      Serial.printf("Panel descriptor %ux%u %s, restart to apply\n", panelStaging.width, panelStaging.height,
+                    ok ? "saved" : "rejected");
+      free(panelStaging.order);
+      panelStaging.order = nullptr;
+      panelStaging.width = 0;
+      panelStaging.height = 0;
+      panelStaging.channelCount = 0;
+      return ok;
+    }
+    default:
+      return false;
+  }
+}
+
 // 发送串口响应
 void sendSerialResponse(uint8_t cmd, uint8_t* data, uint8_t length) {
   uint8_t checksum = 0x06 + cmd + length;  // 响应帧头为0x06
@@ -665,6 +852,7 @@ void TaskSerialComm(void* pvParameters) {
 int colorTemp=1;
 void setup() {
   Serial.begin(115200); 
+  panel_load();  // 面板描述须在发送器和动画系统之前加载
   sid_rmt_init();
   pinMode(BUTTON_PIN, INPUT_PULLUP);
   pinMode(LED_PIN, OUTPUT);
@@ -675,6 +863,14 @@ void setup() {
   
   // 初始化动画系统
   animSystem.init();
+  animSystem.setAsyncSendEnabled(true);  // 编码下一帧与当前帧线上传输重叠
+  // 动画素材头校验（帧数与数组长度不符的素材只会播放黑帧）
+  ImageDataEffect* assets[] = {&imageDataEffect, &czcxEffect, &jl3Effect, &lt2Effect, &lt3Effect};
+  for (ImageDataEffect* asset : assets) {
+    if (!asset->isValid()) {
+      debug_printf("Image asset invalid: %s\n", asset->getError());
+    }
+  }
   
   // 初始化默认状态
   currentColorTemp = 1;
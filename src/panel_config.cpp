@@ -0,0 +1,212 @@
+#include "panel_config.h"
+#include "sid_rmt_sender.h"
+#include <Preferences.h>
+#include <string.h>
+
+static const char* PANEL_NVS_NAMESPACE = "panel";
+
+// 默认6x6面板的走线顺序
+static const uint16_t DEFAULT_CHAIN_ORDER[PANEL_DEFAULT_WIDTH * PANEL_DEFAULT_HEIGHT] = {
+    0x0C, 0x06, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x0B, 0x11, 0x0D, 0x07,
+    0x08, 0x09, 0x0E, 0x0F, 0x0A, 0x10, 0x17, 0x1D, 0x23, 0x22, 0x21, 0x20,
+    0x1F, 0x1E, 0x18, 0x12, 0x16, 0x1C, 0x1B, 0x1A, 0x15, 0x14, 0x19, 0x13
+};
+
+static PanelDescriptor s_panel;
+
+// 尺寸合法且映射表是 0..count-1 的一个排列
+static bool panel_validate(uint16_t width, uint16_t height, const uint16_t* order)
+{
+    uint32_t count = (uint32_t)width * height;
+    if (width == 0 || height == 0 || count > PANEL_MAX_CHIPS) {
+        return false;
+    }
+    if (!order) {
+        return true;
+    }
+    uint8_t seen[PANEL_MAX_CHIPS / 8];
+    memset(seen, 0, sizeof(seen));
+    for (uint32_t i = 0; i < count; ++i) {
+        uint16_t idx = order[i];
+        if (idx >= count || (seen[idx >> 3] & (1 << (idx & 7)))) {
+            return false;
+        }
+        seen[idx >> 3] |= (1 << (idx & 7));
+    }
+    return true;
+}
+
+// 可作灯链输出的空闲引脚（白名单）。已排除：
+// 0（状态LED，兼启动模式）、26（红外接收）、33（按键）、1/3（UART0串口）、
+// 2/5/12/15（启动配置引脚）、6-11（接Flash）、20/24/28-31（芯片无此引脚）、34以上（仅输入）
+static const uint64_t PANEL_OUTPUT_GPIO_MASK =
+    (1ULL << 4) | (1ULL << 13) | (1ULL << 14) | (1ULL << 16) | (1ULL << 17) |
+    (1ULL << 18) | (1ULL << 19) | (1ULL << 21) | (1ULL << 22) | (1ULL << 23) |
+    (1ULL << 25) | (1ULL << 27) | (1ULL << 32);
+
+static bool panel_gpio_valid(uint8_t gpio)
+{
+    return gpio < 64 && (PANEL_OUTPUT_GPIO_MASK & (1ULL << gpio)) != 0;
+}
+
+// 通道数 1..PANEL_MAX_CHANNELS，子链非空且总长等于链长，引脚合法且互不相同
+static bool panel_validate_channels(uint32_t chipCount, const PanelChannel* channels, int count)
+{
+    if (count < 1 || count > PANEL_MAX_CHANNELS) {
+        return false;
+    }
+    uint32_t total = 0;
+    for (int c = 0; c < count; ++c) {
+        if (channels[c].chipCount == 0 || !panel_gpio_valid(channels[c].gpio)) {
+            return false;
+        }
+        for (int k = 0; k < c; ++k) {
+            if (channels[k].gpio == channels[c].gpio) {
+                return false;
+            }
+        }
+        total += channels[c].chipCount;
+    }
+    return total == chipCount;
+}
+
+static void panel_apply_single_channel(void)
+{
+    s_panel.channelCount = 1;
+    s_panel.channels[0].chipCount = s_panel.chipCount;
+    s_panel.channels[0].gpio = PANEL_DEFAULT_GPIO;
+}
+
+static void panel_apply(uint16_t width, uint16_t height, const uint16_t* order)
+{
+    s_panel.width = width;
+    s_panel.height = height;
+    s_panel.chipCount = width * height;
+    for (uint16_t i = 0; i < s_panel.chipCount; ++i) {
+        s_panel.chainOrder[i] = order ? order[i] : i;
+    }
+    panel_apply_single_channel();
+}
+
+static void panel_apply_default(void)
+{
+    panel_apply(PANEL_DEFAULT_WIDTH, PANEL_DEFAULT_HEIGHT, DEFAULT_CHAIN_ORDER);
+}
+
+bool panel_load(void)
+{
+    panel_apply_default();
+
+    Preferences prefs;
+    if (!prefs.begin(PANEL_NVS_NAMESPACE, true)) {
+        debug_println("Panel: no stored descriptor, using default 6x6");
+        return false;
+    }
+    uint16_t width = prefs.getUShort("w", 0);
+    uint16_t height = prefs.getUShort("h", 0);
+    uint32_t count = (uint32_t)width * height;
+    bool ok = false;
+    if (count > 0 && count <= PANEL_MAX_CHIPS) {
+        size_t orderBytes = prefs.getBytesLength("order");
+        if (orderBytes == 0) {
+            // 未存映射表：行优先直连
+            panel_apply(width, height, nullptr);
+            ok = true;
+        } else if (orderBytes == count * sizeof(uint16_t)) {
+            // 直接读入描述符，校验失败再回退默认
+            prefs.getBytes("order", s_panel.chainOrder, orderBytes);
+            ok = panel_validate(width, height, s_panel.chainOrder);
+            if (ok) {
+                s_panel.width = width;
+                s_panel.height = height;
+                s_panel.chipCount = (uint16_t)count;
+                panel_apply_single_channel();
+            } else {
+                panel_apply_default();
+            }
+        }
+    }
+    if (ok) {
+        // 通道划分无效时保留面板，退回单通道输出
+        PanelChannel channels[PANEL_MAX_CHANNELS];
+        size_t chBytes = prefs.getBytesLength("ch");
+        if (chBytes > 0 && chBytes <= sizeof(channels) && chBytes % sizeof(PanelChannel) == 0) {
+            prefs.getBytes("ch", channels, chBytes);
+            int chCount = (int)(chBytes / sizeof(PanelChannel));
+            if (panel_validate_channels(count, channels, chCount)) {
+                memcpy(s_panel.channels, channels, chBytes);
+                s_panel.channelCount = (uint8_t)chCount;
+            } else {
+                debug_println("Panel: stored channel layout invalid, using single channel");
+            }
+        }
+    }
+    prefs.end();
+
+    if (!ok) {
+        debug_println("Panel: stored descriptor invalid, using default 6x6");
+        return false;
+    }
+    debug_printf("Panel loaded: %ux%u, %u chips, %u channel(s)\n",
+                 s_panel.width, s_panel.height, s_panel.chipCount, s_panel.channelCount);
+    return true;
+}
+
+bool panel_save(uint16_t width, uint16_t height, const uint16_t* order,
+                const PanelChannel* channels, int channelCount)
+{
+    if (!panel_validate(width, height, order) ||
+        (channels && !panel_validate_channels((uint32_t)width * height, channels, channelCount))) {
+        debug_println("Panel: invalid descriptor, not saved");
+        return false;
+    }
+    Preferences prefs;
+    if (!prefs.begin(PANEL_NVS_NAMESPACE, false)) {
+        return false;
+    }
+    size_t orderBytes = (size_t)width * height * sizeof(uint16_t);
+    bool ok = prefs.putUShort("w", width) == sizeof(uint16_t) &&
+              prefs.putUShort("h", height) == sizeof(uint16_t);
+    if (ok) {
+        if (order) {
+            ok = prefs.putBytes("order", order, orderBytes) == orderBytes;
+        } else {
+            prefs.remove("order");
+        }
+    }
+    if (ok) {
+        if (channels) {
+            size_t chBytes = channelCount * sizeof(PanelChannel);
+            ok = prefs.putBytes("ch", channels, chBytes) == chBytes;
+        } else {
+            prefs.remove("ch");
+        }
+    }
+    prefs.end();
+    return ok;
+}
+
+const PanelDescriptor& panel_get(void)
+{
+    return s_panel;
+}
+
+int panel_width(void)
+{
+    return s_panel.width;
+}
+
+int panel_height(void)
+{
+    return s_panel.height;
+}
+
+int panel_chip_count(void)
+{
+    return s_panel.chipCount;
+}
+
+int panel_frame_size(void)
+{
+    return s_panel.chipCount * 3;
+}
@@ -0,0 +1,63 @@
+#include "power_budget.h"
+
+void power_budget_init(PowerBudget* pb, uint32_t budgetMa)
+{
+    pb->uaPerCode[0] = pb->uaPerCode[1] = pb->uaPerCode[2] = POWER_UA_PER_CODE_DEFAULT;
+    pb->budgetMa = budgetMa;
+    pb->scaleQ12 = POWER_SCALE_ONE;
+    pb->estimateMa = 0;
+}
+
+void power_accumulate(const uint8_t* rgb, int chips, uint32_t sums[3])
+{
+    uint32_t r = 0, g = 0, b = 0;
+    for (int i = 0; i < chips; ++i, rgb += 3) {
+        r += rgb[0];
+        g += rgb[1];
+        b += rgb[2];
+    }
+    sums[0] += r;
+    sums[1] += g;
+    sums[2] += b;
+}
+
+uint32_t power_estimate_ma(const PowerBudget* pb, const uint32_t sums[3])
+{
+    uint64_t ua = (uint64_t)sums[0] * pb->uaPerCode[0] +
+                  (uint64_t)sums[1] * pb->uaPerCode[1] +
+                  (uint64_t)sums[2] * pb->uaPerCode[2];
+    return (uint32_t)((ua + 500) / 1000);
+}
+
+uint32_t power_budget_update(PowerBudget* pb, const uint32_t sums[3])
+{
+    uint32_t est = power_estimate_ma(pb, sums);
+    pb->estimateMa = est;
+
+    // 估算值已含当前缩放：超出预算时按比例收紧到预算；低于回差下限时朝下限放开，
+    // 两者之间保持不动，避免码值取整在预算附近来回跳；全黑帧不含负载信息，保持当前缩放
+    uint32_t target = pb->scaleQ12;
+    if (pb->budgetMa == 0) {
+        target = POWER_SCALE_ONE;
+    } else if (est > pb->budgetMa) {
+        target = (uint32_t)((uint64_t)pb->scaleQ12 * pb->budgetMa / est);
+    } else if (est > 0) {
+        uint32_t low = pb->budgetMa - (pb->budgetMa >> POWER_HYSTERESIS_SHIFT);
+        if (est < low) {
+            uint64_t t = (uint64_t)pb->scaleQ12 * low / est;
+            target = t < POWER_SCALE_ONE ? (uint32_t)t : POWER_SCALE_ONE;
+        }
+    }
+    if (target < 1) {
+        target = 1;
+    }
+
+    uint32_t s = pb->scaleQ12;
+    if (target < s) {
+        s -= (s - target + (1u << POWER_ATTACK_SHIFT) - 1) >> POWER_ATTACK_SHIFT;
+    } else if (target > s) {
+        s += (target - s + (1u << POWER_RELEASE_SHIFT) - 1) >> POWER_RELEASE_SHIFT;
+    }
+    pb->scaleQ12 = s;
+    return s;
+}
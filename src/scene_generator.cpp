@@ -1,6 +1,7 @@
 #include "scene_manager.h"
 #include <Arduino.h>
 #include "sid_rmt_sender.h"
+#include "panel_config.h"
 
 
 
@@ -13,15 +14,15 @@ class SceneGenerator {
 public:
     static void generateBreathingScene(SceneManager& sceneManager, uint8_t sceneId, 
                                       uint8_t r, uint8_t g, uint8_t b, uint8_t frameCount = 30) {
-        uint8_t* rgbData = (uint8_t*)malloc(108 * frameCount);
+        uint8_t* rgbData = (uint8_t*)malloc(panel_frame_size() * frameCount);
         if (!rgbData) return;
         
         for (int frame = 0; frame < frameCount; frame++) {
             float brightness = (sin(frame * 2 * PI / frameCount) + 1) / 2.0f;
             uint8_t intensity = (uint8_t)(brightness * 255);
             
-            for (int led = 0; led < 36; led++) {
-                int baseIndex = frame * 108 + led * 3;
+            for (int led = 0; led < panel_chip_count(); led++) {
+                int baseIndex = frame * panel_frame_size() + led * 3;
                 rgbData[baseIndex + 0] = (uint8_t)(r * intensity / 255.0f);
                 rgbData[baseIndex + 1] = (uint8_t)(g * intensity / 255.0f);
                 rgbData[baseIndex + 2] = (uint8_t)(b * intensity / 255.0f);
@@ -33,14 +34,14 @@ public:
     }
     
     static void generateRainbowScene(SceneManager& sceneManager, uint8_t sceneId, uint8_t frameCount = 60) {
-        uint8_t* rgbData = (uint8_t*)malloc(108 * frameCount);
+        uint8_t* rgbData = (uint8_t*)malloc(panel_frame_size() * frameCount);
         if (!rgbData) return;
         
         for (int frame = 0; frame < frameCount; frame++) {
             float hue = (float)frame / frameCount * 360.0f;
             
-            for (int led = 0; led < 36; led++) {
-                int baseIndex = frame * 108 + led * 3;
+            for (int led = 0; led < panel_chip_count(); led++) {
+                int baseIndex = frame * panel_frame_size() + led * 3;
                 
                 // HSV转RGB
                 float h = hue + (led * 10.0f);
@@ -78,14 +79,14 @@ public:
     
     static void generateBlinkScene(SceneManager& sceneManager, uint8_t sceneId, 
                                   uint8_t r, uint8_t g, uint8_t b, uint8_t frameCount = 20) {
-        uint8_t* rgbData = (uint8_t*)malloc(108 * frameCount);
+        uint8_t* rgbData = (uint8_t*)malloc(panel_frame_size() * frameCount);
         if (!rgbData) return;
         
         for (int frame = 0; frame < frameCount; frame++) {
             bool isOn = (frame < frameCount / 2);
             
-            for (int led = 0; led < 36; led++) {
-                int baseIndex = frame * 108 + led * 3;
+            for (int led = 0; led < panel_chip_count(); led++) {
+                int baseIndex = frame * panel_frame_size() + led * 3;
                 if (isOn) {
                     rgbData[baseIndex + 0] = r;
                     rgbData[baseIndex + 1] = g;
@@ -105,14 +106,14 @@ public:
     static void generateGradientScene(SceneManager& sceneManager, uint8_t sceneId,
                                      uint8_t r1, uint8_t g1, uint8_t b1,
                                      uint8_t r2, uint8_t g2, uint8_t b2, uint8_t frameCount = 40) {
-        uint8_t* rgbData = (uint8_t*)malloc(108 * frameCount);
+        uint8_t* rgbData = (uint8_t*)malloc(panel_frame_size() * frameCount);
         if (!rgbData) return;
         
         for (int frame = 0; frame < frameCount; frame++) {
             float progress = (float)frame / (frameCount - 1);
             
-            for (int led = 0; led < 36; led++) {
-                int baseIndex = frame * 108 + led * 3;
+            for (int led = 0; led < panel_chip_count(); led++) {
+                int baseIndex = frame * panel_frame_size() + led * 3;
                 rgbData[baseIndex + 0] = (uint8_t)(r1 + (r2 - r1) * progress);
                 rgbData[baseIndex + 1] = (uint8_t)(g1 + (g2 - g1) * progress);
                 rgbData[baseIndex + 2] = (uint8_t)(b1 + (b2 - b1) * progress);
@@ -125,9 +126,9 @@ public:
     
     static void generateStaticScene(SceneManager& sceneManager, uint8_t sceneId,
                                    uint8_t r, uint8_t g, uint8_t b) {
-        uint8_t* rgbData = (uint8_t*)malloc(108);
+        uint8_t* rgbData = (uint8_t*)malloc(panel_frame_size());
         if (!rgbData) return;        
-        for (int led = 0; led < 36; led++) {
+        for (int led = 0; led < panel_chip_count(); led++) {
             int baseIndex = led * 3;
             rgbData[baseIndex + 0] = r;
             rgbData[baseIndex + 1] = g;
@@ -139,7 +140,7 @@ public:
     // 从头文件数据创建场景
     static void createSceneFromData(SceneManager& sceneManager, uint8_t sceneId,
                                    const uint8_t* headerData, uint8_t frameCount, uint8_t frameDelayMs) {
-        size_t dataSize = 108 * frameCount;
+        size_t dataSize = panel_frame_size() * frameCount;
         uint8_t* rgbData = (uint8_t*)malloc(dataSize);
         if (!rgbData) return;
         
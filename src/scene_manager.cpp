@@ -3,13 +3,13 @@
 #include <Arduino.h>
 #include "esp_log.h"
 #include <cstring>
+#include "panel_config.h"
 
 static const char* TAG = "SceneManager";
 
 // 私有实现类
 class SceneManager::SceneManagerImpl {
 public:
-    static const size_t FRAME_SIZE = 108;  // 6x6x3 = 108字节每帧
     static const size_t MAX_FRAMES = 255;  // 最大帧数
     static const size_t MAX_SCENES = 30;   // 最大场景数
     
@@ -29,6 +29,7 @@ public:
         
         initialized_ = true;
         ESP_LOGI(TAG, "SPIFFS初始化成功");
+        checkPanelSignature();
         ESP_LOGI(TAG, "总空间: %d bytes", getTotalSpace());
         ESP_LOGI(TAG, "可用空间: %d bytes", getFreeSpace());
         
@@ -69,8 +70,13 @@ public:
             return false;
         }
         
-        // 计算数据大小
-        size_t dataSize = FRAME_SIZE * frameCount;
+        // 计算数据大小（每帧大小由当前面板决定）
+        size_t dataSize = panel_frame_size() * frameCount;
+        if (file.size() != 2 + dataSize) {
+            ESP_LOGE(TAG, "场景文件大小与面板不匹配: %d != %d", (int)file.size(), (int)(2 + dataSize));
+            file.close();
+            return false;
+        }
         
         // 分配内存
         sceneData.rgbData = (uint8_t*)malloc(dataSize);
@@ -117,7 +123,7 @@ public:
         snprintf(filename, sizeof(filename), "/scene_%02d.dat", sceneId);
         
         // 计算文件大小
-        size_t fileSize = 2 + (FRAME_SIZE * frameCount);
+        size_t fileSize = 2 + (panel_frame_size() * frameCount);
         
         // 检查可用空间
         if (getFreeSpace() < fileSize) {
@@ -141,7 +147,7 @@ public:
         }
         
         // 写入RGB数据
-        size_t dataSize = FRAME_SIZE * frameCount;
+        size_t dataSize = panel_frame_size() * frameCount;
         if (file.write(rgbData, dataSize) != dataSize) {
             ESP_LOGE(TAG, "写入RGB数据失败");
             file.close();
@@ -257,13 +263,15 @@ public:
         for (uint8_t i = 0; i < 5; i++) {
             if (!sceneExists(i)) {
                 // 生成简单的测试场景
-                uint8_t* testData = (uint8_t*)malloc(FRAME_SIZE * 20);
+                const int chips = panel_chip_count();
+                const size_t frameSize = panel_frame_size();
+                uint8_t* testData = (uint8_t*)malloc(frameSize * 20);
                 if (testData) {
                     // 生成简单的渐变场景
                     for (int frame = 0; frame < 20; frame++) {
                         uint8_t intensity = (frame * 255) / 20;
-                        for (int led = 0; led < 36; led++) {
-                            int baseIndex = frame * 108 + led * 3;
+                        for (int led = 0; led < chips; led++) {
+                            int baseIndex = frame * frameSize + led * 3;
                             testData[baseIndex + 0] = intensity;     // R
                             testData[baseIndex + 1] = 255 - intensity; // G
                             testData[baseIndex + 2] = 128;           // B
@@ -294,6 +302,43 @@ public:
     }
     
 private:
+    // 场景文件按矩阵序、当前面板尺寸存帧；面板尺寸与写入时不同则旧文件帧长不符，全部清除
+    void checkPanelSignature() {
+        static const char* SIGNATURE_FILE = "/panel.sig";
+        uint8_t current[4] = {
+            (uint8_t)(panel_width() >> 8), (uint8_t)panel_width(),
+            (uint8_t)(panel_height() >> 8), (uint8_t)panel_height()
+        };
+        // 无签名文件：场景由支持面板描述符之前的固件写入，按默认6x6面板对待
+        uint8_t stored[4] = {0, PANEL_DEFAULT_WIDTH, 0, PANEL_DEFAULT_HEIGHT};
+        bool match = memcmp(stored, current, sizeof(current)) == 0;
+        if (SPIFFS.exists(SIGNATURE_FILE)) {
+            File file = SPIFFS.open(SIGNATURE_FILE, "r");
+            if (file) {
+                match = file.read(stored, sizeof(stored)) == sizeof(stored) &&
+                        memcmp(stored, current, sizeof(current)) == 0;
+                file.close();
+            }
+        }
+        if (match) {
+            if (!SPIFFS.exists(SIGNATURE_FILE)) {
+                writePanelSignature(SIGNATURE_FILE, current);
+            }
+            return;
+        }
+        ESP_LOGW(TAG, "面板尺寸变化（%dx%d），清除旧场景文件", panel_width(), panel_height());
+        clearAllScenes();
+        writePanelSignature(SIGNATURE_FILE, current);
+    }
+
+    void writePanelSignature(const char* path, const uint8_t signature[4]) {
+        File file = SPIFFS.open(path, "w");
+        if (file) {
+            file.write(signature, 4);
+            file.close();
+        }
+    }
+
     bool initialized_;
 };
 
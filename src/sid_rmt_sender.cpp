@@ -1,4 +1,10 @@
 #include "sid_rmt_sender.h"
+#include "panel_config.h"
+#include "brightness_ramp.h"
+#include "color_calib.h"
+#include "power_budget.h"
+#include <esp_timer.h>
+#include <Preferences.h>
 #include <stdarg.h>
 
 // 串口打印接口函数实现
@@ -77,547 +83,477 @@ extern "C" {
 #include "soc/rmt_reg.h"
 }
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include <Arduino.h>
-extern bool lightPower;
+// 灯开关状态：亮度斜坡到0时由发送路径置为false
+bool lightPower = true;
 // 全局亮度变量（当前应用值）
 uint8_t global_brightness = 50; // 默认100%亮度
 static uint8_t target_brightness = 50;  // 目标亮度
-static uint8_t fade_frames = 0;         // 特殊淡入/淡出剩余帧数
+// 亮度斜坡：调用方设定后立即返回，发送路径每帧按当前时刻取值
+static BrightnessRamp s_brightness_ramp = {50 << 8, 50 << 8, {0, 0, EASE_LINEAR}, false, 0};
+static portMUX_TYPE s_brightness_mux = portMUX_INITIALIZER_UNLOCKED;
+// 灯具颜色校准：串口任务写入，发送路径每帧复制一次
+#define SID_CALIB_NVS_NAMESPACE "calib"
+#define SID_TIMING_NVS_NAMESPACE "sid_timing"
+static ColorCalib s_calib;
+static bool s_calib_identity = true;
+static portMUX_TYPE s_calib_mux = portMUX_INITIALIZER_UNLOCKED;
+// 功率预算：发送路径每帧估算电流并推进全局缩放，配置与查询经 s_power_mux
+static PowerBudget s_power = {{POWER_UA_PER_CODE_DEFAULT, POWER_UA_PER_CODE_DEFAULT, POWER_UA_PER_CODE_DEFAULT},
+                              SID_POWER_BUDGET_MA, POWER_SCALE_ONE, 0};
+static portMUX_TYPE s_power_mux = portMUX_INITIALIZER_UNLOCKED;
 // 色温模式变量
 extern uint8_t currentColorTemp;
 extern bool colorTempMode; // 是否处于色温模式
 
 // 来自动画系统的亮度冻结状态（由动画系统维护）
 extern bool g_anim_brightnessFreezeActive;
-extern uint8_t g_anim_frozenBrightness;
-
-// 色温RGB查表数据 (305行，每5行为一组DUV变体)
-static const uint8_t COLOR_TEMP_TABLE[305][3] = {
-    // 色温1的5种DUV变体
-    {180, 16, 3},   // DUV=0.006
-    {181, 13, 6},   // DUV=0.003
-    {182, 10, 9},   // DUV=0
-    {182, 7, 12},   // DUV=-0.003
-    {183, 3, 14},   // DUV=-0.006
-    // 色温2的5种DUV变体
-    {172, 26, 3},   // DUV=0.006
-    {173, 21, 7},   // DUV=0.003
-    {173, 16, 11},  // DUV=0
-    {175, 11, 15},  // DUV=-0.003
-    {175, 6, 19},   // DUV=-0.006
-    // 色温3的5种DUV变体
-    {163, 35, 2},   // DUV=0.006
-    {164, 30, 6},   // DUV=0.003
-    {165, 24, 10},  // DUV=0
-    {166, 19, 15},  // DUV=-0.003
-    {168, 14, 19},  // DUV=-0.006
-    // 色温4的5种DUV变体
-    {155, 42, 3},   // DUV=0.006
-    {156, 36, 7},   // DUV=0.003
-    {158, 31, 12},  // DUV=0
-    {159, 25, 16},  // DUV=-0.003
-    {160, 20, 20},  // DUV=-0.006
-    // 色温5的5种DUV变体
-    {147, 50, 3},   // DUV=0.006
-    {149, 44, 7},   // DUV=0.003
-    {150, 38, 12},  // DUV=0
-    {152, 32, 16},  // DUV=-0.003
-    {153, 27, 20},  // DUV=-0.006
-    // 色温6的5种DUV变体
-    {140, 58, 3},   // DUV=0.006
-    {141, 52, 7},   // DUV=0.003
-    {143, 45, 12},  // DUV=0
-    {145, 39, 16},  // DUV=-0.003
-    {146, 33, 21},  // DUV=-0.006
-    // 色温7的5种DUV变体
-    {132, 65, 3},   // DUV=0.006
-    {134, 58, 7},   // DUV=0.003
-    {136, 52, 12},  // DUV=0
-    {138, 46, 17},  // DUV=-0.003
-    {139, 39, 21},  // DUV=-0.006
-    // 色温8的5种DUV变体
-    {125, 72, 3},   // DUV=0.006
-    {127, 65, 8},   // DUV=0.003
-    {129, 58, 13},  // DUV=0
-    {131, 52, 17},  // DUV=-0.003
-    {133, 45, 22},  // DUV=-0.006
-    // 色温9的5种DUV变体
-    {118, 80, 2},   // DUV=0.006
-    {120, 73, 7},   // DUV=0.003
-    {122, 66, 12},  // DUV=0
-    {125, 59, 16},  // DUV=-0.003
-    {127, 52, 21},  // DUV=-0.006
-    // 色温10的5种DUV变体
-    {111, 86, 2},   // DUV=0.006
-    {114, 79, 7},   // DUV=0.003
-    {116, 71, 12},  // DUV=0
-    {119, 64, 17},  // DUV=-0.003
-    {121, 57, 22},  // DUV=-0.006
-    // 色温11的5种DUV变体
-    {105, 92, 3},   // DUV=0.006
-    {108, 84, 8},   // DUV=0.003
-    {110, 77, 13},  // DUV=0
-    {113, 69, 18},  // DUV=-0.003
-    {116, 62, 23},  // DUV=-0.006
-    // 色温12的5种DUV变体
-    {98, 100, 2},   // DUV=0.006
-    {101, 92, 7},   // DUV=0.003
-    {104, 84, 12},  // DUV=0
-    {107, 76, 17},  // DUV=-0.003
-    {109, 69, 22},  // DUV=-0.006
-    // 色温13的5种DUV变体
-    {93, 102, 5},   // DUV=0.006
-    {96, 94, 10},   // DUV=0.003
-    {99, 86, 15},   // DUV=0
-    {102, 78, 20},  // DUV=-0.003
-    {105, 70, 25},  // DUV=-0.006
-    // 色温14的5种DUV变体
-    {89, 103, 8},   // DUV=0.006
-    {92, 95, 13},   // DUV=0.003
-    {95, 87, 18},   // DUV=0
-    {98, 79, 23},   // DUV=-0.003
-    {101, 72, 27},  // DUV=-0.006
-    // 色温15的5种DUV变体
-    {85, 105, 11},  // DUV=0.006
-    {88, 97, 16},   // DUV=0.003
-    {91, 89, 21},   // DUV=0
-    {94, 80, 25},   // DUV=-0.003
-    {97, 73, 30},   // DUV=-0.006
-    // 色温16的5种DUV变体
-    {81, 106, 14},  // DUV=0.006
-    {84, 97, 19},   // DUV=0.003
-    {87, 89, 23},   // DUV=0
-    {91, 81, 28},   // DUV=-0.003
-    {94, 73, 33},   // DUV=-0.006
-    // 色温17的5种DUV变体
-    {77, 107, 16},  // DUV=0.006
-    {81, 98, 21},   // DUV=0.003
-    {84, 90, 26},   // DUV=0
-    {88, 82, 31},   // DUV=-0.003
-    {91, 74, 36},   // DUV=-0.006
-    // 色温18的5种DUV变体
-    {74, 107, 19},  // DUV=0.006
-    {77, 98, 24},   // DUV=0.003
-    {81, 90, 29},   // DUV=0
-    {85, 82, 34},   // DUV=-0.003
-    {88, 74, 38},   // DUV=-0.006
-    // 色温19的5种DUV变体
-    {70, 107, 22},  // DUV=0.006
-    {74, 99, 27},   // DUV=0.003
-    {78, 90, 32},   // DUV=0
-    {82, 82, 37},   // DUV=-0.003
-    {85, 74, 41},   // DUV=-0.006
-    // 色温20的5种DUV变体
-    {67, 107, 26},  // DUV=0.006
-    {71, 98, 30},   // DUV=0.003
-    {75, 90, 35},   // DUV=0
-    {79, 82, 39},   // DUV=-0.003
-    {83, 73, 44},   // DUV=-0.006
-    // 色温21的5种DUV变体
-    {65, 107, 29},  // DUV=0.006
-    {69, 98, 33},   // DUV=0.003
-    {73, 90, 38},   // DUV=0
-    {77, 81, 42},   // DUV=-0.003
-    {80, 73, 47},   // DUV=-0.006
-    // 色温22的5种DUV变体
-    {62, 107, 32},  // DUV=0.006
-    {66, 98, 36},   // DUV=0.003
-    {70, 89, 41},   // DUV=0
-    {74, 81, 45},   // DUV=-0.003
-    {78, 73, 49},   // DUV=-0.006
-    // 色温23的5种DUV变体
-    {60, 106, 35},  // DUV=0.006
-    {64, 97, 39},   // DUV=0.003
-    {68, 88, 43},   // DUV=0
-    {72, 80, 48},   // DUV=-0.003
-    {76, 72, 52},   // DUV=-0.006
-    // 色温24的5种DUV变体
-    {57, 105, 38},  // DUV=0.006
-    {62, 96, 42},   // DUV=0.003
-    {66, 88, 46},   // DUV=0
-    {70, 79, 50},   // DUV=-0.003
-    {75, 71, 55},   // DUV=-0.006
-    // 色温25的5种DUV变体
-    {55, 104, 40},  // DUV=0.006
-    {60, 95, 45},   // DUV=0.003
-    {64, 87, 49},   // DUV=0
-    {69, 78, 53},   // DUV=-0.003
-    {73, 70, 57},   // DUV=-0.006
-    // 色温26的5种DUV变体
-    {53, 103, 43},  // DUV=0.006
-    {58, 95, 48},   // DUV=0.003
-    {63, 86, 52},   // DUV=0
-    {67, 78, 56},   // DUV=-0.003
-    {71, 69, 60},   // DUV=-0.006
-    // 色温27的5种DUV变体
-    {52, 102, 46},  // DUV=0.006
-    {56, 93, 50},   // DUV=0.003
-    {61, 85, 54},   // DUV=0
-    {65, 76, 58},   // DUV=-0.003
-    {70, 68, 62},   // DUV=-0.006
-    // 色温28的5种DUV变体
-    {50, 101, 49},  // DUV=0.006
-    {55, 92, 53},   // DUV=0.003
-    {59, 84, 57},   // DUV=0
-    {64, 75, 61},   // DUV=-0.003
-    {68, 67, 64},   // DUV=-0.006
-    // 色温29的5种DUV变体
-    {48, 100, 52},  // DUV=0.006
-    {53, 91, 56},   // DUV=0.003
-    {58, 83, 59},   // DUV=0
-    {63, 74, 63},   // DUV=-0.003
-    {67, 66, 67},   // DUV=-0.006
-    // 色温30的5种DUV变体
-    {47, 99, 54},   // DUV=0.006
-    {52, 90, 58},   // DUV=0.003
-    {57, 81, 62},   // DUV=0
-    {61, 73, 66},   // DUV=-0.003
-    {66, 65, 69},   // DUV=-0.006
-    // 色温31的5种DUV变体
-    {46, 97, 57},   // DUV=0.006
-    {51, 89, 61},   // DUV=0.003
-    {56, 80, 64},   // DUV=0
-    {60, 72, 68},   // DUV=-0.003
-    {65, 64, 71},   // DUV=-0.006
-    // 色温32的5种DUV变体
-    {44, 96, 60},   // DUV=0.006
-    {49, 87, 63},   // DUV=0.003
-    {54, 79, 67},   // DUV=0
-    {59, 71, 70},   // DUV=-0.003
-    {64, 63, 74},   // DUV=-0.006
-    // 色温33的5种DUV变体
-    {43, 95, 62},   // DUV=0.006
-    {48, 86, 66},   // DUV=0.003
-    {53, 78, 69},   // DUV=0
-    {58, 70, 72},   // DUV=-0.003
-    {63, 62, 76},   // DUV=-0.006
-    // 色温34的5种DUV变体
-    {42, 93, 65},   // DUV=0.006
-    {47, 85, 68},   // DUV=0.003
-    {52, 76, 71},   // DUV=0
-    {57, 68, 75},   // DUV=-0.003
-    {62, 60, 78},   // DUV=-0.006
-    // 色温35的5种DUV变体
-    {41, 92, 67},   // DUV=0.006
-    {46, 83, 70},   // DUV=0.003
-    {52, 75, 74},   // DUV=0
-    {56, 67, 77},   // DUV=-0.003
-    {61, 59, 80},   // DUV=-0.006
-    // 色温36的5种DUV变体
-    {40, 91, 69},   // DUV=0.006
-    {45, 82, 73},   // DUV=0.003
-    {51, 74, 76},   // DUV=0
-    {56, 66, 79},   // DUV=-0.003
-    {60, 58, 82},   // DUV=-0.006
-    // 色温37的5种DUV变体
-    {39, 89, 72},   // DUV=0.006
-    {45, 80, 75},   // DUV=0.003
-    {50, 72, 78},   // DUV=0
-    {55, 64, 81},   // DUV=-0.003
-    {60, 57, 84},   // DUV=-0.006
-    // 色温38的5种DUV变体
-    {39, 87, 74},   // DUV=0.006
-    {44, 79, 77},   // DUV=0.003
-    {49, 71, 80},   // DUV=0
-    {54, 63, 83},   // DUV=-0.003
-    {59, 55, 86},   // DUV=-0.006
-    // 色温39的5种DUV变体
-    {38, 86, 76},   // DUV=0.006
-    {43, 78, 79},   // DUV=0.003
-    {49, 70, 82},   // DUV=0
-    {54, 62, 85},   // DUV=-0.003
-    {59, 54, 87},   // DUV=-0.006
-    // 色温40的5种DUV变体
-    {37, 85, 78},   // DUV=0.006
-    {43, 76, 81},   // DUV=0.003
-    {48, 68, 84},   // DUV=0
-    {53, 60, 87},   // DUV=-0.003
-    {58, 53, 89},   // DUV=-0.006
-    // 色温41的5种DUV变体
-    {36, 83, 80},   // DUV=0.006
-    {42, 75, 83},   // DUV=0.003
-    {47, 67, 86},   // DUV=0
-    {52, 59, 88},   // DUV=-0.003
-    {57, 52, 91},   // DUV=-0.006
-    // 色温42的5种DUV变体
-    {36, 82, 82},   // DUV=0.006
-    {41, 74, 85},   // DUV=0.003
-    {47, 66, 88},   // DUV=0
-    {52, 58, 90},   // DUV=-0.003
-    {57, 50, 93},   // DUV=-0.006
-    // 色温43的5种DUV变体
-    {35, 80, 84},   // DUV=0.006
-    {41, 72, 87},   // DUV=0.003
-    {46, 64, 90},   // DUV=0
-    {51, 57, 92},   // DUV=-0.003
-    {57, 49, 94},   // DUV=-0.006
-    // 色温44的5种DUV变体
-    {35, 79, 86},   // DUV=0.006
-    {40, 71, 89},   // DUV=0.003
-    {46, 63, 91},   // DUV=0
-    {51, 55, 94},   // DUV=-0.003
-    {56, 48, 96},   // DUV=-0.006
-    // 色温45的5种DUV变体
-    {34, 77, 88},   // DUV=0.006
-    {40, 69, 91},   // DUV=0.003
-    {45, 62, 93},   // DUV=0
-    {51, 54, 95},   // DUV=-0.003
-    {56, 47, 98},   // DUV=-0.006
-    // 色温46的5种DUV变体
-    {34, 76, 90},   // DUV=0.006
-    {40, 68, 92},   // DUV=0.003
-    {45, 60, 95},   // DUV=0
-    {50, 53, 97},   // DUV=-0.003
-    {55, 46, 99},   // DUV=-0.006
-    // 色温47的5种DUV变体
-    {34, 75, 92},   // DUV=0.006
-    {39, 67, 94},   // DUV=0.003
-    {45, 59, 96},   // DUV=0
-    {50, 52, 98},   // DUV=-0.003
-    {55, 44, 101},  // DUV=-0.006
-    // 色温48的5种DUV变体
-    {33, 73, 94},   // DUV=0.006
-    {39, 66, 96},   // DUV=0.003
-    {44, 58, 98},   // DUV=0
-    {50, 50, 100},  // DUV=-0.003
-    {55, 43, 102},  // DUV=-0.006
-    // 色温49的5种DUV变体
-    {33, 72, 95},   // DUV=0.006
-    {39, 64, 97},   // DUV=0.003
-    {44, 57, 99},   // DUV=0
-    {49, 49, 102},  // DUV=-0.003
-    {54, 42, 103},  // DUV=-0.006
-    // 色温50的5种DUV变体
-    {32, 71, 97},   // DUV=0.006
-    {38, 63, 99},   // DUV=0.003
-    {44, 55, 101},  // DUV=0
-    {49, 48, 103},  // DUV=-0.003
-    {54, 41, 105},  // DUV=-0.006
-    // 色温51的5种DUV变体
-    {31, 64, 104},  // DUV=0.006
-    {37, 57, 106},  // DUV=0.003
-    {43, 50, 108},  // DUV=0
-    {48, 43, 110},  // DUV=-0.003
-    {53, 36, 111},  // DUV=-0.006
-    // 色温52的5种DUV变体
-    {30, 59, 111},  // DUV=0.006
-    {36, 51, 113},  // DUV=0.003
-    {42, 44, 114},  // DUV=0
-    {47, 38, 116},  // DUV=-0.003
-    {52, 31, 117},  // DUV=-0.006
-    // 色温53的5种DUV变体
-    {30, 53, 117},  // DUV=0.006
-    {35, 46, 118},  // DUV=0.003
-    {41, 39, 120},  // DUV=0
-    {47, 33, 121},  // DUV=-0.003
-    {52, 26, 122},  // DUV=-0.006
-    // 色温54的5种DUV变体
-    {29, 48, 122},  // DUV=0.006
-    {35, 42, 123},  // DUV=0.003
-    {41, 35, 124},  // DUV=0
-    {46, 28, 125},  // DUV=-0.003
-    {52, 22, 126},  // DUV=-0.006
-    // 色温55的5种DUV变体
-    {29, 44, 127},  // DUV=0.006
-    {35, 37, 128},  // DUV=0.003
-    {41, 31, 129},  // DUV=0
-    {46, 25, 130},  // DUV=-0.003
-    {51, 18, 130},  // DUV=-0.006
-    // 色温56的5种DUV变体
-    {29, 40, 131},  // DUV=0.006
-    {35, 33, 132},  // DUV=0.003
-    {41, 27, 132},  // DUV=0
-    {46, 21, 134},  // DUV=-0.003
-    {51, 15, 134},  // DUV=-0.006
-    // 色温57的5种DUV变体
-    {29, 36, 135},  // DUV=0.006
-    {35, 30, 135},  // DUV=0.003
-    {40, 24, 136},  // DUV=0
-    {46, 18, 136},  // DUV=-0.003
-    {51, 12, 137},  // DUV=-0.006
-    // 色温58的5种DUV变体
-    {29, 33, 138},  // DUV=0.006
-    {35, 27, 139},  // DUV=0.003
-    {41, 21, 139},  // DUV=0
-    {46, 15, 139},  // DUV=-0.003
-    {51, 9, 140},   // DUV=-0.006
-    // 色温59的5种DUV变体
-    {29, 30, 141},  // DUV=0.006
-    {35, 24, 142},  // DUV=0.003
-    {41, 18, 142},  // DUV=0
-    {46, 12, 142},  // DUV=-0.003
-    {51, 6, 142},   // DUV=-0.006
-    // 色温60的5种DUV变体
-    {30, 27, 144},  // DUV=0.006
-    {35, 21, 144},  // DUV=0.003
-    {41, 15, 144},  // DUV=0
-    {46, 9, 145},   // DUV=-0.003
-    {51, 4, 145},   // DUV=-0.006
-    // 色温61的5种DUV变体
-    {29, 24, 146},  // DUV=0.006
-    {35, 18, 146},  // DUV=0.003
-    {41, 13, 146},  // DUV=0
-    {46, 7, 147},   // DUV=-0.003
-    {51, 2, 147}    // DUV=-0.006
+
+
+#define SID_RMT_FIRST_CHANNEL RMT_CHANNEL_1  // 面板通道c使用 RMT_CHANNEL_1+c
+#define RMT_CLK_DIV 1
+#define RMT_TICKS_PER_US (80 / RMT_CLK_DIV)   // APB 80MHz
+#define T0H_TICKS  23
+#define T0L_TICKS  73
+#define T1H_TICKS  72
+#define T1L_TICKS  24
+#define RESET_TICKS 16320
+#define SID_HEAD_LOW_TICKS (RESET_TICKS + 300)  // 标准档帧头Reset总低电平时长
+#define SID_TAIL_LOW_TICKS (RESET_TICKS + 100)  // 标准档帧尾Reset总低电平时长
+#define SID_MIN_HEAD_LOW_TICKS 160              // 最小档帧头：仅作起始间隔
+#define SID_RESET_FIELDS_MAX 32767              // 单个duration字段上限（15位）
+#define SID_ITEMS_PER_BYTE 8
+#define SID_BITS_PER_CHIP 24
+#define SID_BIT_TICKS (T0H_TICKS + T0L_TICKS)  // 与 T1H+T1L 相等
+#define SID_GAIN_BYTES 2
+#define SID_STREAM_EXTRA_BYTES (SID_GAIN_BYTES + 1)  // 增益 + 末尾1字节帧尾哨兵
+
+// rmt_item32_t 整字编码：duration0 | level0<<15 | duration1<<16 | level1<<31
+#define SID_ITEM_WORD(level0, dur0, level1, dur1) \
+    ((uint32_t)(dur0) | ((uint32_t)(level0) << 15) | ((uint32_t)(dur1) << 16) | ((uint32_t)(level1) << 31))
+
+// bit0/bit1 预计算item字，按位值直接索引，避免逐字段写入和分支
+static DRAM_ATTR const uint32_t SID_BIT_WORDS[2] = {
+    SID_ITEM_WORD(1, T0H_TICKS, 0, T0L_TICKS),
+    SID_ITEM_WORD(1, T1H_TICKS, 0, T1L_TICKS)
+};
+// 帧头Reset拆成8个全低电平item（波形不变），占一个字节的item槽位，
+// 使translator每块输出都是8的整数倍，恰好填满驱动要求的块长
+static DRAM_ATTR uint32_t s_head_reset_words[SID_ITEMS_PER_BYTE];
+static DRAM_ATTR uint32_t s_tail_reset_word;
+
+// 标准档：沿用原有帧头/帧尾时长
+const SidTimingProfile SID_TIMING_STANDARD = {"standard", SID_HEAD_LOW_TICKS, SID_TAIL_LOW_TICKS};
+// SID最小安全档：帧尾保持原锁存时长，帧头只留短间隔。相邻两帧之间的低电平
+// 仍不短于 RESET_TICKS（上一帧帧尾 + 本帧帧头），空闲后首帧前线路本就为低
+const SidTimingProfile SID_TIMING_SID_MIN_SAFE = {"sid-min", SID_MIN_HEAD_LOW_TICKS, RESET_TICKS};
+static SidTimingProfile s_timing = SID_TIMING_STANDARD;
+// 内置时序档，下标即协议与NVS中的档位编号
+static const SidTimingProfile* const SID_TIMING_PROFILES[SID_TIMING_PROFILE_COUNT] = {
+    &SID_TIMING_STANDARD,
+    &SID_TIMING_SID_MIN_SAFE
+};
+
+// 输出通道：每个通道驱动链上连续一段子链，各自带帧头/增益/帧尾，多通道同时发送
+struct SidChannel {
+    rmt_channel_t channel;
+    int chipStart;                         // 子链首芯片在整条链上的序号
+    int chipCount;
+    uint8_t* wire[2];                      // 线序字节流：子链RGB + 16位增益（高字节在前）+ 帧尾哨兵，两块轮流使用
+    const uint8_t* volatile streamBegin;   // 当前帧起点，translator据此插入帧头
+    SemaphoreHandle_t txDone;              // TX-end回调释放，表示通道空闲
 };
+static SidChannel s_channels[PANEL_MAX_CHANNELS];
+static int s_channel_count = 0;
+static bool s_async_enabled = false;
+static int s_wire_index = 0;
 
-// DUV偏移值表
-static const float DUV_OFFSETS[5] = {0.006f, 0.003f, 0.0f, -0.003f, -0.006f};
+// 重复帧抑制：线序帧哈希与上次发送一致且逐字节相同时跳过，每 keepalive 周期强制重发保持芯片状态
+static uint32_t s_keepalive_ms = 1000;      // 0 表示关闭抑制，每帧都发
+static uint32_t s_last_frame_hash = 0;
+static int s_last_sizes[PANEL_MAX_CHANNELS];  // 上次发送的各通道字节数
+static uint32_t s_last_send_ms = 0;
+static bool s_has_last_frame = false;
+static uint32_t s_frames_sent = 0;
+static uint32_t s_frames_skipped = 0;
 
-// 色温索引到RGB值的转换函数 (查表版本)
-void getColorTempRGB(uint8_t tempIndex, uint8_t* r, uint8_t* g, uint8_t* b) {
-    // 参数检查
-    if (tempIndex < 1 || tempIndex > 61 || !r || !g || !b) {
-        *r = *g = *b = 0;
+// RMT发送完成回调（ISR上下文）
+static void IRAM_ATTR sid_rmt_tx_end_cb(rmt_channel_t channel, void* arg)
+{
+    int idx = (int)channel - (int)SID_RMT_FIRST_CHANNEL;
+    if (idx < 0 || idx >= s_channel_count || !s_channels[idx].txDone) {
         return;
     }
-    
-    // 默认使用标准DUV (DUV=0，即第3个变体)
-    uint8_t duvIndex = 3; // DUV=0对应的索引
-    
-    // 计算表格索引：每个色温有5个DUV变体
-    uint16_t tableIndex = (tempIndex - 1) * 5 + duvIndex-1;
-    
-    // 查表获取RGB值
-    *r = COLOR_TEMP_TABLE[tableIndex][0];
-    *g = COLOR_TEMP_TABLE[tableIndex][1];
-    *b = COLOR_TEMP_TABLE[tableIndex][2];
-    
-    // Serial.printf("Color temp %d (DUV=%.3f): R=%d G=%d B=%d\n", 
-    //               tempIndex, DUV_OFFSETS[duvIndex], *r, *g, *b);
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(s_channels[idx].txDone, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
 }
 
-// 带DUV参数的色温RGB转换函数
-void getColorTempRGBWithDuv(uint8_t tempIndex, uint8_t duvIndex, uint8_t* r, uint8_t* g, uint8_t* b) {
-    // 参数检查 (DUV索引1-5)
-    if (tempIndex < 1 || tempIndex > 61 || duvIndex < 1 || duvIndex > 5 || !r || !g || !b) {
-        *r = *g = *b = 0;
-        return;
+// MSB优先展开 nbits 位；芯片色数据与16位增益共用此路径
+static inline rmt_item32_t* encode_sid_bits(uint32_t value, int nbits, rmt_item32_t* out)
+{
+    for (int bit = nbits - 1; bit >= 0; --bit) {
+        (out++)->val = SID_BIT_WORDS[(value >> bit) & 1U];
     }
-    
-    uint16_t tableIndex = (tempIndex - 1) * 5 + (duvIndex - 1);
-    
-    // 查表获取RGB值
-    *r = COLOR_TEMP_TABLE[tableIndex][0];
-    *g = COLOR_TEMP_TABLE[tableIndex][1];
-    *b = COLOR_TEMP_TABLE[tableIndex][2];
-    
-    // Serial.printf("Color temp %d (DUV=%.3f): R=%d G=%d B=%d\n", 
-    //               tempIndex, DUV_OFFSETS[duvIndex - 1], *r, *g, *b);
+    return out;
+}
+
+// 把总低电平时长均分到 count 个item的全部duration字段
+static void fill_low_words(uint32_t ticks, uint32_t* words, int count)
+{
+    uint32_t part = ticks / (2 * count);
+    uint32_t last = ticks - part * (2 * count - 1);
+    for (int i = 0; i < count - 1; ++i) {
+        words[i] = SID_ITEM_WORD(0, part, 0, part);
+    }
+    words[count - 1] = SID_ITEM_WORD(0, part, 0, last);
+}
+
+// RMT translator：随RMT内存块耗尽被驱动分块调用，把线序字节展开为item。
+// 非末块必须恰好输出 wanted_num 个item，否则驱动会提前结束传输；
+// 因此帧尾Reset由流末尾的哨兵字节承载，总落在末块。各通道共用，按帧起点识别首块
+static void IRAM_ATTR sid_sample_to_rmt(const void* src, rmt_item32_t* dest, size_t src_size,
+                                        size_t wanted_num, size_t* translated_size, size_t* item_num)
+{
+    const uint8_t* p = (const uint8_t*)src;
+    rmt_item32_t* out = dest;
+    size_t slots = wanted_num / SID_ITEMS_PER_BYTE;
+    bool stream_head = false;
+    for (int c = 0; c < s_channel_count; ++c) {
+        if (p == s_channels[c].streamBegin) {
+            stream_head = true;
+            break;
+        }
+    }
+    if (stream_head && slots > 0) {
+        for (int i = 0; i < SID_ITEMS_PER_BYTE; ++i) {
+            (out++)->val = s_head_reset_words[i];
+        }
+        slots--;
+    }
+    size_t nbytes = (src_size < slots) ? src_size : slots;
+    for (size_t i = 0; i < nbytes; ++i) {
+        if (i == src_size - 1) {
+            (out++)->val = s_tail_reset_word;
+        } else {
+            out = encode_sid_bits(p[i], 8, out);
+        }
+    }
+    *translated_size = nbytes;
+    *item_num = (size_t)(out - dest);
+}
+
+uint32_t sid_rmt_chain_wire_us(int chip_count, const SidTimingProfile& timing)
+{
+    uint32_t bits = (uint32_t)chip_count * SID_BITS_PER_CHIP + SID_GAIN_BYTES * 8;
+    uint32_t ticks = timing.headLowTicks + bits * SID_BIT_TICKS + timing.tailLowTicks;
+    return (ticks + RMT_TICKS_PER_US - 1) / RMT_TICKS_PER_US;
+}
+
+uint32_t sid_rmt_frame_wire_us(const PanelChannel* channels, int channel_count, const SidTimingProfile& timing)
+{
+    uint32_t longest = 0;
+    for (int c = 0; c < channel_count; ++c) {
+        uint32_t us = sid_rmt_chain_wire_us(channels[c].chipCount, timing);
+        if (us > longest) {
+            longest = us;
+        }
+    }
+    return longest;
+}
+
+uint32_t sid_rmt_max_fps(const PanelChannel* channels, int channel_count, const SidTimingProfile& timing)
+{
+    uint32_t us = sid_rmt_frame_wire_us(channels, channel_count, timing);
+    return us ? 1000000UL / us : 0;
+}
+
+uint32_t sid_rmt_current_frame_wire_us(void)
+{
+    const PanelDescriptor& panel = panel_get();
+    return sid_rmt_frame_wire_us(panel.channels, panel.channelCount, s_timing);
+}
+
+uint32_t sid_rmt_current_max_fps(void)
+{
+    const PanelDescriptor& panel = panel_get();
+    return sid_rmt_max_fps(panel.channels, panel.channelCount, s_timing);
+}
+
+// 帧头分摊到8个item共16个duration字段，帧尾为1个item的2个字段，每个字段 1..32767
+bool sid_rmt_set_timing_profile(const SidTimingProfile& profile)
+{
+    if (profile.headLowTicks < 2 * SID_ITEMS_PER_BYTE ||
+        profile.headLowTicks > 2 * SID_ITEMS_PER_BYTE * SID_RESET_FIELDS_MAX ||
+        profile.tailLowTicks < 2 || profile.tailLowTicks > 2 * SID_RESET_FIELDS_MAX) {
+        debug_println("SID timing: invalid profile, ignored");
+        return false;
+    }
+    // 复位item全为低电平，发送中途切换至多让一帧的复位时长新旧混合
+    s_timing = profile;
+    fill_low_words(s_timing.headLowTicks, s_head_reset_words, SID_ITEMS_PER_BYTE);
+    fill_low_words(s_timing.tailLowTicks, &s_tail_reset_word, 1);
+    debug_printf("SID timing: %s, head %lu ticks, tail %lu ticks, max %lu fps\n", s_timing.name,
+                 (unsigned long)s_timing.headLowTicks, (unsigned long)s_timing.tailLowTicks,
+                 (unsigned long)sid_rmt_current_max_fps());
+    return true;
+}
+
+const SidTimingProfile& sid_rmt_get_timing_profile(void)
+{
+    return s_timing;
+}
+
+bool sid_rmt_select_timing_profile(uint8_t id, bool save)
+{
+    if (id >= SID_TIMING_PROFILE_COUNT) {
+        return false;
+    }
+    if (save) {
+        Preferences prefs;
+        if (!prefs.begin(SID_TIMING_NVS_NAMESPACE, false)) {
+            return false;
+        }
+        bool ok = prefs.putUChar("id", id) == sizeof(uint8_t);
+        prefs.end();
+        if (!ok) {
+            return false;
+        }
+    }
+    return sid_rmt_set_timing_profile(*SID_TIMING_PROFILES[id]);
+}
+
+uint8_t sid_rmt_get_timing_profile_id(void)
+{
+    for (uint8_t id = 0; id < SID_TIMING_PROFILE_COUNT; ++id) {
+        const SidTimingProfile& p = *SID_TIMING_PROFILES[id];
+        if (s_timing.headLowTicks == p.headLowTicks && s_timing.tailLowTicks == p.tailLowTicks) {
+            return id;
+        }
+    }
+    return SID_TIMING_PROFILE_CUSTOM;
+}
+
+// 启动时加载保存的时序档编号，无记录或编号无效时用标准档
+static void sid_timing_load(void)
+{
+    uint8_t id = SID_TIMING_PROFILE_STANDARD;
+    Preferences prefs;
+    if (prefs.begin(SID_TIMING_NVS_NAMESPACE, true)) {
+        id = prefs.getUChar("id", SID_TIMING_PROFILE_STANDARD);
+        prefs.end();
+    }
+    if (id >= SID_TIMING_PROFILE_COUNT) {
+        debug_println("SID timing: stored profile invalid, using standard");
+        id = SID_TIMING_PROFILE_STANDARD;
+    }
+    s_timing = *SID_TIMING_PROFILES[id];
 }
-#define RMT_TX_CHANNEL    RMT_CHANNEL_1
-#define RMT_TX_GPIO       GPIO_NUM_25
-#define RMT_CLK_DIV 1
-#define T0H_TICKS  23
-#define T0L_TICKS  73
-#define T1H_TICKS  72
-#define T1L_TICKS  24
-#define RESET_TICKS 16320
 
 void sid_rmt_init(void)
 {
-    rmt_config_t config;
-    config.rmt_mode = RMT_MODE_TX;
-    config.channel = RMT_TX_CHANNEL;
-    config.gpio_num = RMT_TX_GPIO;
-    config.clk_div = RMT_CLK_DIV;
-    config.mem_block_num = 1; // 必须为1
-    config.tx_config.loop_en = false;
-    config.tx_config.carrier_en = false;
-    config.tx_config.idle_output_en = true;
-    config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
-
-    esp_err_t err;
-    err = rmt_config(&config);
-    debug_printf("rmt_config: %d\n", err);
-    err = rmt_driver_install(config.channel, 0, 0);
-    debug_printf("rmt_driver_install: %d\n", err);
-}
-
-static void build_sid_rmt_items(const uint32_t* data, int chip_count, uint16_t gain, rmt_item32_t* items, int* item_count)
-{
-    int idx = 0;
-    // Reset (帧头)
-    items[idx].level0 = 0;
-    items[idx].duration0 = RESET_TICKS;
-    items[idx].level1 = 0;
-    items[idx].duration1 = 300;
-    idx++;
-
-    // 芯片数据
-    for (int i = 0; i < chip_count; ++i) {
-        uint32_t d = data[i];
-        for (int bit = 23; bit >= 0; --bit) {
-            if (d & (1U << bit)) {
-                items[idx].level0 = 1;
-                items[idx].duration0 = T1H_TICKS;
-                items[idx].level1 = 0;
-                items[idx].duration1 = T1L_TICKS;
-            } else {
-                items[idx].level0 = 1;
-                items[idx].duration0 = T0H_TICKS;
-                items[idx].level1 = 0;
-                items[idx].duration1 = T0L_TICKS;
+    const PanelDescriptor& panel = panel_get();
+
+    sid_timing_load();
+    fill_low_words(s_timing.headLowTicks, s_head_reset_words, SID_ITEMS_PER_BYTE);
+    fill_low_words(s_timing.tailLowTicks, &s_tail_reset_word, 1);
+
+    int chip_start = 0;
+    for (int c = 0; c < panel.channelCount; ++c) {
+        SidChannel& ch = s_channels[c];
+        ch.channel = (rmt_channel_t)(SID_RMT_FIRST_CHANNEL + c);
+        ch.chipStart = chip_start;
+        ch.chipCount = panel.channels[c].chipCount;
+        ch.streamBegin = nullptr;
+        chip_start += ch.chipCount;
+
+        rmt_config_t config;
+        config.rmt_mode = RMT_MODE_TX;
+        config.channel = ch.channel;
+        config.gpio_num = (gpio_num_t)panel.channels[c].gpio;
+        config.clk_div = RMT_CLK_DIV;
+        config.mem_block_num = 1; // 必须为1
+        config.tx_config.loop_en = false;
+        config.tx_config.carrier_en = false;
+        config.tx_config.idle_output_en = true;
+        config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+
+        // 线序字节缓冲只与子链长度有关，启动时一次性分配，运行中不再变化
+        size_t stream_bytes = ch.chipCount * 3 + SID_STREAM_EXTRA_BYTES;
+        for (int i = 0; i < 2; ++i) {
+            ch.wire[i] = (uint8_t*)malloc(stream_bytes);
+            if (!ch.wire[i]) {
+                debug_println("ERROR: Failed to allocate SID wire buffer");
             }
-            idx++;
         }
-    }
-    // 增益
-    for (int bit = 15; bit >= 0; --bit) {
-        if (gain & (1U << bit)) {
-            items[idx].level0 = 1;
-            items[idx].duration0 = T1H_TICKS;
-            items[idx].level1 = 0;
-            items[idx].duration1 = T1L_TICKS;
+
+        esp_err_t err;
+        err = rmt_config(&config);
+        debug_printf("rmt_config[%d]: %d\n", c, err);
+        err = rmt_driver_install(config.channel, 0, 0);
+        debug_printf("rmt_driver_install[%d]: %d\n", c, err);
+        err = rmt_translator_init(config.channel, sid_sample_to_rmt);
+        debug_printf("rmt_translator_init[%d]: %d\n", c, err);
+
+        // 通道初始空闲：首帧无需等待
+        ch.txDone = xSemaphoreCreateBinary();
+        if (ch.txDone) {
+            xSemaphoreGive(ch.txDone);
         } else {
-            items[idx].level0 = 1;
-            items[idx].duration0 = T0H_TICKS;
-            items[idx].level1 = 0;
-            items[idx].duration1 = T0L_TICKS;
+            debug_println("ERROR: Failed to create RMT tx done semaphore");
+        }
+    }
+    s_channel_count = panel.channelCount;
+    s_wire_index = 0;
+    s_has_last_frame = false;
+    rmt_register_tx_end_callback(sid_rmt_tx_end_cb, nullptr);
+    sid_calib_load();
+
+    debug_printf("SID output: %d channel(s), timing %s, frame wire time %lu us, max %lu fps\n",
+                 s_channel_count, s_timing.name,
+                 (unsigned long)sid_rmt_current_frame_wire_us(),
+                 (unsigned long)sid_rmt_current_max_fps());
+}
+
+void sid_rmt_set_async(bool enabled)
+{
+    for (int c = 0; c < s_channel_count; ++c) {
+        if (!s_channels[c].txDone) {
+            enabled = false;
+        }
+    }
+    if (s_async_enabled && !enabled) {
+        // 关闭异步前等待在途帧发完，之后同步发送不会与其重叠
+        for (int c = 0; c < s_channel_count; ++c) {
+            xSemaphoreTake(s_channels[c].txDone, portMAX_DELAY);
+            xSemaphoreGive(s_channels[c].txDone);
+        }
+    }
+    s_async_enabled = enabled;
+}
+
+bool sid_rmt_get_async(void)
+{
+    return s_async_enabled;
+}
+
+void sid_rmt_set_keepalive_ms(uint32_t keepalive_ms)
+{
+    s_keepalive_ms = keepalive_ms;
+}
+
+void sid_rmt_get_frame_stats(uint32_t* sent, uint32_t* skipped)
+{
+    if (sent) *sent = s_frames_sent;
+    if (skipped) *skipped = s_frames_skipped;
+}
+
+// 亮度缩放表：scale[v] = min(v*brightness*limit/(100*ONE), 255)，limit 为功率预算的全局缩放；
+// 仅在亮度或缩放变化时重建，不限流时与逐像素 v*brightness/100 再钳位的结果逐位一致
+static uint8_t s_scale_lut[256];
+static int s_scale_lut_level = -1;
+static uint32_t s_scale_lut_limit = 0;
+
+static const uint8_t* brightness_scale_lut(uint8_t brightness, uint32_t limit_q12)
+{
+    if (brightness != s_scale_lut_level || limit_q12 != s_scale_lut_limit) {
+        for (int v = 0; v < 256; ++v) {
+            int scaled = (int)(((uint32_t)v * brightness * limit_q12) / (100u * POWER_SCALE_ONE));
+            s_scale_lut[v] = (uint8_t)(scaled > 255 ? 255 : scaled);
         }
-        idx++;
+        s_scale_lut_level = brightness;
+        s_scale_lut_limit = limit_q12;
     }
-    // Reset (帧尾)
-    items[idx].level0 = 0;
-    items[idx].duration0 = RESET_TICKS;
-    items[idx].level1 = 0;
-    items[idx].duration1 = 100;
-    idx++;
-    *item_count = idx;
+    return s_scale_lut;
+}
+
+void sid_power_set_budget_ma(uint32_t budget_ma)
+{
+    portENTER_CRITICAL(&s_power_mux);
+    s_power.budgetMa = budget_ma;
+    portEXIT_CRITICAL(&s_power_mux);
+}
+
+uint32_t sid_power_get_budget_ma(void)
+{
+    portENTER_CRITICAL(&s_power_mux);
+    uint32_t budget = s_power.budgetMa;
+    portEXIT_CRITICAL(&s_power_mux);
+    return budget;
+}
+
+void sid_power_set_coefficients(const uint16_t ua_per_code[3])
+{
+    portENTER_CRITICAL(&s_power_mux);
+    for (int c = 0; c < 3; ++c) {
+        s_power.uaPerCode[c] = ua_per_code[c];
+    }
+    portEXIT_CRITICAL(&s_power_mux);
+}
+
+uint32_t sid_power_estimate_ma(void)
+{
+    portENTER_CRITICAL(&s_power_mux);
+    uint32_t est = s_power.estimateMa;
+    portEXIT_CRITICAL(&s_power_mux);
+    return est;
+}
+
+uint16_t sid_power_scale_q12(void)
+{
+    portENTER_CRITICAL(&s_power_mux);
+    uint32_t scale = s_power.scaleQ12;
+    portEXIT_CRITICAL(&s_power_mux);
+    return (uint16_t)scale;
 }
 
-// 启动一个帧同步亮度淡入/淡出到目标值（用于 dimmer_blank 内部调用）
-void start_brightness_fade(uint8_t target, uint8_t frames) {
-    if (frames == 0) frames = 1;
+// FNV-1a 32位哈希，线序帧约百字节，开销远小于一次编码；多通道时逐段续算
+#define SID_FRAME_HASH_SEED 2166136261UL
+static uint32_t sid_frame_hash(uint32_t h, const uint8_t* data, int len)
+{
+    for (int i = 0; i < len; ++i) {
+        h = (h ^ data[i]) * 16777619UL;
+    }
+    return h;
+}
+
+void start_brightness_ramp(uint8_t target, uint32_t duration_ms, EaseCurve ease) {
     if (target > 100) target = 100;
+    uint64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_brightness_mux);
     target_brightness = target;
-    fade_frames = frames;
+    brightness_ramp_retarget(&s_brightness_ramp, target, duration_ms, ease, now);
+    portEXIT_CRITICAL(&s_brightness_mux);
 }
 
-// 帧同步：每次调用推进一步并返回当前应用亮度（±1 或按特殊淡出策略）
+bool brightness_ramp_active(void) {
+    uint64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_brightness_mux);
+    bool active = !brightness_ramp_done(&s_brightness_ramp, now);
+    portEXIT_CRITICAL(&s_brightness_mux);
+    return active;
+}
+
+// 发送路径每帧调用：按当前时刻取斜坡上的亮度；
+// 色温过渡冻结亮度期间斜坡暂停、保持冻结时的值，解冻后从该值继续，不跳变
 uint8_t get_brightness_frame(void) {
+    uint64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_brightness_mux);
     if (g_anim_brightnessFreezeActive) {
-        return g_anim_frozenBrightness;
-    }
-    if (fade_frames > 0) {
-        // 采用均匀步进至目标（每帧一步，剩余帧数控制总时长）
-        if (global_brightness < target_brightness) {
-            global_brightness++;
-        } else if (global_brightness > target_brightness) {
-            global_brightness--;
-        }
-        fade_frames--;
-        return global_brightness;
-    }
-    // 默认每帧±1
-    if (global_brightness < target_brightness) {
-        global_brightness++;
-    } else if (global_brightness > target_brightness) {
-        global_brightness--;
+        brightness_ramp_pause(&s_brightness_ramp, now);
+    } else {
+        brightness_ramp_resume(&s_brightness_ramp, now);
     }
-    
+    global_brightness = brightness_ramp_value(&s_brightness_ramp, now);
+    bool off = global_brightness == 0 && target_brightness == 0;
+    portEXIT_CRITICAL(&s_brightness_mux);
+
     // 关屏逻辑：当亮度到达0时，自动设置lightPower=false
-    if (global_brightness == 0 && target_brightness == 0) {
+    if (off && lightPower) {
         debug_printf("Turning off light: global_brightness=%d, target_brightness=%d\n", global_brightness, target_brightness);
         lightPower = false;
     }
@@ -625,10 +561,83 @@ uint8_t get_brightness_frame(void) {
     return global_brightness;
 }
 
-// 设置亮度 (0-100) - 仅设置目标；实际应用在 send_data 调用时逐帧推进
+// 设置亮度 (0-100) - 仅设置目标，立即返回；按每级 SID_BRIGHTNESS_MS_PER_STEP 匀速过渡，
+// 斜坡途中再次设置从当前值继续，不跳变
 void set_brightness(uint8_t brightness) {
     if (brightness > 100) brightness = 100;
+    uint64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_brightness_mux);
+    int32_t diff = (int32_t)((uint32_t)brightness << 8) - (int32_t)brightness_ramp_value_q8(&s_brightness_ramp, now);
+    if (diff < 0) diff = -diff;
+    uint32_t duration_ms = ((uint32_t)diff * SID_BRIGHTNESS_MS_PER_STEP + 255) >> 8;
     target_brightness = brightness;
+    brightness_ramp_retarget(&s_brightness_ramp, brightness, duration_ms, EASE_LINEAR, now);
+    portEXIT_CRITICAL(&s_brightness_mux);
+}
+
+static void sid_calib_store(const ColorCalib* calib)
+{
+    portENTER_CRITICAL(&s_calib_mux);
+    s_calib = *calib;
+    s_calib_identity = color_calib_is_identity(calib);
+    portEXIT_CRITICAL(&s_calib_mux);
+}
+
+void sid_calib_load(void)
+{
+    ColorCalib calib;
+    color_calib_identity(&calib);
+    Preferences prefs;
+    if (prefs.begin(SID_CALIB_NVS_NAMESPACE, true)) {
+        uint8_t bytes[COLOR_CALIB_WIRE_SIZE];
+        if (prefs.getBytesLength("m") == sizeof(bytes) &&
+            prefs.getBytes("m", bytes, sizeof(bytes)) == sizeof(bytes)) {
+            color_calib_decode(bytes, &calib);
+            if (!color_calib_valid(&calib)) {
+                debug_println("Calib: stored matrix invalid, using identity");
+                color_calib_identity(&calib);
+            }
+        }
+        prefs.end();
+    }
+    sid_calib_store(&calib);
+    debug_printf("Calib: %s\n", color_calib_is_identity(&calib) ? "identity (bypass)" : "matrix loaded");
+}
+
+bool sid_calib_set(const ColorCalib* calib, bool save)
+{
+    if (!color_calib_valid(calib)) {
+        return false;
+    }
+    if (save) {
+        Preferences prefs;
+        if (!prefs.begin(SID_CALIB_NVS_NAMESPACE, false)) {
+            return false;
+        }
+        bool ok;
+        if (color_calib_is_identity(calib)) {
+            // 恢复单位矩阵即清除存储
+            prefs.remove("m");
+            ok = true;
+        } else {
+            uint8_t bytes[COLOR_CALIB_WIRE_SIZE];
+            color_calib_encode(calib, bytes);
+            ok = prefs.putBytes("m", bytes, sizeof(bytes)) == sizeof(bytes);
+        }
+        prefs.end();
+        if (!ok) {
+            return false;
+        }
+    }
+    sid_calib_store(calib);
+    return true;
+}
+
+void sid_calib_get(ColorCalib* calib)
+{
+    portENTER_CRITICAL(&s_calib_mux);
+    *calib = s_calib;
+    portEXIT_CRITICAL(&s_calib_mux);
 }
 
 // 获取目标亮度（上层查询）
@@ -638,43 +647,177 @@ uint8_t get_brightness(void) {
 
 // dimmer_blank() 函数已移除，现在使用 setLightPower(false, 0) 接口
 
-void send_data(const uint8_t* buf, int len, uint16_t gain)
+void sid_matrix_to_chain(const uint8_t* src, uint8_t* dst, int len)
+{
+    const PanelDescriptor& panel = panel_get();
+    if (len / 3 != panel.chipCount) {
+        return;
+    }
+    for (int i = 0; i < panel.chipCount; ++i) {
+        const uint8_t* px = &src[panel.chainOrder[i]*3];
+        dst[i*3+0] = px[0];
+        dst[i*3+1] = px[1];
+        dst[i*3+2] = px[2];
+    }
+}
+
+// 按缩放表写出一段子链的线序字节；sums 非空时顺带累加各通道码值（即缩放后的线上值）
+static inline void sid_scale_chips(uint8_t* wire, const uint8_t* buf, const uint16_t* sub, int chip_start, int n,
+                                   const uint8_t* scale, uint32_t* sums)
+{
+    uint32_t r = 0, g = 0, b = 0;
+    const uint8_t* src = buf + chip_start * 3;
+    for (int i = 0; i < n; ++i) {
+        const uint8_t* px = sub ? &buf[sub[i]*3] : &src[i*3];
+        uint8_t vr = scale[px[0]];
+        uint8_t vg = scale[px[1]];
+        uint8_t vb = scale[px[2]];
+        wire[i*3+0] = vr;
+        wire[i*3+1] = vg;
+        wire[i*3+2] = vb;
+        r += vr;
+        g += vg;
+        b += vb;
+    }
+    if (sums) {
+        sums[0] += r;
+        sums[1] += g;
+        sums[2] += b;
+    }
+}
+
+// 哈希相同后逐字节确认（哈希可能碰撞）：另一块缓冲即上次发出的帧
+static bool sid_same_as_last_frame(int slot, const int* sizes)
+{
+    for (int c = 0; c < s_channel_count; ++c) {
+        if (sizes[c] != s_last_sizes[c]) {
+            return false;
+        }
+        if (sizes[c] > 0 && memcmp(s_channels[c].wire[slot], s_channels[c].wire[slot ^ 1], sizes[c]) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// order 非空时按映射表从矩阵序取像素，为空时 buf 已是链序，线性读取。
+// 各通道取各自子链，帧不足整链时只发送覆盖到的通道
+static void send_frame(const uint8_t* buf, int len, uint16_t gain, const uint16_t* order)
 {
     int chip_count = len / 3;
-    if (chip_count > SID_MAX_CHIPS) {
+    int panel_chips = panel_chip_count();
+    if (chip_count > panel_chips || (order && chip_count != panel_chips)) {
         return;
     }
 
-    uint32_t chip_data[SID_MAX_CHIPS];
-    
-    if(!lightPower)
-    {
-        // 关闭状态，显示黑屏
-        for (int i = 0; i < chip_count; ++i) {
-            chip_data[i] = 0x000000;
+    // 亮度每帧只推进一次，所有通道共用同一缩放表；功率预算的全局缩放并入表中
+    const uint8_t* scale = nullptr;
+    if (lightPower) {
+        portENTER_CRITICAL(&s_power_mux);
+        uint32_t limit = s_power.scaleQ12;
+        portEXIT_CRITICAL(&s_power_mux);
+        scale = brightness_scale_lut(get_brightness_frame(), limit);
+    }
+    // 校准矩阵每帧复制一次，单位矩阵时整段跳过
+    ColorCalib calib;
+    bool calib_active = false;
+    if (scale) {
+        portENTER_CRITICAL(&s_calib_mux);
+        calib_active = !s_calib_identity;
+        if (calib_active) {
+            calib = s_calib;
         }
-    } else {
-        // 正常显示，使用亮度平滑控制
-        uint8_t applied_brightness = get_brightness_frame();
-        
-        for (int i = 0; i < chip_count; ++i) {
-            uint16_t r = (uint16_t)((buf[LED_MATRIX_PATTERN[i]*3+0] * applied_brightness) / 100);
-            uint16_t g = (uint16_t)((buf[LED_MATRIX_PATTERN[i]*3+1] * applied_brightness) / 100);
-            uint16_t b = (uint16_t)((buf[LED_MATRIX_PATTERN[i]*3+2] * applied_brightness) / 100);
-            if (r > 255) r = 255; if (g > 255) g = 255; if (b > 255) b = 255;
-            chip_data[i] = ((uint32_t)r << 16) | ((uint32_t)g << 8)  | ((uint32_t)b);
+        portEXIT_CRITICAL(&s_calib_mux);
+    }
+
+    // 两块字节缓冲交替使用：另一块保存上次发出的帧（异步模式下可能仍在发送），供重复帧逐字节比对
+    int slot = s_wire_index;
+    int sizes[PANEL_MAX_CHANNELS];
+    uint32_t hash = SID_FRAME_HASH_SEED;
+    uint32_t sums[3] = {0, 0, 0};  // 本帧线上 R、G、B 码值和，供功率估算
+    for (int c = 0; c < s_channel_count; ++c) {
+        const SidChannel& ch = s_channels[c];
+        uint8_t* wire = ch.wire[slot];
+        int n = chip_count - ch.chipStart;
+        if (n > ch.chipCount) n = ch.chipCount;
+        sizes[c] = 0;
+        if (n <= 0 || !wire) {
+            continue;
+        }
+        int size = n * 3;
+
+        if (!scale) {
+            // 关闭状态，显示黑屏
+            memset(wire, 0, size);
+        } else if (calib_active) {
+            // 校准会改变码值：缩放、校准之后再统计
+            sid_scale_chips(wire, buf, order ? order + ch.chipStart : nullptr, ch.chipStart, n, scale, nullptr);
+            color_calib_apply(&calib, wire, n);
+            power_accumulate(wire, n, sums);
+        } else {
+            sid_scale_chips(wire, buf, order ? order + ch.chipStart : nullptr, ch.chipStart, n, scale, sums);
+        }
+        wire[size++] = (uint8_t)(gain >> 8);
+        wire[size++] = (uint8_t)(gain & 0xFF);
+        wire[size++] = 0;  // 帧尾哨兵，translator输出为帧尾Reset
+        sizes[c] = size;
+        hash = sid_frame_hash(hash, wire, size);
+    }
+
+    // 估算本帧电流，缩放变化在下一帧生效（跳过发送的帧同样计入）
+    portENTER_CRITICAL(&s_power_mux);
+    power_budget_update(&s_power, sums);
+    portEXIT_CRITICAL(&s_power_mux);
+
+    // 与上次发送的帧相同且未到保活刷新时间：跳过本帧
+    uint32_t now = millis();
+    if (s_keepalive_ms > 0 && s_has_last_frame && hash == s_last_frame_hash &&
+        (uint32_t)(now - s_last_send_ms) < s_keepalive_ms && sid_same_as_last_frame(slot, sizes)) {
+        s_frames_skipped++;
+        return;
+    }
+    s_last_frame_hash = hash;
+    s_last_send_ms = now;
+    s_has_last_frame = true;
+    memcpy(s_last_sizes, sizes, s_channel_count * sizeof(int));
+    s_frames_sent++;
+
+    if (s_async_enabled) {
+        // 等上一帧发完（其缓冲在下一次调用前不会被改写）
+        for (int c = 0; c < s_channel_count; ++c) {
+            if (sizes[c] > 0) {
+                xSemaphoreTake(s_channels[c].txDone, portMAX_DELAY);
+            }
+        }
+    }
+    // 各通道依次启动后并行传输；ESP32 RMT 无硬件同步启动，
+    // 通道间起始偏差仅为一次首块填充（数微秒），远小于帧头Reset
+    for (int c = 0; c < s_channel_count; ++c) {
+        if (sizes[c] > 0) {
+            SidChannel& ch = s_channels[c];
+            ch.streamBegin = ch.wire[slot];
+            rmt_write_sample(ch.channel, ch.wire[slot], sizes[c], false);
+        }
+    }
+    s_wire_index ^= 1;
+    if (s_async_enabled) {
+        // 启动后立即返回，下一帧编码与本帧传输重叠
+        return;
+    }
+    for (int c = 0; c < s_channel_count; ++c) {
+        if (sizes[c] > 0) {
+            rmt_wait_tx_done(s_channels[c].channel, portMAX_DELAY);
         }
     }
-    rmt_item32_t items[2 + 24*SID_MAX_CHIPS + 16];
-    int item_count = 0;
-    build_sid_rmt_items(chip_data, chip_count, gain, items, &item_count);
-    rmt_write_items(RMT_TX_CHANNEL, items, item_count, true);
-    rmt_wait_tx_done(RMT_TX_CHANNEL, portMAX_DELAY);
 }
 
-// 提供一个外部设置斜坡帧数的方式：由上层调用开启一次斜坡
-void begin_brightness_ramp(uint8_t frames) {
-    if (frames == 0) frames = 1;
-    // frames_remaining = frames; // This line is removed as per the new logic
-    // step_accum = 0; // This line is removed as per the new logic
-} 
\ No newline at end of file
+void send_data(const uint8_t* buf, int len, uint16_t gain)
+{
+    send_frame(buf, len, gain, panel_get().chainOrder);
+}
+
+void send_chain_data(const uint8_t* buf, int len, uint16_t gain)
+{
+    send_frame(buf, len, gain, nullptr);
+}
+ 
\ No newline at end of file
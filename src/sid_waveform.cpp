@@ -0,0 +1,142 @@
+#include "sid_waveform.h"
+#include <string.h>
+
+// 按电平段读取item序列：相邻同电平duration合并（帧头/帧尾复位由多个全低item组成），
+// duration为0视为结束标记
+struct SidRunReader {
+    const uint32_t* items;
+    int fieldCount;
+    int field;
+
+    void fieldAt(int f, int* level, uint32_t* ticks) const {
+        uint32_t w = items[f >> 1];
+        if (f & 1) {
+            *ticks = (w >> 16) & 0x7FFF;
+            *level = (int)(w >> 31);
+        } else {
+            *ticks = w & 0x7FFF;
+            *level = (int)((w >> 15) & 1);
+        }
+    }
+
+    bool next(int* level, uint32_t* ticks) {
+        if (field >= fieldCount) {
+            return false;
+        }
+        fieldAt(field, level, ticks);
+        if (*ticks == 0) {
+            field = fieldCount;
+            return false;
+        }
+        field++;
+        while (field < fieldCount) {
+            int l;
+            uint32_t t;
+            fieldAt(field, &l, &t);
+            if (t == 0 || l != *level) {
+                break;
+            }
+            *ticks += t;
+            field++;
+        }
+        return true;
+    }
+};
+
+static bool within(uint32_t ticks, uint16_t ref, uint16_t tolerance)
+{
+    return ticks + tolerance >= ref && ticks <= (uint32_t)ref + tolerance;
+}
+
+static bool fail(SidDecodedFrame* out, int pos, const char* error)
+{
+    out->errorPos = pos;
+    out->error = error;
+    return false;
+}
+
+bool sid_wave_decode(const uint32_t* items, int count, const SidWaveTiming& timing, SidDecodedFrame* out)
+{
+    out->chipCount = 0;
+    out->gain = 0;
+    out->headLowTicks = 0;
+    out->tailLowTicks = 0;
+    out->totalTicks = 0;
+    out->errorPos = -1;
+    out->error = nullptr;
+
+    SidRunReader reader = {items, count * 2, 0};
+    int pos = 0;
+    int level;
+    uint32_t ticks;
+
+    // 帧头复位
+    if (!reader.next(&level, &ticks)) {
+        return fail(out, pos, "empty frame");
+    }
+    if (level != 0 || ticks < timing.minResetTicks) {
+        return fail(out, pos, "missing head reset");
+    }
+    out->headLowTicks = ticks;
+    out->totalTicks = ticks;
+    pos++;
+
+    // 数据位：高电平定位值，低电平须与之配对；末位的低电平与帧尾复位合并
+    uint32_t nbits = 0;
+    uint32_t lastBits = 0;  // 最近16位，结束时即为增益字
+    bool tail = false;
+    while (!tail) {
+        if (!reader.next(&level, &ticks)) {
+            return fail(out, pos, "missing tail reset");
+        }
+        if (level != 1) {
+            return fail(out, pos, "expected high level");
+        }
+        int bit;
+        if (within(ticks, timing.t0h, timing.tolerance)) {
+            bit = 0;
+        } else if (within(ticks, timing.t1h, timing.tolerance)) {
+            bit = 1;
+        } else {
+            return fail(out, pos, "high duration out of tolerance");
+        }
+        out->totalTicks += ticks;
+        pos++;
+
+        if (!reader.next(&level, &ticks)) {
+            return fail(out, pos, "missing low after bit");
+        }
+        uint16_t lowRef = bit ? timing.t1l : timing.t0l;
+        if (ticks >= timing.minResetTicks && ticks >= lowRef) {
+            out->tailLowTicks = ticks - lowRef;
+            tail = true;
+        } else if (!within(ticks, lowRef, timing.tolerance)) {
+            return fail(out, pos, "low duration out of tolerance");
+        }
+        out->totalTicks += ticks;
+        pos++;
+
+        uint32_t byteIndex = nbits >> 3;
+        if ((int)byteIndex < out->rgbCapacity) {
+            if ((nbits & 7) == 0) {
+                out->rgb[byteIndex] = 0;
+            }
+            out->rgb[byteIndex] |= (uint8_t)(bit << (7 - (nbits & 7)));
+        }
+        lastBits = (lastBits << 1) | (uint32_t)bit;
+        nbits++;
+    }
+
+    if (reader.next(&level, &ticks)) {
+        return fail(out, pos, "data after tail reset");
+    }
+    if (nbits < 16 || (nbits - 16) % 24 != 0) {
+        return fail(out, pos, "bit count is not 24*N+16");
+    }
+    out->chipCount = (int)((nbits - 16) / 24);
+    if (out->chipCount * 3 > out->rgbCapacity) {
+        return fail(out, pos, "rgb buffer too small");
+    }
+    out->gain = (uint16_t)(lastBits & 0xFFFF);
+    return true;
+}
@@ -0,0 +1,136 @@
+#include "timeline.h"
+
+// 2^(i/16)，Q16
+static const uint32_t POW2_FRAC_Q16[17] = {
+    65536, 68438, 71468, 74632, 77936, 81386, 84990, 88752, 92682,
+    96785, 101070, 105545, 110218, 115098, 120194, 125515, 131072,
+};
+
+// 2^x，x 为 Q16 且在 [-10, 0]；小数部分按16段查表线性插值，相对误差 <0.05%
+static uint32_t exp2_q16(int32_t x)
+{
+    uint32_t y = (uint32_t)(x + (10 << 16));
+    uint32_t ip = y >> 16;
+    uint32_t f = y & 0xFFFF;
+    uint32_t i = f >> 12;
+    uint32_t v = POW2_FRAC_Q16[i] + (((POW2_FRAC_Q16[i + 1] - POW2_FRAC_Q16[i]) * (f & 0xFFF)) >> 12);
+    return (v << ip) >> 10;
+}
+
+static uint32_t cube_q16(uint32_t t)
+{
+    uint64_t t2 = ((uint64_t)t * t) >> 16;
+    return (uint32_t)((t2 * t) >> 16);
+}
+
+// 两端对称曲线的前半段：t 在 [0, ONE/2]，返回 [0, ONE/2]
+static uint32_t ease_in_half(EaseCurve ease, uint32_t t)
+{
+    if (ease == EASE_IN_OUT_CUBIC) {
+        return cube_q16(t) * 4;
+    }
+    // 0.5*2^(20t-10)，减去 t=0 处的偏移后拉伸回 [0, ONE/2]，端点精确
+    const uint32_t g0 = 32;  // 0.5*2^-10
+    uint32_t g = exp2_q16((int32_t)(20 * t) - (10 << 16)) >> 1;
+    if (g < g0) g = g0;
+    return (uint32_t)((uint64_t)(g - g0) * (TIMELINE_ONE / 2) / (TIMELINE_ONE / 2 - g0));
+}
+
+uint32_t ease_q16(EaseCurve ease, uint32_t t)
+{
+    if (t >= TIMELINE_ONE) {
+        return TIMELINE_ONE;
+    }
+    switch (ease) {
+    case EASE_IN_CUBIC:
+        return cube_q16(t);
+    case EASE_OUT_CUBIC:
+        return TIMELINE_ONE - cube_q16(TIMELINE_ONE - t);
+    case EASE_IN_OUT_CUBIC:
+    case EASE_IN_OUT_EXPO:
+        if (t < TIMELINE_ONE / 2) {
+            return ease_in_half(ease, t);
+        }
+        return TIMELINE_ONE - ease_in_half(ease, TIMELINE_ONE - t);
+    case EASE_PERCEPTUAL:
+        return cie_lightness_to_luminance_q16(t);
+    default:
+        return t;
+    }
+}
+
+void timeline_start(Timeline* tl, uint32_t durationMs, EaseCurve ease, uint64_t nowUs)
+{
+    tl->startUs = nowUs;
+    tl->durationUs = durationMs * 1000;
+    tl->ease = ease;
+}
+
+uint32_t timeline_linear_q16(const Timeline* tl, uint64_t nowUs)
+{
+    if (tl->durationUs == 0 || nowUs >= tl->startUs + tl->durationUs) {
+        return TIMELINE_ONE;
+    }
+    if (nowUs <= tl->startUs) {
+        return 0;
+    }
+    return (uint32_t)(((nowUs - tl->startUs) << 16) / tl->durationUs);
+}
+
+uint32_t timeline_progress_q16(const Timeline* tl, uint64_t nowUs)
+{
+    return ease_q16(tl->ease, timeline_linear_q16(tl, nowUs));
+}
+
+bool timeline_done(const Timeline* tl, uint64_t nowUs)
+{
+    return tl->durationUs == 0 || nowUs >= tl->startUs + tl->durationUs;
+}
+
+uint32_t timeline_elapsed_ms(const Timeline* tl, uint64_t nowUs)
+{
+    if (nowUs <= tl->startUs) {
+        return 0;
+    }
+    uint64_t elapsed = nowUs - tl->startUs;
+    if (elapsed > tl->durationUs) {
+        elapsed = tl->durationUs;
+    }
+    return (uint32_t)(elapsed / 1000);
+}
+
+// L* = 116*Y^(1/3) - 16（Y > (6/29)^3），暗部为线性段 L* = 903.3*Y；此处 L* 已除以100
+uint32_t cie_lightness_to_luminance_q16(uint32_t lightness)
+{
+    if (lightness >= TIMELINE_ONE) {
+        return TIMELINE_ONE;
+    }
+    if (lightness <= 5243) {  // L* <= 8
+        return (uint32_t)((uint64_t)lightness * 1000 / 9033);
+    }
+    uint32_t a = (uint32_t)(((uint64_t)lightness * 100 + (16u << 16)) / 116);
+    return cube_q16(a);
+}
+
+uint32_t cie_luminance_to_lightness_q16(uint32_t luminance)
+{
+    if (luminance >= TIMELINE_ONE) {
+        return TIMELINE_ONE;
+    }
+    if (luminance <= 580) {  // Y <= 0.008856
+        return (uint32_t)((uint64_t)luminance * 9033 / 1000);
+    }
+    // 立方根：在 Q16 上二分，r^3 <= Y*2^32
+    uint64_t target = (uint64_t)luminance << 32;
+    uint32_t lo = 0, hi = TIMELINE_ONE;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi + 1) >> 1;
+        if ((uint64_t)mid * mid * mid <= target) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    uint32_t l = (uint32_t)(((uint64_t)lo * 116 - (16u << 16)) / 100);
+    return l;
+}
@@ -4,31 +4,39 @@
 #include <Arduino.h>
 #include "esp_log.h"
 #include <cstring>
+#include "panel_config.h"
 
 static const char* TAG = "UnifiedAnimation";
 
 // ==================== StaticAnimation 实现 ====================
 
 StaticAnimation::StaticAnimation(uint8_t r, uint8_t g, uint8_t b, const char* name)
-    : name_(name) {
+    : rgbData_((uint8_t*)calloc(panel_frame_size(), 1)), name_(name) {
     setColor(r, g, b);
 }
 
 StaticAnimation::StaticAnimation(const uint8_t* rgbData, const char* name)
-    : name_(name) {
-    if (rgbData) {
-        memcpy(rgbData_, rgbData, 108);
-    } else {
-        memset(rgbData_, 0, 108);
+    : rgbData_((uint8_t*)calloc(panel_frame_size(), 1)), name_(name) {
+    if (rgbData && rgbData_) {
+        memcpy(rgbData_, rgbData, panel_frame_size());
     }
 }
 
+StaticAnimation::~StaticAnimation() {
+    free(rgbData_);
+}
+
 void StaticAnimation::generateFrame(uint8_t* buffer, int frameIndex) {
-    memcpy(buffer, rgbData_, 108);
+    if (!rgbData_) {
+        memset(buffer, 0, panel_frame_size());
+        return;
+    }
+    memcpy(buffer, rgbData_, panel_frame_size());
 }
 
 void StaticAnimation::setColor(uint8_t r, uint8_t g, uint8_t b) {
-    for (int i = 0; i < 36; i++) {
+    if (!rgbData_) return;
+    for (int i = 0; i < panel_chip_count(); i++) {
         rgbData_[i * 3 + 0] = r;
         rgbData_[i * 3 + 1] = g;
         rgbData_[i * 3 + 2] = b;
@@ -36,6 +44,10 @@ void StaticAnimation::setColor(uint8_t r, uint8_t g, uint8_t b) {
 }
 
 void StaticAnimation::getColor(uint8_t& r, uint8_t& g, uint8_t& b) const {
+    if (!rgbData_) {
+        r = g = b = 0;
+        return;
+    }
     r = rgbData_[0];
     g = rgbData_[1];
     b = rgbData_[2];
@@ -64,11 +76,11 @@ PresetAnimation::~PresetAnimation() {
 
 void PresetAnimation::generateFrame(uint8_t* buffer, int frameIndex) {
     if (!loaded_ || !cachedData_ || frameIndex >= frameCount_) {
-        memset(buffer, 0, 108);
+        memset(buffer, 0, panel_frame_size());
         return;
     }
     
-    memcpy(buffer, cachedData_ + frameIndex * 108, 108);
+    memcpy(buffer, cachedData_ + frameIndex * panel_frame_size(), panel_frame_size());
 }
 
 bool PresetAnimation::loadFromStorage(uint8_t sceneId) {
@@ -103,8 +115,15 @@ bool PresetAnimation::loadFromStorage(uint8_t sceneId) {
         return false;
     }
     
+    // 文件大小须与当前面板一致
+    size_t dataSize = panel_frame_size() * frameCount_;
+    if (file.size() != 2 + dataSize) {
+        ESP_LOGE(TAG, "场景文件大小与面板不匹配: %d != %d", (int)file.size(), (int)(2 + dataSize));
+        file.close();
+        return false;
+    }
+    
     // 分配内存
-    size_t dataSize = 108 * frameCount_;
     if (cachedData_) {
         free(cachedData_);
     }
@@ -142,7 +161,7 @@ bool PresetAnimation::saveToStorage(uint8_t sceneId) {
     snprintf(filename, sizeof(filename), "/scene_%02d.dat", sceneId);
     
     // 计算文件大小
-    size_t fileSize = 2 + (108 * frameCount_);
+    size_t fileSize = 2 + (panel_frame_size() * frameCount_);
     
     // 检查可用空间
     size_t freeSpace = SPIFFS.totalBytes() - SPIFFS.usedBytes();
@@ -167,7 +186,7 @@ bool PresetAnimation::saveToStorage(uint8_t sceneId) {
     }
     
     // 写入RGB数据
-    size_t dataSize = 108 * frameCount_;
+    size_t dataSize = panel_frame_size() * frameCount_;
     if (file.write(cachedData_, dataSize) != dataSize) {
         ESP_LOGE(TAG, "写入RGB数据失败");
         file.close();
@@ -218,7 +237,7 @@ public:
         // 计算文件大小
         int frameCount = animation->getFrameCount();
         int frameDelay = animation->getFrameDelay();
-        size_t fileSize = 2 + (108 * frameCount);
+        size_t fileSize = 2 + (panel_frame_size() * frameCount);
         
         // 检查可用空间
         if (getFreeSpace() < fileSize) {
@@ -242,15 +261,23 @@ public:
         }
         
         // 写入RGB数据
-        uint8_t frameBuffer[108];
+        const size_t frameSize = panel_frame_size();
+        uint8_t* frameBuffer = (uint8_t*)malloc(frameSize);
+        if (!frameBuffer) {
+            ESP_LOGE(TAG, "内存分配失败");
+            file.close();
+            return false;
+        }
         for (int i = 0; i < frameCount; i++) {
             animation->generateFrame(frameBuffer, i);
-            if (file.write(frameBuffer, 108) != 108) {
+            if (file.write(frameBuffer, frameSize) != frameSize) {
                 ESP_LOGE(TAG, "写入帧数据失败");
+                free(frameBuffer);
                 file.close();
                 return false;
             }
         }
+        free(frameBuffer);
         
         file.close();
         
@@ -0,0 +1,212 @@
+#include "uv_transition.h"
+
+// 普朗克轨迹（CIE 1960 uv，Q20）及其单位法向（Q14，指向轨迹上方/偏绿一侧），
+// 倒数色温 50..700 mired 每10 mired一点，按 Krystek(1985) 近似式离线计算
+#define UV_LOCUS_MIRED_MIN 50
+#define UV_LOCUS_MIRED_STEP 10
+#define UV_LOCUS_POINTS 66
+static const int32_t UV_LOCUS[UV_LOCUS_POINTS][4] = {
+    {192922, 290076, -15838, 4196}, {193933, 293593, -15651, 4847}, {195102, 297119, -15448, 5459},
+    {196423, 300641, -15230, 6040}, {197888, 304146, -14999, 6594}, {199492, 307622, -14753, 7126},
+    {201227, 311058, -14493, 7640}, {203087, 314443, -14219, 8139}, {205067, 317767, -13931, 8624},
+    {207160, 321022, -13627, 9097}, {209360, 324198, -13307, 9558}, {211662, 327290, -12972, 10008},
+    {214060, 330291, -12622, 10446}, {216549, 333195, -12257, 10872}, {219122, 335999, -11878, 11284},
+    {221777, 338699, -11486, 11683}, {224506, 341293, -11082, 12067}, {227307, 343778, -10668, 12435},
+    {230173, 346155, -10245, 12785}, {233101, 348423, -9816, 13118}, {236087, 350581, -9383, 13431},
+    {239125, 352632, -8948, 13725}, {242213, 354577, -8512, 13999}, {245347, 356417, -8079, 14253},
+    {248522, 358154, -7651, 14488}, {251736, 359792, -7229, 14703}, {254985, 361333, -6815, 14899},
+    {258266, 362780, -6410, 15078}, {261575, 364136, -6017, 15239}, {264911, 365405, -5636, 15384},
+    {268269, 366590, -5267, 15514}, {271647, 367694, -4912, 15630}, {275043, 368720, -4571, 15733},
+    {278455, 369673, -4245, 15825}, {281879, 370555, -3933, 15905}, {285314, 371370, -3635, 15976},
+    {288758, 372122, -3352, 16037}, {292208, 372812, -3082, 16091}, {295663, 373445, -2827, 16138},
+    {299120, 374024, -2584, 16179}, {302579, 374551, -2355, 16214}, {306037, 375029, -2137, 16244},
+    {309494, 375462, -1932, 16270}, {312946, 375851, -1738, 16292}, {316394, 376199, -1555, 16310},
+    {319836, 376508, -1382, 16326}, {323270, 376782, -1219, 16339}, {326695, 377021, -1065, 16349},
+    {330111, 377228, -920, 16358}, {333516, 377405, -783, 16365}, {336910, 377554, -654, 16371},
+    {340291, 377676, -533, 16375}, {343658, 377774, -418, 16379}, {347011, 377848, -310, 16381},
+    {350349, 377901, -208, 16383}, {353671, 377933, -112, 16384}, {356978, 377947, -22, 16384},
+    {360267, 377942, 63, 16384}, {363538, 377922, 144, 16383}, {366792, 377885, 220, 16383},
+    {370027, 377835, 291, 16381}, {373243, 377771, 359, 16380}, {376439, 377695, 423, 16379},
+    {379616, 377607, 483, 16377}, {382773, 377508, 539, 16375}, {385909, 377400, 593, 16373},
+};
+
+const float UV_FIXTURE_DEFAULT_MATRIX[9] = {
+    0.31142f, 0.42351f, 0.28593f,
+    0.19821f, 0.47637f, 0.32543f,
+    -0.03609f, 0.16490f, 0.67951f,
+};
+
+static int32_t lerp_q16(int32_t a, int32_t b, uint32_t t)
+{
+    return a + (int32_t)(((int64_t)(b - a) * t) >> 16);
+}
+
+static void mat_mul(const int32_t m[9], const int32_t in[3], int32_t out[3])
+{
+    for (int i = 0; i < 3; ++i) {
+        int64_t s = (int64_t)m[i * 3] * in[0] + (int64_t)m[i * 3 + 1] * in[1] + (int64_t)m[i * 3 + 2] * in[2];
+        out[i] = (int32_t)(s >> 16);
+    }
+}
+
+bool uv_fixture_init(UvFixture* fx, const float m[9])
+{
+    float det = m[0] * (m[4] * m[8] - m[5] * m[7])
+              - m[1] * (m[3] * m[8] - m[5] * m[6])
+              + m[2] * (m[3] * m[7] - m[4] * m[6]);
+    if (det > -1e-6f && det < 1e-6f) {
+        return false;
+    }
+    float inv[9] = {
+        (m[4] * m[8] - m[5] * m[7]) / det, (m[2] * m[7] - m[1] * m[8]) / det, (m[1] * m[5] - m[2] * m[4]) / det,
+        (m[5] * m[6] - m[3] * m[8]) / det, (m[0] * m[8] - m[2] * m[6]) / det, (m[2] * m[3] - m[0] * m[5]) / det,
+        (m[3] * m[7] - m[4] * m[6]) / det, (m[1] * m[6] - m[0] * m[7]) / det, (m[0] * m[4] - m[1] * m[3]) / det,
+    };
+    for (int i = 0; i < 9; ++i) {
+        fx->rgbToXyz[i] = (int32_t)(m[i] * 65536.0f + (m[i] < 0 ? -0.5f : 0.5f));
+        fx->xyzToRgb[i] = (int32_t)(inv[i] * 65536.0f + (inv[i] < 0 ? -0.5f : 0.5f));
+    }
+    return true;
+}
+
+// 轨迹上倒数色温 miredQ8 处的点与法向，超出表范围钳位到端点
+static void locus_at(int32_t miredQ8, int32_t* u, int32_t* v, int32_t* nu, int32_t* nv)
+{
+    int32_t pos = miredQ8 - (UV_LOCUS_MIRED_MIN << 8);
+    if (pos < 0) pos = 0;
+    int32_t i = pos / (UV_LOCUS_MIRED_STEP << 8);
+    int32_t f = (pos % (UV_LOCUS_MIRED_STEP << 8)) / UV_LOCUS_MIRED_STEP;    // Q8
+    if (i >= UV_LOCUS_POINTS - 1) {
+        i = UV_LOCUS_POINTS - 2;
+        f = 256;
+    }
+    const int32_t* a = UV_LOCUS[i];
+    const int32_t* b = UV_LOCUS[i + 1];
+    *u = a[0] + (((b[0] - a[0]) * f) >> 8);
+    *v = a[1] + (((b[1] - a[1]) * f) >> 8);
+    *nu = a[2] + (((b[2] - a[2]) * f) >> 8);
+    *nv = a[3] + (((b[3] - a[3]) * f) >> 8);
+}
+
+// 线性RGB（Q16）-> 1960 uv（Q20）与Y（Q16）
+static bool linear_to_uv(const UvFixture* fx, const int32_t lin[3], int32_t* u, int32_t* v, int32_t* y)
+{
+    int32_t xyz[3];
+    mat_mul(fx->rgbToXyz, lin, xyz);
+    int64_t d = (int64_t)xyz[0] + 15 * (int64_t)xyz[1] + 3 * (int64_t)xyz[2];
+    if (xyz[1] <= 0 || d <= 0) {
+        return false;
+    }
+    *u = (int32_t)(((int64_t)4 * xyz[0] << 20) / d);
+    *v = (int32_t)(((int64_t)6 * xyz[1] << 20) / d);
+    *y = xyz[1];
+    return true;
+}
+
+// uv 投影到轨迹：取最近折线段上的垂足，得到倒数色温与带符号法向偏移（仅在预计算时调用）
+static void locus_project(int32_t u, int32_t v, int32_t* miredQ8, int32_t* duvQ20)
+{
+    int64_t best = -1;
+    int32_t bestPosQ8 = 0;
+    for (int i = 0; i < UV_LOCUS_POINTS - 1; ++i) {
+        int64_t ax = UV_LOCUS[i][0], ay = UV_LOCUS[i][1];
+        int64_t dx = UV_LOCUS[i + 1][0] - ax, dy = UV_LOCUS[i + 1][1] - ay;
+        int64_t len2 = dx * dx + dy * dy;
+        int64_t s = ((u - ax) * dx + (v - ay) * dy) * 256 / len2;    // 段内位置 Q8
+        if (s < 0) s = 0;
+        if (s > 256) s = 256;
+        int64_t px = ax + dx * s / 256 - u, py = ay + dy * s / 256 - v;
+        int64_t dist2 = px * px + py * py;
+        if (best < 0 || dist2 < best) {
+            best = dist2;
+            bestPosQ8 = i * 256 + (int32_t)s;
+        }
+    }
+    *miredQ8 = (UV_LOCUS_MIRED_MIN << 8) + bestPosQ8 * UV_LOCUS_MIRED_STEP;
+    int32_t lu, lv, nu, nv;
+    locus_at(*miredQ8, &lu, &lv, &nu, &nv);
+    *duvQ20 = (int32_t)(((int64_t)(u - lu) * nu + (int64_t)(v - lv) * nv) >> 14);
+}
+
+// 路径上进度 t 处的线性RGB（Q16，未补偿残差）
+static void path_linear(const UvTransition* tr, uint32_t t, int32_t lin[3])
+{
+    int32_t mired = lerp_q16(tr->miredFromQ8, tr->miredToQ8, t);
+    int32_t duv = lerp_q16(tr->duvFromQ20, tr->duvToQ20, t);
+    int32_t y = lerp_q16(tr->yFromQ16, tr->yToQ16, t);
+    int32_t lu, lv, nu, nv;
+    locus_at(mired, &lu, &lv, &nu, &nv);
+    int64_t u = lu + (((int64_t)duv * nu) >> 14);
+    int64_t vp = (lv + (((int64_t)duv * nv) >> 14)) * 3 / 2;    // v' = 1.5v
+    // X = Y*9u'/(4v')，Z = Y*(12-3u'-20v')/(4v')
+    int32_t xyz[3];
+    int64_t den = 4 * vp;
+    xyz[0] = (int32_t)((int64_t)y * 9 * u / den);
+    xyz[1] = y;
+    xyz[2] = (int32_t)((int64_t)y * (((int64_t)12 << 20) - 3 * u - 20 * vp) / den);
+    mat_mul(tr->fixture->xyzToRgb, xyz, lin);
+}
+
+static void rgb8_to_linear(const uint8_t rgb[3], int32_t lin[3])
+{
+    for (int i = 0; i < 3; ++i) {
+        lin[i] = rgb[i] * 257;    // 码值/255，Q16
+    }
+}
+
+bool uv_transition_plan(UvTransition* tr, const UvFixture* fx, const uint8_t from[3], const uint8_t to[3])
+{
+    int32_t linFrom[3], linTo[3];
+    rgb8_to_linear(from, linFrom);
+    rgb8_to_linear(to, linTo);
+    int32_t uF, vF, yF, uT, vT, yT;
+    bool okF = linear_to_uv(fx, linFrom, &uF, &vF, &yF);
+    bool okT = linear_to_uv(fx, linTo, &uT, &vT, &yT);
+    if (!okF && !okT) {
+        return false;
+    }
+    // 黑色一端沿用另一端的色度，只淡入/淡出亮度
+    if (!okF) { uF = uT; vF = vT; yF = 0; }
+    if (!okT) { uT = uF; vT = vF; yT = 0; }
+
+    tr->fixture = fx;
+    locus_project(uF, vF, &tr->miredFromQ8, &tr->duvFromQ20);
+    locus_project(uT, vT, &tr->miredToQ8, &tr->duvToQ20);
+    tr->yFromQ16 = yF;
+    tr->yToQ16 = yT;
+
+    // 轨迹折线与定点误差让路径端点略偏离实际颜色，记下差值逐帧补偿
+    int32_t p0[3], p1[3];
+    path_linear(tr, 0, p0);
+    path_linear(tr, 65536, p1);
+    for (int i = 0; i < 3; ++i) {
+        tr->residualFrom[i] = linFrom[i] - p0[i];
+        tr->residualTo[i] = linTo[i] - p1[i];
+    }
+    return true;
+}
+
+void uv_transition_eval(const UvTransition* tr, uint32_t tQ16, uint8_t out[3])
+{
+    if (tQ16 > 65536) tQ16 = 65536;
+    int32_t lin[3];
+    path_linear(tr, tQ16, lin);
+    for (int i = 0; i < 3; ++i) {
+        int32_t c = lin[i] + lerp_q16(tr->residualFrom[i], tr->residualTo[i], tQ16);
+        if (c < 0) c = 0;
+        if (c > 65535) c = 65535;
+        out[i] = (uint8_t)((c * 255 + 32767) / 65535);
+    }
+}
+
+bool uv_fixture_chromaticity(const UvFixture* fx, const uint8_t rgb[3], int32_t* upQ20, int32_t* vpQ20, int32_t* yQ16)
+{
+    int32_t lin[3], u, v;
+    rgb8_to_linear(rgb, lin);
+    if (!linear_to_uv(fx, lin, &u, &v, yQ16)) {
+        return false;
+    }
+    *upQ20 = u;
+    *vpQ20 = v * 3 / 2;
+    return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+// 主机测试用 Arduino 替身：只提供固件源码用到的部分，串口输出丢弃
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fake_clock.h"
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define PROGMEM
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+inline unsigned long millis(void)
+{
+    return (unsigned long)(fake_clock_us() / 1000);
+}
+
+inline unsigned long micros(void)
+{
+    return (unsigned long)fake_clock_us();
+}
+
+class FakeSerial {
+public:
+    void begin(unsigned long) {}
+    size_t print(const char*) { return 0; }
+    size_t print(long) { return 0; }
+    size_t print(unsigned long) { return 0; }
+    size_t print(int) { return 0; }
+    size_t print(unsigned int) { return 0; }
+    size_t println(const char* = "") { return 0; }
+    size_t println(long) { return 0; }
+    size_t println(unsigned long) { return 0; }
+    size_t println(int) { return 0; }
+    size_t println(unsigned int) { return 0; }
+    size_t printf(const char*, ...) { return 0; }
+    size_t write(uint8_t) { return 1; }
+};
+
+inline FakeSerial& fake_serial()
+{
+    static FakeSerial serial;
+    return serial;
+}
+#define Serial fake_serial()
@@ -0,0 +1,104 @@
+#pragma once
+// 主机测试用 NVS 替身：进程内存储，按命名空间/键保存字节串
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef std::map<std::string, std::map<std::string, std::vector<uint8_t> > > FakeNvs;
+
+inline FakeNvs& fake_nvs()
+{
+    static FakeNvs nvs;
+    return nvs;
+}
+
+class Preferences {
+public:
+    // 与ESP32一致：只读打开不存在的命名空间失败
+    bool begin(const char* name, bool readOnly = false)
+    {
+        if (readOnly && fake_nvs().find(name) == fake_nvs().end()) {
+            return false;
+        }
+        ns_ = &fake_nvs()[name];
+        readOnly_ = readOnly;
+        return true;
+    }
+    void end() { ns_ = nullptr; }
+
+    bool remove(const char* key)
+    {
+        if (!ns_ || readOnly_) {
+            return false;
+        }
+        return ns_->erase(key) > 0;
+    }
+    bool clear()
+    {
+        if (!ns_ || readOnly_) {
+            return false;
+        }
+        ns_->clear();
+        return true;
+    }
+    bool isKey(const char* key) { return find(key) != nullptr; }
+
+    size_t putBytes(const char* key, const void* value, size_t len)
+    {
+        if (!ns_ || readOnly_ || !value) {
+            return 0;
+        }
+        const uint8_t* p = (const uint8_t*)value;
+        (*ns_)[key].assign(p, p + len);
+        return len;
+    }
+    size_t getBytesLength(const char* key)
+    {
+        const std::vector<uint8_t>* v = find(key);
+        return v ? v->size() : 0;
+    }
+    // 缓冲小于存储长度时读取失败
+    size_t getBytes(const char* key, void* buf, size_t maxLen)
+    {
+        const std::vector<uint8_t>* v = find(key);
+        if (!v || !buf || v->size() > maxLen) {
+            return 0;
+        }
+        memcpy(buf, v->data(), v->size());
+        return v->size();
+    }
+
+    size_t putUChar(const char* key, uint8_t value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putUShort(const char* key, uint16_t value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+    uint8_t getUChar(const char* key, uint8_t def = 0) { return getValue(key, def); }
+    uint16_t getUShort(const char* key, uint16_t def = 0) { return getValue(key, def); }
+    uint32_t getUInt(const char* key, uint32_t def = 0) { return getValue(key, def); }
+
+private:
+    std::map<std::string, std::vector<uint8_t> >* ns_ = nullptr;
+    bool readOnly_ = false;
+
+    const std::vector<uint8_t>* find(const char* key)
+    {
+        if (!ns_) {
+            return nullptr;
+        }
+        std::map<std::string, std::vector<uint8_t> >::const_iterator it = ns_->find(key);
+        return it == ns_->end() ? nullptr : &it->second;
+    }
+    template <typename T>
+    T getValue(const char* key, T def)
+    {
+        const std::vector<uint8_t>* v = find(key);
+        if (!v || v->size() != sizeof(T)) {
+            return def;
+        }
+        T value;
+        memcpy(&value, v->data(), sizeof(T));
+        return value;
+    }
+};
@@ -0,0 +1,233 @@
+#pragma once
+// 主机测试用 RMT 驱动替身：按驱动的分块方式调用 translator 并保存输出的item，
+// 传输在“完成”时才翻译剩余块（与硬件一样读取在途缓冲），由 rmt_wait_tx_done、
+// 对忙通道再次写入或信号量阻塞钩子触发完成。不使用STL，可在 extern "C" 中包含
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "freertos/semphr.h"
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_ARG 0x102
+
+typedef int gpio_num_t;
+
+typedef enum {
+    RMT_CHANNEL_0, RMT_CHANNEL_1, RMT_CHANNEL_2, RMT_CHANNEL_3,
+    RMT_CHANNEL_4, RMT_CHANNEL_5, RMT_CHANNEL_6, RMT_CHANNEL_7,
+    RMT_CHANNEL_MAX
+} rmt_channel_t;
+typedef enum { RMT_MODE_TX, RMT_MODE_RX } rmt_mode_t;
+typedef enum { RMT_IDLE_LEVEL_LOW, RMT_IDLE_LEVEL_HIGH } rmt_idle_level_t;
+
+typedef struct {
+    union {
+        struct {
+            uint32_t duration0 : 15;
+            uint32_t level0 : 1;
+            uint32_t duration1 : 15;
+            uint32_t level1 : 1;
+        };
+        uint32_t val;
+    };
+} rmt_item32_t;
+
+typedef struct {
+    bool loop_en;
+    bool carrier_en;
+    bool idle_output_en;
+    rmt_idle_level_t idle_level;
+} rmt_tx_config_t;
+
+typedef struct {
+    rmt_mode_t rmt_mode;
+    rmt_channel_t channel;
+    gpio_num_t gpio_num;
+    uint8_t clk_div;
+    uint8_t mem_block_num;
+    rmt_tx_config_t tx_config;
+} rmt_config_t;
+
+typedef void (*sample_to_rmt_t)(const void* src, rmt_item32_t* dest, size_t src_size, size_t wanted_num,
+                                size_t* translated_size, size_t* item_num);
+typedef void (*rmt_tx_end_fn_t)(rmt_channel_t channel, void* arg);
+
+#define FAKE_RMT_MAX_BYTES 4096
+#define FAKE_RMT_MAX_ITEMS ((FAKE_RMT_MAX_BYTES + 1) * 8)
+
+struct FakeRmtChannel {
+    bool installed;
+    int gpio;
+    sample_to_rmt_t translator;
+    // 在途传输
+    bool busy;
+    const uint8_t* src;
+    size_t size;
+    size_t consumed;
+    uint8_t snapshot[FAKE_RMT_MAX_BYTES];  // 启动传输时的源数据
+    uint32_t items[FAKE_RMT_MAX_ITEMS];
+    int itemCount;
+    // 最近完成的一次传输
+    const uint8_t* lastSrc;
+    uint8_t lastData[FAKE_RMT_MAX_BYTES];
+    size_t lastSize;
+    uint32_t lastItems[FAKE_RMT_MAX_ITEMS];
+    int lastItemCount;
+    // 统计
+    uint32_t writes;
+    uint32_t completed;
+    uint32_t writesWhileBusy;   // 对仍在传输的通道再次写入（驱动会阻塞）
+    uint32_t sourceChanged;     // 传输途中源缓冲被改写
+    uint32_t chunkErrors;       // 非末块输出的item数不等于请求数
+};
+
+struct FakeRmt {
+    FakeRmtChannel ch[RMT_CHANNEL_MAX];
+    rmt_tx_end_fn_t txEnd;
+    void* txEndArg;
+    size_t firstChunk;   // 首块item数（整块RMT内存）
+    size_t nextChunk;    // 之后每块item数（半块）
+};
+
+inline FakeRmt& fake_rmt()
+{
+    static FakeRmt rmt;
+    static bool init = false;
+    if (!init) {
+        memset(&rmt, 0, sizeof(rmt));
+        rmt.firstChunk = 64;
+        rmt.nextChunk = 32;
+        init = true;
+    }
+    return rmt;
+}
+
+// 翻译一块，返回是否还有后续块
+inline bool fake_rmt_translate_chunk(FakeRmtChannel& c, size_t wanted)
+{
+    if (c.consumed >= c.size || c.itemCount + (int)wanted > FAKE_RMT_MAX_ITEMS) {
+        return false;
+    }
+    size_t used = 0, produced = 0;
+    c.translator(c.src + c.consumed, (rmt_item32_t*)&c.items[c.itemCount], c.size - c.consumed, wanted,
+                 &used, &produced);
+    c.consumed += used;
+    c.itemCount += (int)produced;
+    if (produced < wanted) {
+        if (c.consumed < c.size) {
+            c.chunkErrors++;
+        }
+        return false;
+    }
+    return c.consumed < c.size;
+}
+
+inline void fake_rmt_complete(rmt_channel_t channel)
+{
+    FakeRmt& rmt = fake_rmt();
+    FakeRmtChannel& c = rmt.ch[channel];
+    if (!c.busy) {
+        return;
+    }
+    while (fake_rmt_translate_chunk(c, rmt.nextChunk)) {
+    }
+    if (memcmp(c.snapshot, c.src, c.size) != 0) {
+        c.sourceChanged++;
+    }
+    c.lastSrc = c.src;
+    memcpy(c.lastData, c.snapshot, c.size);
+    c.lastSize = c.size;
+    memcpy(c.lastItems, c.items, c.itemCount * sizeof(uint32_t));
+    c.lastItemCount = c.itemCount;
+    c.busy = false;
+    c.completed++;
+    if (rmt.txEnd) {
+        rmt.txEnd(channel, rmt.txEndArg);
+    }
+}
+
+inline void fake_rmt_complete_all(void)
+{
+    for (int i = 0; i < RMT_CHANNEL_MAX; ++i) {
+        fake_rmt_complete((rmt_channel_t)i);
+    }
+}
+
+// 清除传输记录与统计，保留已安装的通道与回调
+inline void fake_rmt_reset_stats(void)
+{
+    FakeRmt& rmt = fake_rmt();
+    for (int i = 0; i < RMT_CHANNEL_MAX; ++i) {
+        FakeRmtChannel& c = rmt.ch[i];
+        c.busy = false;
+        c.lastSrc = nullptr;
+        c.lastSize = 0;
+        c.lastItemCount = 0;
+        c.writes = c.completed = c.writesWhileBusy = c.sourceChanged = c.chunkErrors = 0;
+    }
+    fake_block_hook().blockedTakes = 0;
+}
+
+inline esp_err_t rmt_config(const rmt_config_t* config)
+{
+    if (!config || config->channel >= RMT_CHANNEL_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    fake_rmt().ch[config->channel].gpio = config->gpio_num;
+    return ESP_OK;
+}
+
+inline esp_err_t rmt_driver_install(rmt_channel_t channel, size_t, int)
+{
+    fake_rmt().ch[channel].installed = true;
+    fake_block_hook().fn = fake_rmt_complete_all;
+    return ESP_OK;
+}
+
+inline esp_err_t rmt_translator_init(rmt_channel_t channel, sample_to_rmt_t fn)
+{
+    fake_rmt().ch[channel].translator = fn;
+    return ESP_OK;
+}
+
+inline rmt_tx_end_fn_t rmt_register_tx_end_callback(rmt_tx_end_fn_t fn, void* arg)
+{
+    FakeRmt& rmt = fake_rmt();
+    rmt_tx_end_fn_t prev = rmt.txEnd;
+    rmt.txEnd = fn;
+    rmt.txEndArg = arg;
+    return prev;
+}
+
+inline esp_err_t rmt_wait_tx_done(rmt_channel_t channel, TickType_t)
+{
+    fake_rmt_complete(channel);
+    return ESP_OK;
+}
+
+inline esp_err_t rmt_write_sample(rmt_channel_t channel, const uint8_t* src, size_t src_size, bool wait_tx_done)
+{
+    FakeRmt& rmt = fake_rmt();
+    FakeRmtChannel& c = rmt.ch[channel];
+    if (!c.installed || !c.translator || src_size > FAKE_RMT_MAX_BYTES) {
+        return ESP_FAIL;
+    }
+    if (c.busy) {
+        c.writesWhileBusy++;
+        fake_rmt_complete(channel);
+    }
+    c.writes++;
+    c.busy = true;
+    c.src = src;
+    c.size = src_size;
+    c.consumed = 0;
+    c.itemCount = 0;
+    memcpy(c.snapshot, src, src_size);
+    fake_rmt_translate_chunk(c, rmt.firstChunk);
+    if (wait_tx_done) {
+        fake_rmt_complete(channel);
+    }
+    return ESP_OK;
+}
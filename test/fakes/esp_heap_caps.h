@@ -0,0 +1,11 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// 主机上没有ESP堆统计：报告固定的空闲堆，碎片率恒为0
+#define MALLOC_CAP_8BIT (1 << 2)
+#define FAKE_HEAP_FREE_BYTES (200 * 1024)
+
+inline size_t heap_caps_get_free_size(uint32_t) { return FAKE_HEAP_FREE_BYTES; }
+inline size_t heap_caps_get_minimum_free_size(uint32_t) { return FAKE_HEAP_FREE_BYTES; }
+inline size_t heap_caps_get_largest_free_block(uint32_t) { return FAKE_HEAP_FREE_BYTES; }
@@ -0,0 +1,8 @@
+#pragma once
+#include <stdint.h>
+#include "fake_clock.h"
+
+inline int64_t esp_timer_get_time(void)
+{
+    return (int64_t)fake_clock_us();
+}
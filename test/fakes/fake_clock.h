@@ -0,0 +1,19 @@
+#pragma once
+#include <stdint.h>
+
+// 主机测试的虚拟时钟（微秒）：millis / esp_timer_get_time / vTaskDelay 共用，由测试显式推进
+inline uint64_t& fake_clock_us()
+{
+    static uint64_t now = 0;
+    return now;
+}
+
+inline void fake_clock_advance_us(uint64_t us)
+{
+    fake_clock_us() += us;
+}
+
+inline void fake_clock_advance_ms(uint32_t ms)
+{
+    fake_clock_us() += (uint64_t)ms * 1000;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "FreeRTOS.h"
+#include "fake_clock.h"
+
+// 信号量：计数为0时 Take 先调用阻塞钩子（模拟等待期间其他上下文的推进，
+// 如RMT传输完成），仍取不到则按超时返回失败
+struct FakeSemaphore {
+    int count;
+    int maxCount;
+};
+typedef FakeSemaphore* SemaphoreHandle_t;
+
+struct FakeBlockHook {
+    void (*fn)(void);
+    uint32_t blockedTakes;  // 曾因计数为0而阻塞的 Take 次数
+};
+
+inline FakeBlockHook& fake_block_hook()
+{
+    static FakeBlockHook hook = {nullptr, 0};
+    return hook;
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return new FakeSemaphore{0, 1};
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return new FakeSemaphore{1, 1};
+}
+
+inline void vSemaphoreDelete(SemaphoreHandle_t sem)
+{
+    delete sem;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    if (sem->count >= sem->maxCount) {
+        return pdFALSE;
+    }
+    sem->count++;
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t* woken)
+{
+    if (woken) {
+        *woken = pdFALSE;
+    }
+    return xSemaphoreGive(sem);
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    if (sem->count == 0) {
+        FakeBlockHook& hook = fake_block_hook();
+        hook.blockedTakes++;
+        if (hook.fn) {
+            hook.fn();
+        }
+        if (sem->count == 0) {
+            fake_clock_advance_ms(ticks == portMAX_DELAY ? 0 : ticks);
+            return pdFALSE;
+        }
+    }
+    sem->count--;
+    return pdTRUE;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "FreeRTOS.h"
+#include "fake_clock.h"
+
+// 任务不会真正运行：创建只返回句柄，延时推进虚拟时钟，通知立即超时
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+inline BaseType_t xTaskCreate(TaskFunction_t, const char*, uint32_t, void*, UBaseType_t, TaskHandle_t* handle)
+{
+    static int dummy;
+    if (handle) {
+        *handle = &dummy;
+    }
+    return pdPASS;
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                                          UBaseType_t prio, TaskHandle_t* handle, BaseType_t)
+{
+    return xTaskCreate(fn, name, stack, arg, prio, handle);
+}
+
+inline void vTaskDelete(TaskHandle_t) {}
+
+inline void vTaskDelay(TickType_t ticks)
+{
+    fake_clock_advance_ms(ticks * portTICK_PERIOD_MS);
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t)
+{
+    return pdPASS;
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t ticks)
+{
+    fake_clock_advance_ms(ticks * portTICK_PERIOD_MS);
+    return 0;
+}
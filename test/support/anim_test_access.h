@@ -0,0 +1,46 @@
+#pragma once
+// 主机测试公用：在假时钟下逐拍驱动 AnimSystem 的播放循环（任务在替身中不运行），
+// 读取刚发布的帧及过渡状态
+#include <stdint.h>
+#include <esp_timer.h>
+#include "anim_system.hpp"
+
+struct AnimSystemTestAccess {
+    // 下一拍发布帧的显示时刻：预渲染帧仍有效时为其截止时刻，否则为当前时刻
+    static uint64_t nextShowUs(const AnimSystem& anim)
+    {
+        if (anim.preparedFrame_ == anim.currentFrame_ && anim.preparedGen_ == anim.contentGen_) {
+            return anim.preparedUs_;
+        }
+        return (uint64_t)esp_timer_get_time();
+    }
+
+    // 播放循环的一拍：发布一帧并把假时钟推进到下一截止时刻，返回所发布帧的显示时刻
+    static uint64_t tick(AnimSystem& anim, int* dropFrames)
+    {
+        uint64_t showUs = nextShowUs(anim);
+        anim.renderTick(dropFrames);
+        return showUs;
+    }
+
+    // 最近发布的帧（链序，含叠加层）
+    static const uint8_t* latestFrame(AnimSystem& anim)
+    {
+        anim.pipeline_.acquire();
+        return anim.pipeline_.readBuffer();
+    }
+
+    // 按播放路径渲染效果的一帧（链序）
+    static void renderEffectFrame(AnimSystem& anim, AnimEffect* effect, int index, uint8_t* dst)
+    {
+        anim.renderEffectFrame(effect, index, dst);
+    }
+
+    // 覆盖当前帧间隔（过渡期间默认 ANIM_TRANSITION_FRAME_MS），下一拍起生效
+    static void setFrameDelay(AnimSystem& anim, int delayMs) { anim.setFrameDelay(delayMs); }
+
+    static int frameSize(const AnimSystem& anim) { return anim.frameSize_; }
+    static int currentFrame(const AnimSystem& anim) { return anim.currentFrame_; }
+    static AnimEffect* currentEffect(const AnimSystem& anim) { return anim.currentEffect_; }
+    static bool transitionActive(const AnimSystem& anim) { return anim.transitionActive_; }
+};
@@ -0,0 +1,43 @@
+#pragma once
+// 主机基准公用：多轮中取最快一轮（减少调度抖动），给出每次调用的纳秒数与周期数。
+// 周期数取 x86 时间戳计数器（恒定频率，近似主频），其他平台为0
+#include <chrono>
+#include <stdint.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+struct BenchResult {
+    double ns;       // 每次调用纳秒数
+    double cycles;   // 每次调用周期数
+};
+
+inline uint64_t bench_cycle_count(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// 每轮调用 fn(i) 共 iterations 次，取 rounds 轮中最快一轮
+template <typename Fn>
+inline BenchResult bench_best(Fn fn, int iterations, int rounds = 7)
+{
+    BenchResult best = {1e30, 1e30};
+    for (int round = 0; round < rounds; ++round) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        uint64_t c0 = bench_cycle_count();
+        for (int i = 0; i < iterations; ++i) {
+            fn(i);
+        }
+        uint64_t c1 = bench_cycle_count();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (ns / iterations < best.ns) {
+            best.ns = ns / iterations;
+            best.cycles = (double)(c1 - c0) / iterations;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,104 @@
+#pragma once
+// 主机测试公用：配置面板与发送器，从 RMT 替身取回线上item并解码
+#include <stdint.h>
+#include <string.h>
+#include <driver/rmt.h>
+#include <Preferences.h>
+#include "panel_config.h"
+#include "sid_rmt_sender.h"
+#include "sid_waveform.h"
+
+// SID芯片手册的位时序（RMT tick，12.5ns）与解码容差
+#define SID_TEST_T0H 23
+#define SID_TEST_T0L 73
+#define SID_TEST_T1H 72
+#define SID_TEST_T1L 24
+#define SID_TEST_TOLERANCE 12
+#define SID_TEST_RESET_TICKS 16320   // 芯片锁存要求的最短低电平（204µs）
+#define SID_TEST_BIT_TICKS (SID_TEST_T0H + SID_TEST_T0L)
+
+inline SidWaveTiming sid_test_wave_timing(uint32_t minResetTicks)
+{
+    SidWaveTiming t = {SID_TEST_T0H, SID_TEST_T0L, SID_TEST_T1H, SID_TEST_T1L, SID_TEST_TOLERANCE, minResetTicks};
+    return t;
+}
+
+// 按描述符重新加载面板并初始化发送器（NVS清空后写入，order/channels 为空取默认）
+inline bool sid_test_setup_panel(uint16_t width, uint16_t height, const uint16_t* order,
+                                 const PanelChannel* channels = nullptr, int channelCount = 0)
+{
+    fake_nvs().clear();
+    if (!panel_save(width, height, order, channels, channelCount) || !panel_load()) {
+        return false;
+    }
+    sid_rmt_init();
+    fake_rmt_reset_stats();
+    return true;
+}
+
+// 默认6x6面板
+inline void sid_test_setup_default_panel(void)
+{
+    fake_nvs().clear();
+    panel_load();
+    sid_rmt_init();
+    fake_rmt_reset_stats();
+}
+
+// 亮度立即到位、关闭重复帧抑制，使每帧都按原值发送
+inline void sid_test_full_brightness(void)
+{
+    lightPower = true;
+    start_brightness_ramp(100, 0, EASE_LINEAR);
+    sid_rmt_set_keepalive_ms(0);
+}
+
+// 面板第 c 个输出通道所用的RMT通道（按引脚查找）
+inline FakeRmtChannel* sid_test_rmt_for_panel_channel(int c)
+{
+    const PanelDescriptor& panel = panel_get();
+    if (c < 0 || c >= panel.channelCount) {
+        return nullptr;
+    }
+    for (int i = 0; i < RMT_CHANNEL_MAX; ++i) {
+        FakeRmtChannel& ch = fake_rmt().ch[i];
+        if (ch.installed && ch.gpio == panel.channels[c].gpio) {
+            return &ch;
+        }
+    }
+    return nullptr;
+}
+
+// 解码通道最近完成的一次传输；rgb 至少容纳该子链的字节数。
+// 复位判定阈值取当前时序档帧头/帧尾中较短者
+inline bool sid_test_decode_last(const FakeRmtChannel* ch, uint8_t* rgb, int capacity, SidDecodedFrame* frame)
+{
+    const SidTimingProfile& timing = sid_rmt_get_timing_profile();
+    uint32_t minResetTicks = timing.headLowTicks < timing.tailLowTicks ? timing.headLowTicks : timing.tailLowTicks;
+    memset(frame, 0, sizeof(*frame));
+    frame->rgb = rgb;
+    frame->rgbCapacity = capacity;
+    if (!ch || ch->lastItemCount == 0) {
+        frame->error = "no transmission";
+        return false;
+    }
+    return sid_wave_decode(ch->lastItems, ch->lastItemCount, sid_test_wave_timing(minResetTicks), frame);
+}
+
+// 各通道最近一次传输解码后按通道顺序拼接为整条链的RGB，返回芯片总数（失败返回-1）
+inline int sid_test_decode_chain(uint8_t* rgb, int capacity, uint16_t* gain = nullptr)
+{
+    const PanelDescriptor& panel = panel_get();
+    int chips = 0;
+    for (int c = 0; c < panel.channelCount; ++c) {
+        SidDecodedFrame frame;
+        if (!sid_test_decode_last(sid_test_rmt_for_panel_channel(c), rgb + chips * 3, capacity - chips * 3, &frame)) {
+            return -1;
+        }
+        chips += frame.chipCount;
+        if (gain) {
+            *gain = frame.gain;
+        }
+    }
+    return chips;
+}
@@ -0,0 +1,143 @@
+// 帧池长时间运行：AnimSystem 初始化后反复切换效果/色温/图层/启停 100万次，
+// 期间堆分配次数为0，帧池占用不变且无切分失败
+#include <unity.h>
+#include <stdlib.h>
+#include "sid_test_support.h"
+#include "anim_system.hpp"
+#include "images.h"
+
+// 统计初始化之后的堆分配：在可执行文件中覆盖 malloc 系列，转发到 glibc 实现
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t n, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+extern "C" void __libc_free(void* ptr);
+
+static volatile bool s_counting = false;
+static volatile uint32_t s_allocations = 0;
+
+extern "C" void* malloc(size_t size)
+{
+    if (s_counting) {
+        s_allocations = s_allocations + 1;
+    }
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t n, size_t size)
+{
+    if (s_counting) {
+        s_allocations = s_allocations + 1;
+    }
+    return __libc_calloc(n, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size)
+{
+    if (s_counting) {
+        s_allocations = s_allocations + 1;
+    }
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void free(void* ptr)
+{
+    __libc_free(ptr);
+}
+#define ALLOCATION_COUNTING 1
+#else
+#define ALLOCATION_COUNTING 0
+#endif
+
+static const uint32_t SWITCHES = 1000000;
+
+void setUp(void)
+{
+    sid_test_setup_default_panel();
+    sid_rmt_set_async(false);
+    sid_test_full_brightness();
+}
+
+void tearDown(void)
+{
+}
+
+void test_effect_switch_soak(void)
+{
+    static AnimSystem anim;
+    anim.init();
+    WhiteStaticEffect white(255);
+    ColorTempEffect cct(10, 3);
+    ImageDataEffect lt3(lt3_data);
+    ImageDataEffect czcx(czcx_data);
+    CandleFlameEffect candle;
+    BreathEffect breath;
+    static uint8_t external[8 * 36 * 3];
+    for (size_t i = 0; i < sizeof(external); ++i) {
+        external[i] = (uint8_t)(i * 7);
+    }
+    AnimEffect* effects[] = {&white, &cct, &lt3, &czcx, &candle, &breath};
+    const int effectCount = sizeof(effects) / sizeof(effects[0]);
+
+    anim.setEffect(&white);
+    anim.start();
+    AnimMemoryStats before = anim.getMemoryStats();
+    TEST_ASSERT_EQUAL_UINT32(0, before.arenaFailures);
+    TEST_ASSERT_TRUE(before.arenaUsed > 0 && before.arenaUsed <= before.arenaBytes);
+
+#if ALLOCATION_COUNTING
+    s_allocations = 0;
+    s_counting = true;
+#endif
+    int layerId = -1;
+    for (uint32_t n = 0; n < SWITCHES; ++n) {
+        anim.setEffect(effects[n % effectCount]);
+        switch (n % 97) {
+            case 0:
+                anim.updateCurrentEffect();
+                break;
+            case 11:
+                anim.updateColorTemp((uint8_t)(1 + n % 61), (uint8_t)(1 + n % 5), (n & 1) != 0);
+                break;
+            case 23:
+                anim.setAnimationData(external, 8);
+                break;
+            case 37:
+                if (layerId < 0) {
+                    layerId = anim.addLayer(&candle, LAYER_ADD, 128);
+                } else {
+                    anim.removeLayer(layerId);
+                    layerId = -1;
+                }
+                break;
+            case 51:
+                // 停止后重新启动：start 会渲染并发布首帧
+                anim.stop();
+                anim.start();
+                break;
+            case 73:
+                anim.setCrossfadeMs((n & 2) ? 0 : 1200);
+                break;
+            default:
+                break;
+        }
+        fake_clock_advance_us(1000);
+    }
+#if ALLOCATION_COUNTING
+    s_counting = false;
+    TEST_ASSERT_EQUAL_UINT32(0, s_allocations);
+#endif
+
+    AnimMemoryStats after = anim.getMemoryStats();
+    TEST_ASSERT_EQUAL_UINT32(before.arenaBytes, after.arenaBytes);
+    TEST_ASSERT_EQUAL_UINT32(before.arenaUsed, after.arenaUsed);
+    TEST_ASSERT_EQUAL_UINT32(0, after.arenaFailures);
+    TEST_ASSERT_TRUE(anim.isRunning());
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_effect_switch_soak);
+    return UNITY_END();
+}
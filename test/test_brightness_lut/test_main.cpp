@@ -0,0 +1,122 @@
+// 亮度缩放表：101档亮度 x 256个码值，线上结果与原逐像素乘法逐位一致；
+// 主机基准对比 36 颗与 1024 颗虚拟链上逐像素乘除与查表的每帧耗时
+#include <unity.h>
+#include <vector>
+#include "sid_test_support.h"
+#include "bench_support.h"
+
+// 原发送路径的逐像素缩放
+static uint8_t reference_scale(uint8_t v, uint8_t brightness)
+{
+    uint16_t scaled = (uint16_t)((v * brightness) / 100);
+    if (scaled > 255) scaled = 255;
+    return (uint8_t)scaled;
+}
+
+void setUp(void)
+{
+    // 16x16 面板：768字节，每个码值在帧内出现3次（R/G/B各一次）
+    sid_test_setup_panel(16, 16, nullptr);
+    sid_rmt_set_async(false);
+    sid_test_full_brightness();
+    sid_power_set_budget_ma(0);
+}
+
+void tearDown(void)
+{
+}
+
+void test_lut_matches_per_pixel_multiply(void)
+{
+    const int size = panel_frame_size();
+    uint8_t frame[PANEL_MAX_CHIPS * 3];
+    uint8_t decoded[PANEL_MAX_CHIPS * 3];
+    for (int i = 0; i < size; ++i) {
+        frame[i] = (uint8_t)i;
+    }
+    for (int b = 0; b <= 100; ++b) {
+        lightPower = true;
+        start_brightness_ramp((uint8_t)b, 0, EASE_LINEAR);
+        send_chain_data(frame, size, 0xFFFF);
+        TEST_ASSERT_EQUAL_INT(panel_chip_count(), sid_test_decode_chain(decoded, sizeof(decoded)));
+        for (int i = 0; i < size; ++i) {
+            if (decoded[i] != reference_scale(frame[i], (uint8_t)b)) {
+                char msg[64];
+                snprintf(msg, sizeof(msg), "brightness %d, value %u", b, frame[i]);
+                TEST_ASSERT_EQUAL_UINT8_MESSAGE(reference_scale(frame[i], (uint8_t)b), decoded[i], msg);
+            }
+        }
+    }
+}
+
+// 亮度变化后缩放表随之重建，不沿用上一档
+void test_lut_rebuilt_on_brightness_change(void)
+{
+    const int size = panel_frame_size();
+    uint8_t frame[PANEL_MAX_CHIPS * 3];
+    uint8_t decoded[PANEL_MAX_CHIPS * 3];
+    memset(frame, 200, size);
+    const uint8_t levels[] = {100, 37, 37, 100, 1, 99};
+    for (size_t k = 0; k < sizeof(levels); ++k) {
+        start_brightness_ramp(levels[k], 0, EASE_LINEAR);
+        send_chain_data(frame, size, 0xFFFF);
+        TEST_ASSERT_EQUAL_INT(panel_chip_count(), sid_test_decode_chain(decoded, sizeof(decoded)));
+        TEST_ASSERT_EQUAL_UINT8(reference_scale(200, levels[k]), decoded[0]);
+        TEST_ASSERT_EQUAL_UINT8(reference_scale(200, levels[k]), decoded[size - 1]);
+    }
+}
+
+// 每帧缩放耗时：原逐像素乘法+除以100+钳位，与按亮度预先建好的256项缩放表
+void test_scale_cost(void)
+{
+    const uint8_t brightness = 37;
+    uint8_t lut[256];
+    for (int v = 0; v < 256; ++v) {
+        lut[v] = reference_scale((uint8_t)v, brightness);
+    }
+    const int chipCounts[] = {36, 1024};
+    for (size_t n = 0; n < sizeof(chipCounts) / sizeof(chipCounts[0]); ++n) {
+        const int size = chipCounts[n] * 3;
+        std::vector<uint8_t> src(size);
+        std::vector<uint8_t> dst(size);
+        for (int i = 0; i < size; ++i) {
+            src[i] = (uint8_t)(i * 151 + 3);
+        }
+        volatile uint8_t level = brightness;
+        volatile uint32_t sink = 0;
+        const int iterations = 4096 / chipCounts[n] + 64;
+
+        BenchResult multiply = bench_best([&](int) {
+            uint8_t b = level;
+            for (int i = 0; i < size; ++i) {
+                uint16_t scaled = (uint16_t)((src[i] * b) / 100);
+                if (scaled > 255) scaled = 255;
+                dst[i] = (uint8_t)scaled;
+            }
+            sink = sink + dst[size / 2];
+        }, iterations);
+        BenchResult table = bench_best([&](int) {
+            for (int i = 0; i < size; ++i) {
+                dst[i] = lut[src[i]];
+            }
+            sink = sink + dst[size / 2];
+        }, iterations);
+
+        for (int i = 0; i < size; ++i) {
+            TEST_ASSERT_EQUAL_UINT8(reference_scale(src[i], brightness), dst[i]);
+        }
+        char msg[160];
+        snprintf(msg, sizeof(msg), "%4d chips/frame: multiply %.0f ns (%.2f ns/pixel), table %.0f ns (%.2f ns/pixel)",
+                 chipCounts[n], multiply.ns, multiply.ns / chipCounts[n], table.ns, table.ns / chipCounts[n]);
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_lut_matches_per_pixel_multiply);
+    RUN_TEST(test_lut_rebuilt_on_brightness_change);
+    RUN_TEST(test_scale_cost);
+    return UNITY_END();
+}
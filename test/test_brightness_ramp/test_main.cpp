@@ -0,0 +1,144 @@
+// 亮度斜坡：途中重新定向时亮度连续（定向时刻取值不变、之后逐毫秒变化有界）；
+// 暂停期间保持不变，恢复后从暂停值走完剩余时长；发送路径在色温过渡冻结亮度期间暂停斜坡，解冻时不跳变
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <esp_timer.h>
+#include "sid_test_support.h"
+#include "brightness_ramp.h"
+
+extern bool g_anim_brightnessFreezeActive;
+
+static const EaseCurve EASES[] = {EASE_LINEAR, EASE_IN_CUBIC, EASE_OUT_CUBIC,
+                                  EASE_IN_OUT_CUBIC, EASE_IN_OUT_EXPO, EASE_PERCEPTUAL};
+static const int EASE_COUNT = sizeof(EASES) / sizeof(EASES[0]);
+
+// 时长 >=1000ms 时各曲线最陡处每毫秒不超过1级（Q8 256）
+#define RAMP_MAX_STEP_Q8_PER_MS 256
+// 定向时刻的起点取当前值；CIE L* 曲线的明度往返换算有定点舍入（远小于1级）
+#define RETARGET_TOLERANCE_Q8 4
+#define FRAME_US 20000
+
+void setUp(void)
+{
+    sid_test_setup_default_panel();
+    g_anim_brightnessFreezeActive = false;
+}
+
+void tearDown(void)
+{
+    g_anim_brightnessFreezeActive = false;
+}
+
+// 0->100 斜坡途中两次重新定向（换目标、换曲线），逐毫秒取值：定向时刻取值不变，相邻毫秒变化有界
+void test_retarget_mid_ramp_is_continuous(void)
+{
+    for (int a = 0; a < EASE_COUNT; ++a) {
+        for (int b = 0; b < EASE_COUNT; ++b) {
+            BrightnessRamp ramp;
+            brightness_ramp_init(&ramp, 0);
+            const uint64_t t0 = 5000000;
+            brightness_ramp_retarget(&ramp, 100, 1000, EASES[a], t0);
+            uint32_t prev = brightness_ramp_value_q8(&ramp, t0);
+            TEST_ASSERT_EQUAL_UINT32(0, prev);
+            for (uint32_t ms = 1; ms <= 4000; ++ms) {
+                uint64_t now = t0 + (uint64_t)ms * 1000;
+                if (ms == 437 || ms == 1203) {
+                    uint32_t before = brightness_ramp_value_q8(&ramp, now);
+                    brightness_ramp_retarget(&ramp, ms == 437 ? 20 : 90, 1500, EASES[b], now);
+                    TEST_ASSERT_UINT_WITHIN(RETARGET_TOLERANCE_Q8, before, brightness_ramp_value_q8(&ramp, now));
+                }
+                uint32_t v = brightness_ramp_value_q8(&ramp, now);
+                if (abs((int32_t)v - (int32_t)prev) > RAMP_MAX_STEP_Q8_PER_MS) {
+                    char msg[80];
+                    snprintf(msg, sizeof(msg), "ease %d -> %d at %u ms: %u -> %u", a, b, (unsigned)ms,
+                             (unsigned)prev, (unsigned)v);
+                    TEST_FAIL_MESSAGE(msg);
+                }
+                prev = v;
+            }
+            TEST_ASSERT_TRUE(brightness_ramp_done(&ramp, t0 + 4000000));
+            TEST_ASSERT_EQUAL_UINT8(90, brightness_ramp_value(&ramp, t0 + 4000000));
+        }
+    }
+}
+
+// 暂停期间取值不变、斜坡未完成；恢复后从暂停值继续，完成时刻后移暂停时长；暂停中重新定向以暂停值为起点
+void test_pause_holds_and_resume_continues(void)
+{
+    BrightnessRamp ramp;
+    brightness_ramp_init(&ramp, 0);
+    brightness_ramp_retarget(&ramp, 100, 1000, EASE_LINEAR, 0);
+    brightness_ramp_pause(&ramp, 250000);
+    const uint32_t held = brightness_ramp_value_q8(&ramp, 250000);
+    TEST_ASSERT_EQUAL_UINT32(25 << 8, held);
+    for (uint64_t now = 250000; now <= 2000000; now += 50000) {
+        TEST_ASSERT_EQUAL_UINT32(held, brightness_ramp_value_q8(&ramp, now));
+        TEST_ASSERT_FALSE(brightness_ramp_done(&ramp, now));
+    }
+    // 重复暂停不改变暂停时刻
+    brightness_ramp_pause(&ramp, 900000);
+    brightness_ramp_resume(&ramp, 2000000);
+    TEST_ASSERT_EQUAL_UINT32(held, brightness_ramp_value_q8(&ramp, 2000000));
+    TEST_ASSERT_EQUAL_UINT32((125 << 8) / 2, brightness_ramp_value_q8(&ramp, 2375000));
+    TEST_ASSERT_FALSE(brightness_ramp_done(&ramp, 2749999));
+    TEST_ASSERT_TRUE(brightness_ramp_done(&ramp, 2750000));
+    // 未暂停时恢复不改变时间线
+    brightness_ramp_resume(&ramp, 5000000);
+    TEST_ASSERT_EQUAL_UINT8(100, brightness_ramp_value(&ramp, 5000000));
+
+    brightness_ramp_retarget(&ramp, 0, 1000, EASE_LINEAR, 6000000);
+    brightness_ramp_pause(&ramp, 6500000);
+    brightness_ramp_retarget(&ramp, 100, 1000, EASE_LINEAR, 7000000);
+    TEST_ASSERT_EQUAL_UINT32(50 << 8, brightness_ramp_value_q8(&ramp, 7500000));
+    brightness_ramp_resume(&ramp, 8000000);
+    TEST_ASSERT_EQUAL_UINT32(50 << 8, brightness_ramp_value_q8(&ramp, 8000000));
+    TEST_ASSERT_EQUAL_UINT32(75 << 8, brightness_ramp_value_q8(&ramp, 8500000));
+}
+
+// 发送路径逐帧取亮度：斜坡途中冻结，冻结期间保持，解冻后从冻结值继续，相邻帧变化不超过斜坡自身的每帧步长
+void test_freeze_pauses_send_path_ramp(void)
+{
+    lightPower = true;
+    start_brightness_ramp(0, 0, EASE_LINEAR);
+    get_brightness_frame();
+    start_brightness_ramp(100, 1000, EASE_LINEAR);
+    const uint64_t startUs = (uint64_t)esp_timer_get_time();
+    const int maxStep = (int)((100 * FRAME_US / 1000 + 999) / 1000);
+    int prev = get_brightness_frame();
+    int held = -1;
+    uint64_t doneUs = 0;
+    for (int f = 1; f <= 200 && doneUs == 0; ++f) {
+        fake_clock_advance_us(FRAME_US);
+        uint64_t nowUs = (uint64_t)esp_timer_get_time();
+        // 第20帧（400ms）起冻结 2s
+        g_anim_brightnessFreezeActive = f >= 20 && f < 120;
+        int b = get_brightness_frame();
+        char msg[48];
+        snprintf(msg, sizeof(msg), "frame %d: %d -> %d", f, prev, b);
+        TEST_ASSERT_TRUE_MESSAGE(abs(b - prev) <= maxStep, msg);
+        if (g_anim_brightnessFreezeActive) {
+            if (held < 0) {
+                held = b;
+            }
+            TEST_ASSERT_EQUAL_INT_MESSAGE(held, b, msg);
+            TEST_ASSERT_TRUE(brightness_ramp_active());
+        } else if (!brightness_ramp_active()) {
+            TEST_ASSERT_EQUAL_INT(100, b);
+            doneUs = nowUs;
+        }
+        prev = b;
+    }
+    TEST_ASSERT_EQUAL_INT(40, held);
+    // 斜坡总时长 = 1000ms + 冻结时长（100帧）
+    TEST_ASSERT_EQUAL_UINT32(1000000 + 100 * FRAME_US, (uint32_t)(doneUs - startUs));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_retarget_mid_ramp_is_continuous);
+    RUN_TEST(test_pause_holds_and_resume_continues);
+    RUN_TEST(test_freeze_pauses_send_path_ramp);
+    return UNITY_END();
+}
@@ -0,0 +1,224 @@
+// 连续色温/DUV引擎：格点处与表值逐位一致，格内与双精度双线性插值一致，
+// 沿色温与DUV方向连续（跨格边界、跨 6500K 步长变化处无跳变）；主机基准报告每次调用的耗时与周期数
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_support.h"
+#include "cct_engine.h"
+
+#define BENCH_INPUTS 4096
+
+// 格点 (row 0..60, col 0..4) 的8位分量
+static int grid(int row, int col, int channel)
+{
+    uint8_t rgb[3];
+    TEST_ASSERT_TRUE(cct_grid_rgb8((uint8_t)(row + 1), (uint8_t)(col + 1), &rgb[0], &rgb[1], &rgb[2]));
+    return rgb[channel];
+}
+
+// DUV（1e-5）-> 连续列坐标：+0.006 为第0列，每 0.003 一列
+static double duv_to_col(int duvE5)
+{
+    return (CCT_DUV_MAX_E5 - duvE5) / (double)CCT_DUV_STEP_E5;
+}
+
+// 双精度参考：格内双线性插值，结果换算到12位
+static double reference_rgb12(double row, double col, int channel)
+{
+    int r0 = (int)row;
+    int c0 = (int)col;
+    if (r0 > CCT_STEP_COUNT - 2) r0 = CCT_STEP_COUNT - 2;
+    if (c0 > CCT_DUV_VARIANTS - 2) c0 = CCT_DUV_VARIANTS - 2;
+    double fx = row - r0;
+    double fy = col - c0;
+    double v = grid(r0, c0, channel) * (1 - fx) * (1 - fy) + grid(r0, c0 + 1, channel) * (1 - fx) * fy +
+               grid(r0 + 1, c0, channel) * fx * (1 - fy) + grid(r0 + 1, c0 + 1, channel) * fx * fy;
+    return v * CCT_RGB12_MAX / 255.0;
+}
+
+// 格内沿某一方向移动 1/steps 格时12位输出的最大变化：相邻格点差按比例分摊，另加舍入
+static int max_step_delta(int row, int col, int channel, bool alongRow, double steps)
+{
+    int d0;
+    int d1;
+    if (alongRow) {
+        d0 = abs(grid(row + 1, col, channel) - grid(row, col, channel));
+        d1 = abs(grid(row + 1, col + 1, channel) - grid(row, col + 1, channel));
+    } else {
+        d0 = abs(grid(row, col + 1, channel) - grid(row, col, channel));
+        d1 = abs(grid(row + 1, col + 1, channel) - grid(row + 1, col, channel));
+    }
+    int d = d0 > d1 ? d0 : d1;
+    return (int)ceil(d * CCT_RGB12_MAX / 255.0 / steps) + 1;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_grid_points_exact(void)
+{
+    for (int t = 1; t <= CCT_STEP_COUNT; ++t) {
+        for (int d = 1; d <= CCT_DUV_VARIANTS; ++d) {
+            uint8_t r, g, b;
+            TEST_ASSERT_TRUE(cct_grid_rgb8((uint8_t)t, (uint8_t)d, &r, &g, &b));
+            int16_t duvE5 = (int16_t)(CCT_DUV_MAX_E5 - (d - 1) * CCT_DUV_STEP_E5);
+            uint16_t rgb[3];
+            cct_kelvin_rgb12(cct_step_kelvin((uint8_t)t), duvE5, rgb);
+            TEST_ASSERT_EQUAL_UINT16(cct_rgb8_to_12(r), rgb[0]);
+            TEST_ASSERT_EQUAL_UINT16(cct_rgb8_to_12(g), rgb[1]);
+            TEST_ASSERT_EQUAL_UINT16(cct_rgb8_to_12(b), rgb[2]);
+            cct_rgb12_at((uint16_t)((t - 1) << 8), duvE5, rgb);
+            TEST_ASSERT_EQUAL_UINT16(cct_rgb8_to_12(r), rgb[0]);
+            TEST_ASSERT_EQUAL_UINT16(cct_rgb8_to_12(g), rgb[1]);
+            TEST_ASSERT_EQUAL_UINT16(cct_rgb8_to_12(b), rgb[2]);
+        }
+    }
+    for (int v = 0; v < 256; ++v) {
+        TEST_ASSERT_EQUAL_UINT16(lround(v * 4095.0 / 255), cct_rgb8_to_12((uint8_t)v));
+    }
+    uint8_t r, g, b;
+    TEST_ASSERT_FALSE(cct_grid_rgb8(0, 1, &r, &g, &b));
+    TEST_ASSERT_FALSE(cct_grid_rgb8(CCT_STEP_COUNT + 1, 1, &r, &g, &b));
+    TEST_ASSERT_FALSE(cct_grid_rgb8(1, CCT_DUV_VARIANTS + 1, &r, &g, &b));
+}
+
+// 格内任意位置与双精度双线性插值相差不超过半个12位码值（列坐标与引擎一样取 Q8）
+void test_bilinear_matches_double(void)
+{
+    double maxErr = 0;
+    for (int pos = 0; pos <= (CCT_STEP_COUNT - 1) * 256; ++pos) {
+        for (int duv = -CCT_DUV_MAX_E5; duv <= CCT_DUV_MAX_E5; duv += 7) {
+            uint16_t rgb[3];
+            cct_rgb12_at((uint16_t)pos, (int16_t)duv, rgb);
+            for (int c = 0; c < 3; ++c) {
+                double err = fabs(rgb[c] - reference_rgb12(pos / 256.0, floor(duv_to_col(duv) * 256) / 256, c));
+                if (err > maxErr) {
+                    maxErr = err;
+                }
+            }
+        }
+    }
+    TEST_ASSERT_TRUE(maxErr <= 0.5 + 1e-9);
+}
+
+// 沿色温方向每走 1/256 档，输出变化不超过所在格的边差按比例分摊（跨格边界同样成立）
+void test_continuous_along_cct(void)
+{
+    for (int duv = -CCT_DUV_MAX_E5; duv <= CCT_DUV_MAX_E5; duv += 50) {
+        int col = (int)duv_to_col(duv);
+        if (col > CCT_DUV_VARIANTS - 2) col = CCT_DUV_VARIANTS - 2;
+        uint16_t prev[3];
+        cct_rgb12_at(0, (int16_t)duv, prev);
+        for (int pos = 1; pos <= (CCT_STEP_COUNT - 1) * 256; ++pos) {
+            uint16_t rgb[3];
+            cct_rgb12_at((uint16_t)pos, (int16_t)duv, rgb);
+            int row = (pos - 1) >> 8;
+            for (int c = 0; c < 3; ++c) {
+                int delta = abs((int)rgb[c] - (int)prev[c]);
+                if (delta > max_step_delta(row, col, c, true, 256)) {
+                    char msg[80];
+                    snprintf(msg, sizeof(msg), "pos %d duv %d channel %d jumped %d", pos, duv, c, delta);
+                    TEST_FAIL_MESSAGE(msg);
+                }
+                prev[c] = rgb[c];
+            }
+        }
+    }
+}
+
+// 沿DUV方向每走 1e-5，输出变化不超过所在格的边差按比例分摊（跨列边界同样成立）
+void test_continuous_along_duv(void)
+{
+    for (int pos = 0; pos <= (CCT_STEP_COUNT - 1) * 256; pos += 37) {
+        int row = pos >> 8;
+        if (row > CCT_STEP_COUNT - 2) row = CCT_STEP_COUNT - 2;
+        uint16_t prev[3];
+        cct_rgb12_at((uint16_t)pos, CCT_DUV_MAX_E5, prev);
+        for (int duv = CCT_DUV_MAX_E5 - 1; duv >= -CCT_DUV_MAX_E5; --duv) {
+            uint16_t rgb[3];
+            cct_rgb12_at((uint16_t)pos, (int16_t)duv, rgb);
+            int col = (CCT_DUV_MAX_E5 - duv - 1) / CCT_DUV_STEP_E5;
+            for (int c = 0; c < 3; ++c) {
+                int delta = abs((int)rgb[c] - (int)prev[c]);
+                if (delta > max_step_delta(row, col, c, false, CCT_DUV_STEP_E5)) {
+                    char msg[80];
+                    snprintf(msg, sizeof(msg), "pos %d duv %d channel %d jumped %d", pos, duv, c, delta);
+                    TEST_FAIL_MESSAGE(msg);
+                }
+                prev[c] = rgb[c];
+            }
+        }
+    }
+}
+
+// 色温（K）-> 档位坐标单调不减、逐K前进量有界（6500K 处步长变化不跳变），超出范围钳位
+void test_kelvin_mapping_continuous(void)
+{
+    TEST_ASSERT_EQUAL_UINT16(0, cct_kelvin_to_pos_q8(0));
+    TEST_ASSERT_EQUAL_UINT16(0, cct_kelvin_to_pos_q8(CCT_KELVIN_MIN));
+    TEST_ASSERT_EQUAL_UINT16(49 * 256, cct_kelvin_to_pos_q8(6500));
+    TEST_ASSERT_EQUAL_UINT16((CCT_STEP_COUNT - 1) * 256, cct_kelvin_to_pos_q8(CCT_KELVIN_MAX));
+    TEST_ASSERT_EQUAL_UINT16((CCT_STEP_COUNT - 1) * 256, cct_kelvin_to_pos_q8(65535));
+    uint16_t prev = cct_kelvin_to_pos_q8(CCT_KELVIN_MIN);
+    for (uint32_t k = CCT_KELVIN_MIN + 1; k <= CCT_KELVIN_MAX; ++k) {
+        uint16_t pos = cct_kelvin_to_pos_q8((uint16_t)k);
+        TEST_ASSERT_TRUE(pos >= prev);
+        // 6500K 以下每100K一档（2.56/K），以上每500K一档（0.512/K）
+        TEST_ASSERT_TRUE(pos - prev <= (k <= 6500 ? 3 : 1));
+        prev = pos;
+    }
+    // 档位标称色温落在对应格点上
+    for (int t = 1; t <= CCT_STEP_COUNT; ++t) {
+        TEST_ASSERT_EQUAL_UINT16((t - 1) * 256, cct_kelvin_to_pos_q8(cct_step_kelvin((uint8_t)t)));
+    }
+}
+
+// 每次调用耗时：色温与DUV取遍全范围的伪随机序列（避免同一格反复命中），
+// 目标为几百个周期以内（周期数仅在 x86 主机上可得）
+void test_kelvin_rgb12_cost(void)
+{
+    static uint16_t kelvins[BENCH_INPUTS];
+    static int16_t duvs[BENCH_INPUTS];
+    static uint16_t positions[BENCH_INPUTS];
+    srand(21);
+    for (int i = 0; i < BENCH_INPUTS; ++i) {
+        kelvins[i] = (uint16_t)(CCT_KELVIN_MIN + rand() % (CCT_KELVIN_MAX - CCT_KELVIN_MIN + 1));
+        duvs[i] = (int16_t)(rand() % (2 * CCT_DUV_MAX_E5 + 1) - CCT_DUV_MAX_E5);
+        positions[i] = cct_kelvin_to_pos_q8(kelvins[i]);
+    }
+    volatile uint32_t sink = 0;
+    uint16_t rgb[3];
+    BenchResult kelvin = bench_best([&](int i) {
+        cct_kelvin_rgb12(kelvins[i], duvs[i], rgb);
+        sink = sink + rgb[0] + rgb[1] + rgb[2];
+    }, BENCH_INPUTS);
+    BenchResult at = bench_best([&](int i) {
+        cct_rgb12_at(positions[i], duvs[i], rgb);
+        sink = sink + rgb[0] + rgb[1] + rgb[2];
+    }, BENCH_INPUTS);
+    char msg[160];
+    snprintf(msg, sizeof(msg), "cct_kelvin_rgb12 %.1f ns (%.0f cycles)/call, cct_rgb12_at %.1f ns (%.0f cycles)/call",
+             kelvin.ns, kelvin.cycles, at.ns, at.cycles);
+    TEST_MESSAGE(msg);
+    if (kelvin.cycles > 0) {
+        TEST_ASSERT_TRUE(kelvin.cycles < 300);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_grid_points_exact);
+    RUN_TEST(test_bilinear_matches_double);
+    RUN_TEST(test_continuous_along_cct);
+    RUN_TEST(test_continuous_along_duv);
+    RUN_TEST(test_kelvin_mapping_continuous);
+    RUN_TEST(test_kelvin_rgb12_cost);
+    return UNITY_END();
+}
@@ -0,0 +1,137 @@
+// 色温表：编译前生成的 cct_table.h 与实测数据 src/INDEX DUV R G B.txt 逐行一致，
+// ColorTemperatureManager 按索引/档位查询得到同一行
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "cct_table.h"
+#include "color_temperature.h"
+
+#define CCT_TXT_NAME "src/INDEX DUV R G B.txt"
+
+struct MeasuredRow {
+    int index;
+    double duv;
+    int r, g, b;
+};
+
+static MeasuredRow s_rows[CCT_TABLE_STEPS * CCT_TABLE_DUV_VARIANTS + 1];
+static int s_rowCount = 0;
+
+// 测试从项目根目录运行；否则按本文件位置找到项目根目录
+static FILE* open_measured_table(void)
+{
+    FILE* f = fopen(CCT_TXT_NAME, "r");
+    if (f) {
+        return f;
+    }
+    char path[512];
+    const char* slash = strrchr(__FILE__, '/');
+    int dirLen = slash ? (int)(slash - __FILE__) : 0;
+    snprintf(path, sizeof(path), "%.*s/../../" CCT_TXT_NAME, dirLen, __FILE__);
+    return fopen(path, "r");
+}
+
+// 读取实测表（表头 INDEX DUV R G B，其后每行一条），行数超出上限时停止
+static int load_measured_table(void)
+{
+    FILE* f = open_measured_table();
+    if (!f) {
+        return -1;
+    }
+    char header[64];
+    if (!fgets(header, sizeof(header), f)) {
+        fclose(f);
+        return -1;
+    }
+    int count = 0;
+    MeasuredRow row;
+    while (count < (int)(sizeof(s_rows) / sizeof(s_rows[0])) &&
+           fscanf(f, "%d %lf %d %d %d", &row.index, &row.duv, &row.r, &row.g, &row.b) == 5) {
+        s_rows[count++] = row;
+    }
+    fclose(f);
+    return count;
+}
+
+static uint16_t expected_step_kelvin(int step)
+{
+    return (uint16_t)(step <= 50 ? 1600 + (step - 1) * 100 : 6500 + (step - 50) * 500);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_table_matches_measured_rows(void)
+{
+    TEST_ASSERT_EQUAL_INT_MESSAGE(CCT_TABLE_STEPS * CCT_TABLE_DUV_VARIANTS, s_rowCount, CCT_TXT_NAME);
+    for (int i = 0; i < s_rowCount; ++i) {
+        const MeasuredRow& row = s_rows[i];
+        char msg[64];
+        snprintf(msg, sizeof(msg), "row %d", i + 1);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(i + 1, row.index, msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(row.r, CCT_TABLE_RGB[i][0], msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(row.g, CCT_TABLE_RGB[i][1], msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(row.b, CCT_TABLE_RGB[i][2], msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(lround(row.duv * 100000), CCT_TABLE_DUV_E5[i % CCT_TABLE_DUV_VARIANTS], msg);
+    }
+}
+
+void test_manager_matches_measured_rows(void)
+{
+    ColorTemperatureManager manager;
+    TEST_ASSERT_TRUE(manager.init());
+    TEST_ASSERT_EQUAL_INT(s_rowCount, manager.getTotalCount());
+    for (int i = 0; i < s_rowCount; ++i) {
+        const MeasuredRow& row = s_rows[i];
+        int step = i / CCT_TABLE_DUV_VARIANTS + 1;
+        int duvIndex = i % CCT_TABLE_DUV_VARIANTS + 1;
+        char msg[64];
+        snprintf(msg, sizeof(msg), "row %d", i + 1);
+
+        ColorTemperature ct;
+        TEST_ASSERT_TRUE_MESSAGE(manager.getColorTempByIndex((uint16_t)i, ct), msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(row.r, ct.r, msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(row.g, ct.g, msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(row.b, ct.b, msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(lround(row.duv * 100000), ct.duvE5, msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(expected_step_kelvin(step), ct.kelvin, msg);
+
+        // 串口协议路径（0xA0/0xDA）：档位 + DUV索引
+        uint8_t r, g, b;
+        TEST_ASSERT_TRUE_MESSAGE(ColorTemperatureManager::isValidStep((uint8_t)step, (uint8_t)duvIndex), msg);
+        TEST_ASSERT_TRUE_MESSAGE(ColorTemperatureManager::getStepRGB((uint8_t)step, (uint8_t)duvIndex, &r, &g, &b), msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(row.r, r, msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(row.g, g, msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(row.b, b, msg);
+
+        // 色温取最近档位
+        TEST_ASSERT_EQUAL_INT_MESSAGE(i, ColorTemperatureManager::kelvinDuvToIndex(ct.kelvin, (DuvDirection)(duvIndex - 1)), msg);
+    }
+}
+
+void test_step_out_of_range(void)
+{
+    uint8_t r = 1, g = 1, b = 1;
+    TEST_ASSERT_FALSE(ColorTemperatureManager::isValidStep(0, 3));
+    TEST_ASSERT_FALSE(ColorTemperatureManager::isValidStep(CCT_TABLE_STEPS + 1, 3));
+    TEST_ASSERT_FALSE(ColorTemperatureManager::isValidStep(1, 0));
+    TEST_ASSERT_FALSE(ColorTemperatureManager::isValidStep(1, CCT_TABLE_DUV_VARIANTS + 1));
+    TEST_ASSERT_FALSE(ColorTemperatureManager::getStepRGB(0, 3, &r, &g, &b));
+    TEST_ASSERT_EQUAL_INT(0, r | g | b);
+}
+
+int main(void)
+{
+    s_rowCount = load_measured_table();
+    UNITY_BEGIN();
+    RUN_TEST(test_table_matches_measured_rows);
+    RUN_TEST(test_manager_matches_measured_rows);
+    RUN_TEST(test_step_out_of_range);
+    return UNITY_END();
+}
@@ -0,0 +1,154 @@
+// 链序存帧：各内置效果经链序路径发送的线上数据与原矩阵序逐像素映射发送一致
+#include <unity.h>
+#include "sid_test_support.h"
+#include "anim_effect.hpp"
+#include "images.h"
+#include "color_temperature.h"
+
+// 原发送路径的矩阵序->链序映射表（默认6x6面板）
+static const uint8_t OLD_LED_MATRIX_PATTERN[36] = {
+    0x0C, 0x06, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x0B, 0x11, 0x0D, 0x07,
+    0x08, 0x09, 0x0E, 0x0F, 0x0A, 0x10, 0x17, 0x1D, 0x23, 0x22, 0x21, 0x20,
+    0x1F, 0x1E, 0x18, 0x12, 0x16, 0x1C, 0x1B, 0x1A, 0x15, 0x14, 0x19, 0x13
+};
+
+static int s_frames_checked = 0;
+
+void setUp(void)
+{
+    sid_test_setup_default_panel();
+    sid_rmt_set_async(false);
+    sid_test_full_brightness();
+    sid_power_set_budget_ma(0);
+}
+
+void tearDown(void)
+{
+}
+
+// 与 AnimSystem::renderEffectFrame 相同：常驻帧直接读取，否则渲染后转换为链序
+static void render_chain_frame(AnimEffect* effect, int index, uint8_t* dst, int frameSize)
+{
+    uint8_t matrix[PANEL_MAX_CHIPS * 3];
+    const uint8_t* src = effect->frameData(index);
+    if (!src) {
+        effect->renderFrame(index, matrix, frameSize);
+        src = matrix;
+    }
+    if (effect->isChainOrder()) {
+        memcpy(dst, src, frameSize);
+    } else {
+        sid_matrix_to_chain(src, dst, frameSize);
+    }
+}
+
+// 逐帧比较：旧路径 send_data(矩阵序) 与新路径 send_chain_data(链序) 的RMT item逐个相同，
+// 且解码结果等于按原映射表逐像素取值
+static void check_effect(AnimEffect* effect)
+{
+    const int frameSize = panel_frame_size();
+    uint8_t matrix[PANEL_MAX_CHIPS * 3];
+    uint8_t chain[PANEL_MAX_CHIPS * 3];
+    uint8_t decoded[PANEL_MAX_CHIPS * 3];
+    static uint32_t oldItems[FAKE_RMT_MAX_ITEMS];
+    FakeRmtChannel* ch = sid_test_rmt_for_panel_channel(0);
+    TEST_ASSERT_NOT_NULL(ch);
+
+    for (int f = 0; f < effect->getFrameCount(); ++f) {
+        const uint8_t* src = effect->frameData(f);
+        if (src) {
+            memcpy(matrix, src, frameSize);
+        } else {
+            effect->renderFrame(f, matrix, frameSize);
+        }
+
+        send_data(matrix, frameSize, 0xFFFF);
+        int oldCount = ch->lastItemCount;
+        memcpy(oldItems, ch->lastItems, oldCount * sizeof(uint32_t));
+
+        render_chain_frame(effect, f, chain, frameSize);
+        send_chain_data(chain, frameSize, 0xFFFF);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(oldCount, ch->lastItemCount, effect->getName());
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(oldItems, ch->lastItems, oldCount * sizeof(uint32_t), effect->getName());
+
+        TEST_ASSERT_EQUAL_INT(36, sid_test_decode_chain(decoded, sizeof(decoded)));
+        for (int i = 0; i < 36; ++i) {
+            const uint8_t* px = &matrix[OLD_LED_MATRIX_PATTERN[i] * 3];
+            TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(px, &decoded[i * 3], 3, effect->getName());
+        }
+        ++s_frames_checked;
+    }
+}
+
+void test_default_panel_uses_old_pattern(void)
+{
+    const PanelDescriptor& panel = panel_get();
+    TEST_ASSERT_EQUAL_INT(36, panel.chipCount);
+    for (int i = 0; i < 36; ++i) {
+        TEST_ASSERT_EQUAL_UINT16(OLD_LED_MATRIX_PATTERN[i], panel.chainOrder[i]);
+    }
+}
+
+void test_static_effects(void)
+{
+    WhiteStaticEffect white(255);
+    check_effect(&white);
+    WhiteStaticEffect dim(17);
+    check_effect(&dim);
+    for (uint8_t t = 1; t <= COLOR_TEMP_STANDARD_COUNT; t += 6) {
+        for (uint8_t d = 1; d <= 5; ++d) {
+            ColorTempEffect cct(t, d);
+            check_effect(&cct);
+        }
+    }
+}
+
+void test_animated_effects(void)
+{
+    BreathEffect breath;
+    check_effect(&breath);
+    BreathEffect breathBlue(10, 40, 250, 37);
+    check_effect(&breathBlue);
+    CandleFlameEffect candle;
+    check_effect(&candle);
+}
+
+void test_image_assets(void)
+{
+    ImageDataEffect img(img1_data);
+    ImageDataEffect czcx(czcx_data);
+    ImageDataEffect jl3(jl3_data);
+    ImageDataEffect lt2(lt2_data);
+    ImageDataEffect lt3(lt3_data);
+    ImageDataEffect* assets[] = {&img, &czcx, &jl3, &lt2, &lt3};
+    for (ImageDataEffect* asset : assets) {
+        TEST_ASSERT_TRUE_MESSAGE(asset->isValid(), asset->getError());
+        check_effect(asset);
+    }
+}
+
+void test_external_frame_data(void)
+{
+    const int frames = 16;
+    static uint8_t data[16 * 36 * 3];
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+    FrameDataEffect effect;
+    effect.setData(data, frames);
+    check_effect(&effect);
+    TEST_ASSERT_GREATER_THAN_INT(frames, s_frames_checked);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_default_panel_uses_old_pattern);
+    RUN_TEST(test_static_effects);
+    RUN_TEST(test_animated_effects);
+    RUN_TEST(test_image_assets);
+    RUN_TEST(test_external_frame_data);
+    return UNITY_END();
+}
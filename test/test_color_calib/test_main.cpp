@@ -0,0 +1,227 @@
+// 颜色校准：定点实现与按定义逐项计算的参考逐位一致（随机矩阵 + 典型矩阵下全部 2^24 输入），
+// 单位矩阵不改变码值，黑色芯片保持熄灭；发送路径上线上码值同样符合定义；
+// 主机基准：1024颗芯片每帧校正耗时不超出帧线上时长的预算
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sid_test_support.h"
+#include "bench_support.h"
+#include "color_calib.h"
+
+// 向下取整除法（定义中的 round 取 floor(x + 0.5)）
+static long floor_div(long a, long b)
+{
+    long q = a / b;
+    if ((a % b) != 0 && ((a < 0) != (b < 0))) {
+        q--;
+    }
+    return q;
+}
+
+// 参考：out[c] = clamp(round(sum_k m[c*3+k]*in[k] / ONE) + offset[c], 0, 255)，输入全黑时不变
+static uint8_t reference_channel(const ColorCalib& calib, int row, const uint8_t in[3])
+{
+    if (in[0] == 0 && in[1] == 0 && in[2] == 0) {
+        return 0;
+    }
+    long sum = 0;
+    for (int k = 0; k < 3; ++k) {
+        sum += (long)calib.m[row * 3 + k] * in[k];
+    }
+    long v = floor_div(sum + COLOR_CALIB_ONE / 2, COLOR_CALIB_ONE) + calib.offset[row];
+    return (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+static const int16_t TYPICAL_MATRIX[9] = {3900, 150, -50, 80, 4000, 16, -30, 120, 3950};
+
+void setUp(void)
+{
+    sid_test_setup_default_panel();
+    sid_rmt_set_async(false);
+    sid_test_full_brightness();
+}
+
+void tearDown(void)
+{
+    ColorCalib identity;
+    color_calib_identity(&identity);
+    sid_calib_set(&identity, false);
+}
+
+// 随机矩阵（全范围系数 / 单位矩阵附近）与随机偏移，随机像素中混入黑色与全白
+void test_random_matrices_bit_exact(void)
+{
+    srand(24);
+    for (int trial = 0; trial < 2000; ++trial) {
+        ColorCalib calib;
+        for (int i = 0; i < 9; ++i) {
+            calib.m[i] = (trial & 1) ? (int16_t)((i % 4 == 0 ? COLOR_CALIB_ONE : 0) + rand() % 1200 - 600)
+                                     : (int16_t)(rand() & 0xFFFF);
+        }
+        for (int c = 0; c < 3; ++c) {
+            calib.offset[c] = (int16_t)(rand() % (2 * COLOR_CALIB_OFFSET_MAX + 1) - COLOR_CALIB_OFFSET_MAX);
+        }
+        uint8_t in[64 * 3];
+        uint8_t out[64 * 3];
+        for (int i = 0; i < 64 * 3; ++i) {
+            in[i] = (uint8_t)rand();
+        }
+        memset(in, 0, 3);
+        memset(in + 3, 255, 3);
+        memcpy(out, in, sizeof(out));
+        color_calib_apply(&calib, out, 64);
+        for (int p = 0; p < 64; ++p) {
+            for (int c = 0; c < 3; ++c) {
+                if (out[p * 3 + c] != reference_channel(calib, c, in + p * 3)) {
+                    char msg[64];
+                    snprintf(msg, sizeof(msg), "trial %d chip %d channel %d", trial, p, c);
+                    TEST_FAIL_MESSAGE(msg);
+                }
+            }
+        }
+        // 序列化往返
+        uint8_t wire[COLOR_CALIB_WIRE_SIZE];
+        ColorCalib decoded;
+        color_calib_encode(&calib, wire);
+        color_calib_decode(wire, &decoded);
+        TEST_ASSERT_EQUAL_MEMORY(&calib, &decoded, sizeof(calib));
+    }
+}
+
+// 典型校准矩阵下穷举全部输入颜色
+void test_all_inputs_bit_exact(void)
+{
+    ColorCalib calib;
+    memcpy(calib.m, TYPICAL_MATRIX, sizeof(calib.m));
+    calib.offset[0] = -3;
+    calib.offset[1] = 2;
+    calib.offset[2] = 5;
+    static uint8_t row[256 * 3];
+    for (int r = 0; r < 256; ++r) {
+        for (int g = 0; g < 256; ++g) {
+            for (int b = 0; b < 256; ++b) {
+                row[b * 3 + 0] = (uint8_t)r;
+                row[b * 3 + 1] = (uint8_t)g;
+                row[b * 3 + 2] = (uint8_t)b;
+            }
+            color_calib_apply(&calib, row, 256);
+            for (int b = 0; b < 256; ++b) {
+                uint8_t in[3] = {(uint8_t)r, (uint8_t)g, (uint8_t)b};
+                for (int c = 0; c < 3; ++c) {
+                    if (row[b * 3 + c] != reference_channel(calib, c, in)) {
+                        char msg[64];
+                        snprintf(msg, sizeof(msg), "input %d,%d,%d channel %d", r, g, b, c);
+                        TEST_FAIL_MESSAGE(msg);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void test_identity_and_validation(void)
+{
+    ColorCalib calib;
+    color_calib_identity(&calib);
+    TEST_ASSERT_TRUE(color_calib_is_identity(&calib));
+    TEST_ASSERT_TRUE(color_calib_valid(&calib));
+    uint8_t in[256 * 3];
+    uint8_t out[256 * 3];
+    for (int i = 0; i < 256 * 3; ++i) {
+        in[i] = (uint8_t)(i * 7);
+    }
+    memcpy(out, in, sizeof(out));
+    color_calib_apply(&calib, out, 256);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(in, out, sizeof(in));
+
+    calib.offset[0] = COLOR_CALIB_OFFSET_MAX + 1;
+    TEST_ASSERT_FALSE(color_calib_valid(&calib));
+    calib.offset[0] = -COLOR_CALIB_OFFSET_MAX - 1;
+    TEST_ASSERT_FALSE(color_calib_valid(&calib));
+    calib.offset[0] = -COLOR_CALIB_OFFSET_MAX;
+    TEST_ASSERT_TRUE(color_calib_valid(&calib));
+}
+
+// 正偏移不点亮黑色芯片；非黑芯片照常加偏移
+void test_black_chips_stay_dark(void)
+{
+    ColorCalib calib;
+    color_calib_identity(&calib);
+    calib.offset[0] = 10;
+    calib.offset[1] = 20;
+    calib.offset[2] = 30;
+    uint8_t rgb[9] = {0, 0, 0, 1, 0, 0, 0, 0, 0};
+    const uint8_t expected[9] = {0, 0, 0, 11, 20, 30, 0, 0, 0};
+    color_calib_apply(&calib, rgb, 3);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, rgb, sizeof(rgb));
+}
+
+// 发送路径：校准生效后，线上码值等于按定义对亮度缩放后的帧逐芯片校正
+void test_sender_applies_calibration(void)
+{
+    ColorCalib calib;
+    memcpy(calib.m, TYPICAL_MATRIX, sizeof(calib.m));
+    calib.offset[0] = 4;
+    calib.offset[1] = -2;
+    calib.offset[2] = 6;
+    TEST_ASSERT_TRUE(sid_calib_set(&calib, false));
+
+    int chips = panel_chip_count();
+    uint8_t frame[PANEL_MAX_CHIPS * 3];
+    uint8_t wire[PANEL_MAX_CHIPS * 3];
+    for (int i = 0; i < chips * 3; ++i) {
+        frame[i] = (uint8_t)(i * 37 + 11);
+    }
+    memset(frame, 0, 3);
+    memset(frame + 6, 0, 3);
+    send_chain_data(frame, chips * 3, 0xFFFF);
+    TEST_ASSERT_EQUAL_INT(chips, sid_test_decode_chain(wire, sizeof(wire)));
+    for (int p = 0; p < chips; ++p) {
+        for (int c = 0; c < 3; ++c) {
+            TEST_ASSERT_EQUAL_UINT8(reference_channel(calib, c, frame + p * 3), wire[p * 3 + c]);
+        }
+    }
+}
+
+// 1024颗芯片每帧耗时：预算取标准时序下该链帧线上时长的 1/200
+// （ESP32 240MHz 约比主机慢30~50倍，折算到设备上仍在帧时长的1/4以内）
+void test_apply_cost_1024_chips(void)
+{
+    const int chips = 1024;
+    ColorCalib calib;
+    memcpy(calib.m, TYPICAL_MATRIX, sizeof(calib.m));
+    calib.offset[0] = 4;
+    calib.offset[1] = -2;
+    calib.offset[2] = 6;
+    static uint8_t source[1024 * 3];
+    static uint8_t rgb[1024 * 3];
+    for (int i = 0; i < chips * 3; ++i) {
+        source[i] = (uint8_t)(i * 37 + 11);
+    }
+    volatile uint32_t sink = 0;
+    BenchResult cost = bench_best([&](int) {
+        memcpy(rgb, source, sizeof(rgb));
+        color_calib_apply(&calib, rgb, chips);
+        sink = sink + rgb[chips];
+    }, 50);
+    const uint32_t wireUs = sid_rmt_chain_wire_us(chips, SID_TIMING_STANDARD);
+    const double budgetNs = wireUs * 1000.0 / 200;
+    char msg[160];
+    snprintf(msg, sizeof(msg), "%d chips: %.0f ns/frame (%.2f ns, %.1f cycles per chip); frame wire time %u us, budget %.0f ns",
+             chips, cost.ns, cost.ns / chips, cost.cycles / chips, (unsigned)wireUs, budgetNs);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(cost.ns < budgetNs);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_random_matrices_bit_exact);
+    RUN_TEST(test_all_inputs_bit_exact);
+    RUN_TEST(test_identity_and_validation);
+    RUN_TEST(test_black_chips_stay_dark);
+    RUN_TEST(test_sender_applies_calibration);
+    RUN_TEST(test_apply_cost_1024_chips);
+    return UNITY_END();
+}
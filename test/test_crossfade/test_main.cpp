@@ -0,0 +1,346 @@
+// 效果跨淡入：在假时钟下逐拍驱动播放循环，淡入期间每个发布帧与浮点参考逐字节比较
+// （出入场效果按各自帧间隔取帧，按缓动进度在线性光或sRGB空间插值），淡入结束后接着播放目标效果；
+// 内置效果两两淡入时每帧至多渲染两次效果，主机基准对比每帧耗时与两次渲染加一次混合
+#include <unity.h>
+#include <math.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "sid_test_support.h"
+#include "anim_test_access.h"
+#include "bench_support.h"
+#include "gamma_lut.h"
+#include "images.h"
+
+static const uint32_t FADE_MS = 1000;
+
+// 浮点参考缓动
+static double reference_ease(EaseCurve ease, double p)
+{
+    if (ease == EASE_IN_OUT_CUBIC) {
+        return p < 0.5 ? 4 * p * p * p : 1 - pow(2 - 2 * p, 3) / 2;
+    }
+    return p;
+}
+
+// 浮点参考混合：线性光（2.2）或sRGB空间插值
+static double reference_blend(int a, int b, double t, bool linear)
+{
+    if (!linear) {
+        return a + (b - a) * t;
+    }
+    double la = pow(a / 255.0, 2.2);
+    double lb = pow(b / 255.0, 2.2);
+    return pow(la + (lb - la) * t, 1 / 2.2) * 255.0;
+}
+
+// 允许误差：线性光混合沿用查表误差界（任一端 >= 32 时 1.8，否则 3.7），sRGB 为舍入误差
+static double blend_tolerance(int a, int b, bool linear)
+{
+    if (!linear) {
+        return 1.0;
+    }
+    return (a >= 32 || b >= 32) ? 1.8 : 3.7;
+}
+
+static int reference_frame_index(AnimEffect* effect, int startFrame, uint32_t elapsedMs)
+{
+    int count = effect->getFrameCount();
+    if (count <= 1) {
+        return 0;
+    }
+    return (int)((startFrame + elapsedMs / (uint32_t)effect->getFrameDelay()) % (uint32_t)count);
+}
+
+static AnimSystem& test_anim(void)
+{
+    static AnimSystem anim;
+    static bool initialized = false;
+    if (!initialized) {
+        anim.init();
+        initialized = true;
+    }
+    return anim;
+}
+
+// 从 from 播放若干拍后切到 to，逐拍比较直到淡入结束并再播放若干帧；返回淡入期间的帧数
+static int run_crossfade(AnimEffect* from, AnimEffect* to, EaseCurve ease, bool linear, int leadTicks)
+{
+    AnimSystem& anim = test_anim();
+    anim.stop();
+    anim.setCrossfadeMs(0);
+    anim.setEffect(from);
+    anim.setCrossfadeMs((int)FADE_MS);
+    anim.setTransitionEase(ease);
+    anim.setGammaBlendEnabled(linear);
+    anim.start();
+
+    int frameSize = AnimSystemTestAccess::frameSize(anim);
+    uint8_t* fromFrame = (uint8_t*)malloc(frameSize);
+    uint8_t* toFrame = (uint8_t*)malloc(frameSize);
+    uint8_t* expected = (uint8_t*)malloc(frameSize);
+    int drop = 0;
+    for (int i = 0; i < leadTicks; ++i) {
+        AnimSystemTestAccess::tick(anim, &drop);
+    }
+
+    // 出场效果从下一帧接着播放；静态出场取当前显示帧
+    int fromStart = AnimSystemTestAccess::currentFrame(anim);
+    if (from->getFrameCount() <= 1) {
+        fromStart = 0;
+    }
+    uint64_t startUs = (uint64_t)esp_timer_get_time();
+    anim.setEffect(to);
+    TEST_ASSERT_TRUE(AnimSystemTestAccess::transitionActive(anim));
+
+    int framesChecked = 0;
+    while (AnimSystemTestAccess::transitionActive(anim)) {
+        uint64_t showUs = AnimSystemTestAccess::tick(anim, &drop);
+        const uint8_t* frame = AnimSystemTestAccess::latestFrame(anim);
+        uint64_t elapsedUs = showUs - startUs;
+        if (elapsedUs > FADE_MS * 1000) {
+            elapsedUs = FADE_MS * 1000;
+        }
+        uint32_t elapsedMs = (uint32_t)(elapsedUs / 1000);
+        double t = reference_ease(ease, elapsedUs / (FADE_MS * 1000.0));
+        AnimSystemTestAccess::renderEffectFrame(anim, from, reference_frame_index(from, fromStart, elapsedMs), fromFrame);
+        AnimSystemTestAccess::renderEffectFrame(anim, to, reference_frame_index(to, 0, elapsedMs), toFrame);
+        for (int i = 0; i < frameSize; ++i) {
+            double ref = reference_blend(fromFrame[i], toFrame[i], t, linear);
+            double err = fabs(frame[i] - ref);
+            if (err > blend_tolerance(fromFrame[i], toFrame[i], linear)) {
+                char msg[160];
+                snprintf(msg, sizeof(msg), "elapsed %uus byte %d: %d vs ref %.2f (from %d to %d, t %.4f)",
+                         (unsigned)elapsedUs, i, frame[i], ref, fromFrame[i], toFrame[i], t);
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+        framesChecked++;
+        TEST_ASSERT_TRUE_MESSAGE(framesChecked < 1000, "crossfade never finished");
+    }
+
+    // 淡入结束：切换到目标效果，从淡入期间已播到的位置接着逐帧播放
+    TEST_ASSERT_TRUE(AnimSystemTestAccess::currentEffect(anim) == to);
+    int finishFrame = reference_frame_index(to, 0, FADE_MS);
+    for (int k = 0; k < 5; ++k) {
+        AnimSystemTestAccess::tick(anim, &drop);
+        int index = (finishFrame + k) % to->getFrameCount();
+        AnimSystemTestAccess::renderEffectFrame(anim, to, index, expected);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expected, AnimSystemTestAccess::latestFrame(anim), frameSize,
+                                              "target playback after crossfade");
+    }
+    free(fromFrame);
+    free(toFrame);
+    free(expected);
+    return framesChecked;
+}
+
+void setUp(void)
+{
+    sid_test_setup_default_panel();
+    sid_rmt_set_async(false);
+    sid_test_full_brightness();
+}
+
+void tearDown(void)
+{
+}
+
+void test_static_to_static_linear_light(void)
+{
+    WhiteStaticEffect white(255);
+    ColorTempEffect cct(10, 3);
+    int frames = run_crossfade(&white, &cct, EASE_LINEAR, true, 3);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT(FADE_MS / ANIM_TRANSITION_FRAME_MS, frames);
+}
+
+void test_animated_to_animated_linear_light(void)
+{
+    BreathEffect breath;
+    ImageDataEffect lt3(lt3_data);
+    int frames = run_crossfade(&breath, &lt3, EASE_IN_OUT_CUBIC, true, 17);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT(FADE_MS / ANIM_TRANSITION_FRAME_MS, frames);
+}
+
+void test_static_to_animated_srgb(void)
+{
+    WhiteStaticEffect dim(40);
+    CandleFlameEffect candle;
+    int frames = run_crossfade(&dim, &candle, EASE_IN_OUT_CUBIC, false, 2);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT(FADE_MS / ANIM_TRANSITION_FRAME_MS, frames);
+}
+
+void test_animated_to_static_srgb(void)
+{
+    ImageDataEffect czcx(czcx_data);
+    ColorTempEffect cct(40, 2);
+    int frames = run_crossfade(&czcx, &cct, EASE_LINEAR, false, 9);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT(FADE_MS / ANIM_TRANSITION_FRAME_MS, frames);
+}
+
+// 统计被包装效果的渲染次数（renderFrame 或命中常驻帧各计一次），其余接口原样转发
+class CountingEffect : public AnimEffect {
+public:
+    explicit CountingEffect(AnimEffect* inner) : inner_(inner) {}
+    void renderFrame(int index, uint8_t* dst, int frameSize) override
+    {
+        renders++;
+        inner_->renderFrame(index, dst, frameSize);
+    }
+    const uint8_t* frameData(int index) const override
+    {
+        const uint8_t* data = inner_->frameData(index);
+        if (data) {
+            renders++;
+        }
+        return data;
+    }
+    const char* getName() const override { return inner_->getName(); }
+    int getFrameCount() const override { return inner_->getFrameCount(); }
+    int getFrameDelay() const override { return inner_->getFrameDelay(); }
+    bool isChainOrder() const override { return inner_->isChainOrder(); }
+    mutable int renders = 0;
+private:
+    AnimEffect* inner_;
+};
+
+// main.cpp 中的 8 个内置效果实例
+struct BuiltinEffects {
+    WhiteStaticEffect white;
+    ColorTempEffect colorTemp;
+    ImageDataEffect img1, czcx, jl3, lt2, lt3;
+    CandleFlameEffect candle;
+    AnimEffect* list[8];
+    BuiltinEffects()
+        : white(255), colorTemp(1), img1(img1_data), czcx(czcx_data), jl3(jl3_data), lt2(lt2_data), lt3(lt3_data),
+          candle(255, 100, 50, 60)
+    {
+        AnimEffect* all[8] = {&white, &colorTemp, &img1, &czcx, &jl3, &lt2, &lt3, &candle};
+        memcpy(list, all, sizeof(list));
+    }
+};
+
+// 单个效果按播放路径渲染一帧的耗时（轮流取各帧）
+static double render_ns(AnimSystem& anim, AnimEffect* effect, uint8_t* dst)
+{
+    int count = effect->getFrameCount();
+    return bench_best([&](int i) {
+        AnimSystemTestAccess::renderEffectFrame(anim, effect, i % count, dst);
+    }, 200).ns;
+}
+
+// 单拍耗时的中位数（排除调度抖动造成的个别长拍）
+static double median_ns(std::vector<double>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+// 8x8 共 64 对（出入场为不同实例，含同类效果互切）：淡入期间每出一帧效果渲染不超过2次；
+// 每拍耗时（中位数）扣除稳态单拍的固定开销后，与 出场渲染 + 入场渲染 + 一次线性光混合 比较
+void test_crossfade_cost_all_builtin_pairs(void)
+{
+    static BuiltinEffects outgoing;
+    static BuiltinEffects incoming;
+    AnimSystem& anim = test_anim();
+    const int frameSize = AnimSystemTestAccess::frameSize(anim);
+    uint8_t* a = (uint8_t*)malloc(frameSize);
+    uint8_t* b = (uint8_t*)malloc(frameSize);
+    uint8_t* dst = (uint8_t*)malloc(frameSize);
+    for (int i = 0; i < frameSize; ++i) {
+        a[i] = (uint8_t)(i * 37);
+        b[i] = (uint8_t)(255 - i * 11);
+    }
+    volatile uint32_t sink = 0;
+    const double blendNs = bench_best([&](int i) {
+        gamma_blend_frame(a, b, dst, frameSize, (uint32_t)(i * 13) & 0xFFF, true);
+        sink = sink + dst[0];
+    }, 2000).ns;
+
+    double renderCost[8];
+    for (int e = 0; e < 8; ++e) {
+        renderCost[e] = render_ns(anim, incoming.list[e], dst);
+    }
+
+    double worstRatio = 0;
+    char worst[160] = "";
+    std::vector<double> samples;
+    for (int f = 0; f < 8; ++f) {
+        for (int t = 0; t < 8; ++t) {
+            CountingEffect from(outgoing.list[f]);
+            CountingEffect to(incoming.list[t]);
+            int drop = 0;
+            // 稳态基线：入场效果单独播放时的单拍耗时 = 渲染一帧 + 固定开销
+            anim.stop();
+            anim.setCrossfadeMs(0);
+            anim.setEffect(incoming.list[t]);
+            anim.start();
+            samples.clear();
+            for (int i = 0; i < 50; ++i) {
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                AnimSystemTestAccess::tick(anim, &drop);
+                samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+            }
+            double fixedNs = median_ns(samples) - renderCost[t];
+            if (fixedNs < 0) {
+                fixedNs = 0;
+            }
+
+            anim.stop();
+            anim.setEffect(&from);
+            anim.setCrossfadeMs((int)FADE_MS);
+            anim.setGammaBlendEnabled(true);
+            anim.start();
+            for (int i = 0; i < 3; ++i) {
+                AnimSystemTestAccess::tick(anim, &drop);
+            }
+            anim.setEffect(&to);
+            TEST_ASSERT_TRUE(AnimSystemTestAccess::transitionActive(anim));
+            // 切换后首拍：预渲染帧已失效，当拍渲染并预渲染下一帧（静态入场效果在切换时另渲染一次）；
+            // 之后每拍只预渲染一帧
+            AnimSystemTestAccess::tick(anim, &drop);
+            from.renders = 0;
+            to.renders = 0;
+            samples.clear();
+            while (AnimSystemTestAccess::transitionActive(anim)) {
+                int before = from.renders + to.renders;
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                AnimSystemTestAccess::tick(anim, &drop);
+                samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+                char msg[96];
+                snprintf(msg, sizeof(msg), "%s -> %s tick %d", from.getName(), to.getName(), (int)samples.size());
+                TEST_ASSERT_TRUE_MESSAGE(from.renders + to.renders - before <= 2, msg);
+                TEST_ASSERT_TRUE_MESSAGE(samples.size() < 1000, msg);
+            }
+            double fadeNs = median_ns(samples) - fixedNs;
+            double bound = renderCost[f] + renderCost[t] + blendNs;
+            // 计时有抖动，只拦截明显超出（多一次渲染或多一次混合级别）的回归
+            char msg[160];
+            snprintf(msg, sizeof(msg), "%s -> %s: %.0f ns/frame vs %.0f ns", from.getName(), to.getName(), fadeNs, bound);
+            TEST_ASSERT_TRUE_MESSAGE(fadeNs <= 2.0 * bound + 500.0, msg);
+            if (fadeNs / bound > worstRatio) {
+                worstRatio = fadeNs / bound;
+                snprintf(worst, sizeof(worst), "%s", msg);
+            }
+        }
+    }
+    anim.stop();
+    char msg[240];
+    snprintf(msg, sizeof(msg), "blend %.0f ns/frame; worst pair %s (ratio %.2f)", blendNs, worst, worstRatio);
+    TEST_MESSAGE(msg);
+    free(a);
+    free(b);
+    free(dst);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_static_to_static_linear_light);
+    RUN_TEST(test_animated_to_animated_linear_light);
+    RUN_TEST(test_static_to_animated_srgb);
+    RUN_TEST(test_animated_to_static_srgb);
+    RUN_TEST(test_crossfade_cost_all_builtin_pairs);
+    return UNITY_END();
+}
@@ -0,0 +1,278 @@
+// 按需渲染：各效果乱序逐帧 renderFrame 的结果与原整段预渲染（generateAnimation）逐字节一致。
+// 参考实现照搬改为按需渲染之前的预渲染循环
+#include <unity.h>
+#include <math.h>
+#include <stdlib.h>
+#include "sid_test_support.h"
+#include "anim_effect.hpp"
+#include "cct_engine.h"
+#include "images.h"
+
+static uint8_t* s_expected = nullptr;
+static uint32_t s_seed = 99;
+
+static uint32_t next_random(uint32_t range)
+{
+    s_seed = s_seed * 1103515245u + 12345u;
+    return (s_seed >> 8) % range;
+}
+
+// 预渲染结果缓冲，按帧数与当前面板扩容
+static uint8_t* expected_frames(int frameCount)
+{
+    s_expected = (uint8_t*)realloc(s_expected, (size_t)frameCount * panel_frame_size());
+    TEST_ASSERT_NOT_NULL(s_expected);
+    return s_expected;
+}
+
+// ---- 原预渲染实现 ----
+static void reference_breath(uint8_t* out, int frameCount, int frameSize, uint8_t r0, uint8_t g0, uint8_t b0)
+{
+    const int W = panel_width(), H = panel_height();
+    for (int f = 0; f < frameCount; ++f) {
+        float t = (float)f / frameCount;
+        float breath = (sin(t * 2 * 3.14159f - 3.14159f/2) + 1) / 2;
+        float intensity = 30 + breath * 225;
+        for (int y = 0; y < H; ++y) {
+            for (int x = 0; x < W; ++x) {
+                int idx = f * frameSize + (y * W + x) * 3;
+                out[idx + 0] = (uint8_t)(r0 * intensity / 255.0f);
+                out[idx + 1] = (uint8_t)(g0 * intensity / 255.0f);
+                out[idx + 2] = (uint8_t)(b0 * intensity / 255.0f);
+            }
+        }
+    }
+}
+
+static void reference_solid(uint8_t* out, int frameSize, uint8_t r, uint8_t g, uint8_t b)
+{
+    const int W = panel_width(), H = panel_height();
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            int idx = (y * W + x) * 3;
+            out[idx + 0] = r;
+            out[idx + 1] = g;
+            out[idx + 2] = b;
+        }
+    }
+    (void)frameSize;
+}
+
+static void reference_image(uint8_t* out, int frameSize, const uint8_t* imageData)
+{
+    const int ASSET_W = 6, ASSET_H = 6, ASSET_FRAME = ASSET_W * ASSET_H * 3;
+    uint16_t dataFrameCount = (imageData[0] << 8) | imageData[1];
+    const uint8_t* rgbData = imageData + 3;
+    const int W = panel_width(), H = panel_height();
+    if (W == ASSET_W && H == ASSET_H) {
+        memcpy(out, rgbData, dataFrameCount * frameSize);
+        return;
+    }
+    for (int f = 0; f < dataFrameCount; ++f) {
+        const uint8_t* src = rgbData + f * ASSET_FRAME;
+        uint8_t* dst = out + f * frameSize;
+        for (int y = 0; y < H; ++y) {
+            int sy = y * ASSET_H / H;
+            for (int x = 0; x < W; ++x) {
+                int sx = x * ASSET_W / W;
+                const uint8_t* px = &src[(sy * ASSET_W + sx) * 3];
+                uint8_t* o = &dst[(y * W + x) * 3];
+                o[0] = px[0];
+                o[1] = px[1];
+                o[2] = px[2];
+            }
+        }
+    }
+}
+
+static void reference_candle(uint8_t* out, int frameCount, int frameSize, uint8_t r0, uint8_t g0, uint8_t b0,
+                             float flameIntensity, float windEffect)
+{
+    const int W = panel_width(), H = panel_height();
+    for (int f = 0; f < frameCount; ++f) {
+        for (int y = 0; y < H; ++y) {
+            for (int x = 0; x < W; ++x) {
+                int idx = f * frameSize + (y * W + x) * 3;
+                float flameX = W > 1 ? (float)x / (W - 1) : 0.0f;
+                float flameY = H > 1 ? (float)y / (H - 1) : 0.0f;
+                float flameShape = 1.0f - flameY * 0.8f;
+                float time = (float)f * 0.1f;
+                float windX = sin(time * 2.0f + flameY * 3.0f) * windEffect * 0.3f;
+                float windY = sin(time * 1.5f + flameX * 2.0f) * windEffect * 0.2f;
+                float flicker = 0.7f + 0.3f * sin(time * 8.0f + flameX * 5.0f);
+                flicker *= flameIntensity;
+                float r = (float)r0 * flameShape * flicker * (1.0f + windX);
+                float g = (float)g0 * flameShape * flicker * (1.0f + windY);
+                float b = (float)b0 * flameShape * flicker * 0.5f;
+                r = constrain(r, 0, 255);
+                g = constrain(g, 0, 255);
+                b = constrain(b, 0, 255);
+                out[idx + 0] = (uint8_t)r;
+                out[idx + 1] = (uint8_t)g;
+                out[idx + 2] = (uint8_t)b;
+            }
+        }
+    }
+}
+
+// 乱序逐帧渲染并与预渲染结果比较；每帧渲染前用随机内容填充目标，确认整帧都被写入
+static void check_on_demand(AnimEffect* effect, const uint8_t* expected, int frameCount)
+{
+    const int frameSize = panel_frame_size();
+    TEST_ASSERT_EQUAL_INT(frameCount, effect->getFrameCount());
+    int* order = (int*)malloc(frameCount * sizeof(int));
+    TEST_ASSERT_NOT_NULL(order);
+    for (int f = 0; f < frameCount; ++f) {
+        order[f] = f;
+    }
+    for (int f = frameCount - 1; f > 0; --f) {
+        int j = next_random(f + 1);
+        int t = order[f];
+        order[f] = order[j];
+        order[j] = t;
+    }
+    uint8_t frame[PANEL_MAX_CHIPS * 3];
+    for (int k = 0; k < frameCount; ++k) {
+        int f = order[k];
+        for (int i = 0; i < frameSize; ++i) {
+            frame[i] = (uint8_t)next_random(256);
+        }
+        effect->renderFrame(f, frame, frameSize);
+        char msg[64];
+        snprintf(msg, sizeof(msg), "%s frame %d, %dx%d", effect->getName(), f, panel_width(), panel_height());
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&expected[f * frameSize], frame, frameSize, msg);
+        // 常驻帧与渲染结果一致
+        const uint8_t* resident = effect->frameData(f);
+        if (resident) {
+            TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&expected[f * frameSize], resident, frameSize, msg);
+        }
+    }
+    free(order);
+}
+
+// 含单列/单行灯带
+static const uint16_t PANEL_SIZES[][2] = {{6, 6}, {16, 16}, {8, 5}, {3, 12}, {1, 24}, {24, 1}};
+
+static void for_each_panel(void (*check)(void))
+{
+    for (size_t p = 0; p < sizeof(PANEL_SIZES) / sizeof(PANEL_SIZES[0]); ++p) {
+        TEST_ASSERT_TRUE(sid_test_setup_panel(PANEL_SIZES[p][0], PANEL_SIZES[p][1], nullptr));
+        check();
+    }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void check_breath(void)
+{
+    BreathEffect breath;
+    reference_breath(expected_frames(100), 100, panel_frame_size(), 255, 100, 50);
+    check_on_demand(&breath, s_expected, 100);
+    BreathEffect blue(10, 40, 250, 37);
+    reference_breath(expected_frames(37), 37, panel_frame_size(), 10, 40, 250);
+    check_on_demand(&blue, s_expected, 37);
+}
+
+static void check_static(void)
+{
+    WhiteStaticEffect white(200);
+    reference_solid(expected_frames(1), panel_frame_size(), 200, 200, 200);
+    check_on_demand(&white, s_expected, 1);
+    for (uint8_t t = 1; t <= 61; t += 4) {
+        for (uint8_t d = 1; d <= 5; ++d) {
+            ColorTempEffect cct(t, d);
+            uint8_t r, g, b;
+            TEST_ASSERT_TRUE(cct_grid_rgb8(t, d, &r, &g, &b));
+            reference_solid(expected_frames(1), panel_frame_size(), r, g, b);
+            check_on_demand(&cct, s_expected, 1);
+        }
+    }
+}
+
+static void check_images(void)
+{
+    const uint8_t* assets[] = {img1_data, czcx_data, jl3_data, lt2_data, lt3_data};
+    const size_t sizes[] = {sizeof(img1_data), sizeof(czcx_data), sizeof(jl3_data), sizeof(lt2_data), sizeof(lt3_data)};
+    for (size_t i = 0; i < sizeof(assets) / sizeof(assets[0]); ++i) {
+        ImageDataEffect effect(assets[i], sizes[i]);
+        TEST_ASSERT_TRUE_MESSAGE(effect.isValid(), effect.getError());
+        int frames = (assets[i][0] << 8) | assets[i][1];
+        reference_image(expected_frames(frames), panel_frame_size(), assets[i]);
+        check_on_demand(&effect, s_expected, frames);
+    }
+}
+
+static void check_candle(void)
+{
+    CandleFlameEffect candle;
+    reference_candle(expected_frames(60), 60, panel_frame_size(), 255, 100, 50, 1.0f, 0.5f);
+    check_on_demand(&candle, s_expected, 60);
+    CandleFlameEffect windy(200, 150, 90, 45);
+    windy.setFlameIntensity(1.3f);
+    windy.setWindEffect(0.9f);
+    reference_candle(expected_frames(45), 45, panel_frame_size(), 200, 150, 90, 1.3f, 0.9f);
+    check_on_demand(&windy, s_expected, 45);
+    // 任何面板形状下火焰都不是全黑
+    uint8_t frame[PANEL_MAX_CHIPS * 3];
+    candle.renderFrame(0, frame, panel_frame_size());
+    int lit = 0;
+    for (int i = 0; i < panel_frame_size(); ++i) {
+        lit += frame[i] != 0;
+    }
+    TEST_ASSERT_TRUE(lit > 0);
+}
+
+static void check_frame_data(void)
+{
+    const int frames = 24;
+    const int frameSize = panel_frame_size();
+    static uint8_t data[24 * PANEL_MAX_CHIPS * 3];
+    for (int i = 0; i < frames * frameSize; ++i) {
+        data[i] = (uint8_t)next_random(256);
+    }
+    FrameDataEffect effect;
+    effect.setData(data, frames);
+    check_on_demand(&effect, data, frames);
+}
+
+void test_breath(void)
+{
+    for_each_panel(check_breath);
+}
+
+void test_static_effects(void)
+{
+    for_each_panel(check_static);
+}
+
+void test_image_assets(void)
+{
+    for_each_panel(check_images);
+}
+
+void test_candle_flame(void)
+{
+    for_each_panel(check_candle);
+}
+
+void test_frame_data(void)
+{
+    for_each_panel(check_frame_data);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_breath);
+    RUN_TEST(test_static_effects);
+    RUN_TEST(test_image_assets);
+    RUN_TEST(test_candle_flame);
+    RUN_TEST(test_frame_data);
+    return UNITY_END();
+}
@@ -0,0 +1,177 @@
+// 帧时钟：虚拟时钟驱动，按渲染任务的节奏逐帧模拟“到截止时刻发布 -> frameDone -> 等待期间渲染下一帧”，
+// 校验截止时刻不漂移，以及渲染落后时 DROP 保持时间线、STRETCH 顺延时间线
+#include <unity.h>
+#include "frame_clock.hpp"
+
+static const uint32_t PERIOD_US = 20000;
+static const uint64_t START_US = 1000000;
+
+// now 为当前虚拟时刻，animIndex 为下一次发布的动画帧号
+struct ClockSim {
+    FrameClock clock;
+    uint64_t now;
+    uint64_t animIndex;
+    uint64_t published;  // 最近一次发布的动画帧号
+    uint64_t deadline;   // 最近一次发布对应的截止时刻（由迟到量反推）
+
+    explicit ClockSim(FrameClock::LatePolicy policy)
+        : clock(1000), now(START_US), animIndex(0), published(0), deadline(START_US) {
+        clock.setPeriodUs(PERIOD_US);
+        clock.setLatePolicy(policy);
+        clock.start(now);
+    }
+
+    // 在 now 发布当前帧并推进时钟，随后渲染下一帧耗时 renderUs，渲染完且到截止时刻才发布下一帧；
+    // 返回下一帧之前跳过的动画帧数
+    int step(uint32_t renderUs) {
+        int drop = -1;
+        uint32_t wait = clock.frameDone(now, &drop);
+        deadline = now - clock.stats().lastLatenessUs;
+        published = animIndex;
+        animIndex += 1 + drop;
+        now += renderUs > wait ? renderUs : wait;
+        return drop;
+    }
+
+    // 已发布帧所在时间格（相对起点的周期数）
+    uint64_t slot() const { return (deadline - START_US) / PERIOD_US; }
+    bool onGrid() const { return (deadline - START_US) % PERIOD_US == 0; }
+};
+
+static uint32_t s_seed = 7;
+
+static uint32_t next_random(uint32_t range)
+{
+    s_seed = s_seed * 1103515245u + 12345u;
+    return (s_seed >> 8) % range;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_no_drift_with_jitter(void)
+{
+    FrameClock::LatePolicy policies[] = {FrameClock::DROP, FrameClock::STRETCH};
+    for (int p = 0; p < 2; ++p) {
+        ClockSim sim(policies[p]);
+        const int FRAMES = 100000;
+        for (int n = 0; n < FRAMES; ++n) {
+            // 渲染耗时在一个周期内随机抖动，帧始终在各自的截止时刻发布
+            TEST_ASSERT_EQUAL_UINT32((uint32_t)(START_US + (uint64_t)n * PERIOD_US), (uint32_t)sim.now);
+            TEST_ASSERT_EQUAL_INT(0, sim.step(next_random(PERIOD_US + 1)));
+        }
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)(START_US + (uint64_t)FRAMES * PERIOD_US), (uint32_t)sim.now);
+        TEST_ASSERT_EQUAL_UINT32(FRAMES, sim.clock.stats().frames);
+        TEST_ASSERT_EQUAL_UINT32(0, sim.clock.stats().lateFrames);
+        TEST_ASSERT_EQUAL_UINT32(0, sim.clock.stats().droppedFrames);
+        TEST_ASSERT_EQUAL_UINT32(0, sim.clock.stats().stretchedFrames);
+        TEST_ASSERT_EQUAL_UINT32(0, sim.clock.stats().maxLatenessUs);
+    }
+}
+
+void test_drop_keeps_timeline(void)
+{
+    ClockSim sim(FrameClock::DROP);
+    for (int n = 0; n < 10; ++n) {
+        sim.step(5000);
+    }
+    // 渲染耗时3.5个周期：下一帧在第10+3.5格发布，已错过第11、12格，跳过2帧落到第13格
+    TEST_ASSERT_EQUAL_INT(0, sim.step(PERIOD_US * 7 / 2));
+    TEST_ASSERT_EQUAL_INT(2, sim.step(5000));
+    TEST_ASSERT_EQUAL_UINT32(11, (uint32_t)sim.slot());
+    TEST_ASSERT_EQUAL_UINT32(11, (uint32_t)sim.published);
+    TEST_ASSERT_EQUAL_UINT32(PERIOD_US * 5 / 2, sim.clock.stats().lastLatenessUs);
+    sim.step(5000);
+    TEST_ASSERT_EQUAL_UINT32(14, (uint32_t)sim.slot());
+    TEST_ASSERT_EQUAL_UINT32(14, (uint32_t)sim.published);
+    TEST_ASSERT_EQUAL_UINT32(2, sim.clock.stats().droppedFrames);
+
+    // 随机迟到：每次发布的动画帧号都等于其截止时刻所在的时间格
+    for (int n = 0; n < 10000; ++n) {
+        sim.step(next_random(PERIOD_US * 5));
+        TEST_ASSERT_TRUE(sim.onGrid());
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)sim.slot(), (uint32_t)sim.published);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, sim.clock.stats().stretchedFrames);
+    TEST_ASSERT_TRUE(sim.clock.stats().droppedFrames > 0);
+}
+
+void test_stretch_shifts_timeline(void)
+{
+    ClockSim sim(FrameClock::STRETCH);
+    for (int n = 0; n < 10; ++n) {
+        sim.step(5000);
+    }
+    // 渲染耗时3.5个周期：不跳帧，渲染完立即发布，时间线从此刻起按周期继续
+    TEST_ASSERT_EQUAL_INT(0, sim.step(PERIOD_US * 7 / 2));
+    uint64_t shifted = sim.now;
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(START_US + 10 * PERIOD_US + PERIOD_US * 7 / 2), (uint32_t)shifted);
+    TEST_ASSERT_EQUAL_INT(0, sim.step(1000));
+    TEST_ASSERT_EQUAL_UINT32(1, sim.clock.stats().stretchedFrames);
+    TEST_ASSERT_EQUAL_UINT32(0, sim.clock.stats().droppedFrames);
+    for (int n = 1; n <= 100; ++n) {
+        sim.step(1000);
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)(shifted + (uint64_t)n * PERIOD_US), (uint32_t)sim.now);
+    }
+
+    // 随机迟到：从不跳帧，每一帧都播放
+    for (int n = 0; n < 10000; ++n) {
+        TEST_ASSERT_EQUAL_INT(0, sim.step(next_random(PERIOD_US * 5)));
+    }
+    TEST_ASSERT_EQUAL_UINT32(sim.clock.stats().frames, (uint32_t)sim.animIndex);
+    TEST_ASSERT_EQUAL_UINT32(0, sim.clock.stats().droppedFrames);
+    TEST_ASSERT_TRUE(sim.clock.stats().stretchedFrames > 1);
+}
+
+void test_lateness_stats(void)
+{
+    ClockSim sim(FrameClock::DROP);
+    sim.step(1000);
+    // 晚于截止时刻 500µs 发布（容差内），再晚 3000µs 发布（超出容差）
+    sim.now += 500;
+    sim.step(1000);
+    TEST_ASSERT_EQUAL_UINT32(500, sim.clock.stats().lastLatenessUs);
+    TEST_ASSERT_EQUAL_UINT32(0, sim.clock.stats().lateFrames);
+    sim.now += 3000;
+    sim.step(1000);
+    TEST_ASSERT_EQUAL_UINT32(3000, sim.clock.stats().lastLatenessUs);
+    TEST_ASSERT_EQUAL_UINT32(3000, sim.clock.stats().maxLatenessUs);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.clock.stats().lateFrames);
+    // 迟到未超过一个周期：DROP 下也不跳帧，下一帧回到原时间格
+    TEST_ASSERT_EQUAL_UINT32(0, sim.clock.stats().droppedFrames);
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)((sim.now - START_US) % PERIOD_US));
+    sim.clock.resetStats();
+    TEST_ASSERT_EQUAL_UINT32(0, sim.clock.stats().frames);
+    TEST_ASSERT_EQUAL_UINT32(0, sim.clock.stats().maxLatenessUs);
+}
+
+void test_period_change_applies_from_next_deadline(void)
+{
+    ClockSim sim(FrameClock::DROP);
+    sim.step(1000);
+    uint64_t deadline = sim.now;
+    sim.clock.setPeriodUs(50000);
+    sim.step(1000);
+    // 本帧截止时刻不变，下一截止时刻按新周期
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(deadline + 50000), (uint32_t)sim.now);
+    sim.step(1000);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(deadline + 100000), (uint32_t)sim.now);
+    sim.clock.setPeriodUs(0);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.clock.periodUs());
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_no_drift_with_jitter);
+    RUN_TEST(test_drop_keeps_timeline);
+    RUN_TEST(test_stretch_shifts_timeline);
+    RUN_TEST(test_lateness_stats);
+    RUN_TEST(test_period_change_applies_from_next_deadline);
+    return UNITY_END();
+}
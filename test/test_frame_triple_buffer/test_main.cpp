@@ -0,0 +1,172 @@
+// 三缓冲帧交接：生产者/消费者两个线程并发运行，消费者读到的每一帧都完整（无撕裂），
+// 序号单调递增，生产者停止后消费者一定能取到最后一帧
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include <string.h>
+#include "frame_triple_buffer.hpp"
+
+static const int FRAME_SIZE = 1024 * 3;
+static uint8_t s_storage[3 * FRAME_SIZE];
+
+// 帧内容完全由序号决定：前4字节为序号，其余字节为序号派生的填充
+static void fill_frame(uint8_t* frame, uint32_t seq)
+{
+    memcpy(frame, &seq, sizeof(seq));
+    for (int i = sizeof(seq); i < FRAME_SIZE; ++i) {
+        frame[i] = (uint8_t)(seq * 31 + i);
+    }
+}
+
+static bool frame_intact(const uint8_t* frame, uint32_t* seq)
+{
+    memcpy(seq, frame, sizeof(*seq));
+    for (int i = sizeof(*seq); i < FRAME_SIZE; ++i) {
+        if (frame[i] != (uint8_t)(*seq * 31 + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void setUp(void)
+{
+    memset(s_storage, 0, sizeof(s_storage));
+}
+
+void tearDown(void)
+{
+}
+
+void test_single_thread_handoff(void)
+{
+    FrameTripleBuffer tb;
+    TEST_ASSERT_FALSE(tb.init(nullptr, FRAME_SIZE));
+    TEST_ASSERT_TRUE(tb.init(s_storage, FRAME_SIZE));
+    TEST_ASSERT_FALSE(tb.acquire());
+
+    uint32_t seq = 0;
+    for (uint32_t n = 1; n <= 100; ++n) {
+        fill_frame(tb.writeBuffer(), n);
+        tb.publish();
+        TEST_ASSERT_TRUE(tb.acquire());
+        TEST_ASSERT_TRUE(frame_intact(tb.readBuffer(), &seq));
+        TEST_ASSERT_EQUAL_UINT32(n, seq);
+        TEST_ASSERT_FALSE(tb.acquire());
+    }
+
+    // 连发多帧后只取到最新一帧
+    for (uint32_t n = 101; n <= 105; ++n) {
+        fill_frame(tb.writeBuffer(), n);
+        tb.publish();
+    }
+    TEST_ASSERT_TRUE(tb.acquire());
+    TEST_ASSERT_TRUE(frame_intact(tb.readBuffer(), &seq));
+    TEST_ASSERT_EQUAL_UINT32(105, seq);
+}
+
+void test_concurrent_no_torn_frames(void)
+{
+    FrameTripleBuffer tb;
+    TEST_ASSERT_TRUE(tb.init(s_storage, FRAME_SIZE));
+    const uint32_t FRAMES = 200000;
+    std::atomic<bool> done(false);
+
+    std::thread producer([&]() {
+        for (uint32_t n = 1; n <= FRAMES; ++n) {
+            fill_frame(tb.writeBuffer(), n);
+            tb.publish();
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    uint32_t last = 0;
+    uint32_t received = 0;
+    uint32_t torn = 0;
+    uint32_t backwards = 0;
+    for (;;) {
+        // 先读done再acquire：done为true且没有新帧时，最后一帧已被取走
+        bool finished = done.load(std::memory_order_acquire);
+        if (tb.acquire()) {
+            uint32_t seq;
+            if (!frame_intact(tb.readBuffer(), &seq)) {
+                ++torn;
+            } else if (seq <= last) {
+                ++backwards;
+            } else {
+                last = seq;
+            }
+            ++received;
+        } else if (finished) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%u frames published, %u received", (unsigned)FRAMES, (unsigned)received);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(0, backwards);
+    TEST_ASSERT_EQUAL_UINT32(FRAMES, last);
+    TEST_ASSERT_TRUE(received > 0);
+}
+
+// 消费者慢于生产者（每帧都校验后再取下一帧），并在读取期间生产者持续覆写后台块
+void test_slow_consumer_reads_stable_front(void)
+{
+    FrameTripleBuffer tb;
+    TEST_ASSERT_TRUE(tb.init(s_storage, FRAME_SIZE));
+    std::atomic<bool> stop(false);
+    std::atomic<uint32_t> published(0);
+
+    std::thread producer([&]() {
+        uint32_t n = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            fill_frame(tb.writeBuffer(), ++n);
+            tb.publish();
+            published.store(n, std::memory_order_release);
+        }
+    });
+
+    uint32_t last = 0;
+    uint32_t torn = 0;
+    for (int k = 0; k < 2000;) {
+        if (!tb.acquire()) {
+            std::this_thread::yield();
+            continue;
+        }
+        ++k;
+        uint32_t seq;
+        // 同一前台块读两遍，期间生产者不得写到该块
+        bool first = frame_intact(tb.readBuffer(), &seq);
+        std::this_thread::yield();
+        uint32_t again;
+        bool second = frame_intact(tb.readBuffer(), &again);
+        if (!first || !second || seq != again) {
+            ++torn;
+        }
+        TEST_ASSERT_TRUE(seq > last || torn);
+        last = seq;
+    }
+    stop.store(true, std::memory_order_relaxed);
+    producer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    // 最后一帧可能已在循环中取到，此时前台块即最新帧
+    tb.acquire();
+    uint32_t seq;
+    TEST_ASSERT_TRUE(frame_intact(tb.readBuffer(), &seq));
+    TEST_ASSERT_EQUAL_UINT32(published.load(std::memory_order_acquire), seq);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_single_thread_handoff);
+    RUN_TEST(test_concurrent_no_torn_frames);
+    RUN_TEST(test_slow_consumer_reads_stable_front);
+    return UNITY_END();
+}
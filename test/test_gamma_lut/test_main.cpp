@@ -0,0 +1,156 @@
+// gamma查表混合：查表内容与定义一致，混合结果相对浮点 pow() 参考的误差有界，
+// 两端精确、结果不越出 [a,b]、随 t 单调；主机基准对比查表混合与原 powf 路径
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "gamma_lut.h"
+#include "bench_support.h"
+
+// 浮点参考：两端转线性后插值，再转回sRGB
+static double reference_blend(int a, int b, uint32_t t)
+{
+    double la = pow(a / 255.0, 2.2);
+    double lb = pow(b / 255.0, 2.2);
+    return pow(la + (lb - la) * t / (double)GAMMA_BLEND_ONE, 1 / 2.2) * 255.0;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_tables_match_definition(void)
+{
+    for (int i = 0; i < 256; ++i) {
+        TEST_ASSERT_EQUAL_UINT16(lround(pow(i / 255.0, 2.2) * 65535), GAMMA_TO_LINEAR[i]);
+    }
+    for (int j = 0; j < 4096; ++j) {
+        TEST_ASSERT_EQUAL_UINT8(lround(pow((j * 16 + 8) / 65535.0, 1 / 2.2) * 255), GAMMA_FROM_LINEAR[j]);
+    }
+    // 往返：每个码值转线性再转回不变
+    for (int i = 0; i < 256; ++i) {
+        TEST_ASSERT_EQUAL_UINT8(i, gamma_blend((uint8_t)i, (uint8_t)i, GAMMA_BLEND_ONE / 2));
+    }
+}
+
+// 误差界：整体最大 3.68 码值（两端都极暗时，出现在 (0,4)）；任一端 >= 32 时最大 1.79 码值
+void test_blend_error_bound(void)
+{
+    double maxErr = 0;
+    double maxErrBright = 0;
+    for (int a = 0; a < 256; ++a) {
+        for (int b = 0; b < 256; ++b) {
+            for (uint32_t t = 0; t <= GAMMA_BLEND_ONE; t += 16) {
+                double err = fabs(gamma_blend((uint8_t)a, (uint8_t)b, t) - reference_blend(a, b, t));
+                if (err > maxErr) {
+                    maxErr = err;
+                }
+                if ((a >= 32 || b >= 32) && err > maxErrBright) {
+                    maxErrBright = err;
+                }
+            }
+        }
+    }
+    TEST_ASSERT_TRUE(maxErr < 3.7);
+    TEST_ASSERT_TRUE(maxErrBright < 1.8);
+}
+
+void test_endpoints_range_and_monotonic(void)
+{
+    for (int a = 0; a < 256; ++a) {
+        for (int b = 0; b < 256; ++b) {
+            TEST_ASSERT_EQUAL_UINT8(a, gamma_blend((uint8_t)a, (uint8_t)b, 0));
+            TEST_ASSERT_EQUAL_UINT8(b, gamma_blend((uint8_t)a, (uint8_t)b, GAMMA_BLEND_ONE));
+            TEST_ASSERT_EQUAL_UINT8(b, gamma_blend((uint8_t)a, (uint8_t)b, GAMMA_BLEND_ONE + 100));
+            int lo = a < b ? a : b;
+            int hi = a < b ? b : a;
+            int prev = a;
+            for (uint32_t t = 0; t <= GAMMA_BLEND_ONE; t += 8) {
+                int c = gamma_blend((uint8_t)a, (uint8_t)b, t);
+                TEST_ASSERT_TRUE(c >= lo && c <= hi);
+                // a<b 时不减，a>b 时不增
+                TEST_ASSERT_TRUE(a <= b ? c >= prev : c <= prev);
+                prev = c;
+            }
+        }
+    }
+}
+
+void test_frame_blend(void)
+{
+    uint8_t from[256 * 3];
+    uint8_t to[256 * 3];
+    uint8_t dst[256 * 3];
+    for (int i = 0; i < (int)sizeof(from); ++i) {
+        from[i] = (uint8_t)(i * 7);
+        to[i] = (uint8_t)(255 - i * 3);
+    }
+    for (uint32_t t = 0; t <= GAMMA_BLEND_ONE; t += 64) {
+        gamma_blend_frame(from, to, dst, sizeof(dst), t, true);
+        for (int i = 0; i < (int)sizeof(dst); ++i) {
+            TEST_ASSERT_EQUAL_UINT8(gamma_blend(from[i], to[i], t), dst[i]);
+        }
+        // sRGB空间直接插值：与四舍五入的整数参考一致
+        gamma_blend_frame(from, to, dst, sizeof(dst), t, false);
+        for (int i = 0; i < (int)sizeof(dst); ++i) {
+            double ref = from[i] + (to[i] - from[i]) * (double)t / GAMMA_BLEND_ONE;
+            TEST_ASSERT_TRUE(fabs(dst[i] - ref) <= 0.5);
+        }
+    }
+    // t 超过1.0时按1.0处理
+    gamma_blend_frame(from, to, dst, sizeof(dst), GAMMA_BLEND_ONE * 2, false);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(to, dst, sizeof(dst));
+}
+
+// 原路径：每字节两端 powf 转线性、插值，再 powf 转回并 lroundf
+static void powf_blend_frame(const uint8_t* from, const uint8_t* to, uint8_t* dst, int len, float t)
+{
+    for (int i = 0; i < len; ++i) {
+        float a = powf(from[i] / 255.0f, 2.2f);
+        float b = powf(to[i] / 255.0f, 2.2f);
+        dst[i] = (uint8_t)lroundf(powf(a + (b - a) * t, 1.0f / 2.2f) * 255.0f);
+    }
+}
+
+// 每帧混合耗时：6x6 面板一帧（108字节）与单一颜色（3字节，色温过渡）
+void test_blend_cost(void)
+{
+    uint8_t from[108];
+    uint8_t to[108];
+    uint8_t dst[108];
+    for (int i = 0; i < (int)sizeof(from); ++i) {
+        from[i] = (uint8_t)(i * 37 + 5);
+        to[i] = (uint8_t)(250 - i * 11);
+    }
+    const int lengths[] = {3, 108};
+    for (size_t n = 0; n < sizeof(lengths) / sizeof(lengths[0]); ++n) {
+        const int len = lengths[n];
+        volatile uint32_t sink = 0;
+        BenchResult table = bench_best([&](int i) {
+            gamma_blend_frame(from, to, dst, len, (uint32_t)(i * 13) & 0xFFF, true);
+            sink = sink + dst[len - 1];
+        }, 20000);
+        BenchResult pow = bench_best([&](int i) {
+            powf_blend_frame(from, to, dst, len, ((i * 13) & 0xFFF) / (float)GAMMA_BLEND_ONE);
+            sink = sink + dst[len - 1];
+        }, 20000);
+        char msg[128];
+        snprintf(msg, sizeof(msg), "%3d bytes/frame: gamma LUT %.0f ns, powf %.0f ns", len, table.ns, pow.ns);
+        TEST_MESSAGE(msg);
+        TEST_ASSERT_TRUE(table.ns < pow.ns);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_tables_match_definition);
+    RUN_TEST(test_blend_error_bound);
+    RUN_TEST(test_endpoints_range_and_monotonic);
+    RUN_TEST(test_frame_blend);
+    RUN_TEST(test_blend_cost);
+    return UNITY_END();
+}
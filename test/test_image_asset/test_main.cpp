@@ -0,0 +1,131 @@
+// 素材头校验：头部不足3字节、帧数为0、帧延迟为0、负载短于或长于 帧数*108 时拒绝，
+// 失败时输出清零；有效素材原地引用数组。无效素材的 ImageDataEffect 播放黑帧且不提供常驻帧
+#include <unity.h>
+#include <string.h>
+#include "sid_test_support.h"
+#include "image_asset.h"
+#include "anim_effect.hpp"
+
+#define TEST_MAX_FRAMES 3
+static uint8_t s_asset[IMAGE_ASSET_HEADER_SIZE + TEST_MAX_FRAMES * IMAGE_ASSET_FRAME_SIZE + 16];
+
+// 在 s_asset 中写入帧数/延迟头和按序号填充的负载，返回恰好匹配的数组长度
+static size_t make_asset(uint16_t frameCount, uint8_t delayMs)
+{
+    for (size_t i = 0; i < sizeof(s_asset); ++i) {
+        s_asset[i] = (uint8_t)(i * 7 + 1);
+    }
+    s_asset[0] = (uint8_t)(frameCount >> 8);
+    s_asset[1] = (uint8_t)frameCount;
+    s_asset[2] = delayMs;
+    return IMAGE_ASSET_HEADER_SIZE + (size_t)frameCount * IMAGE_ASSET_FRAME_SIZE;
+}
+
+// 期望解析失败，输出被清零且给出原因
+static void expect_reject(const uint8_t* data, size_t size, const char* reason)
+{
+    ImageAssetInfo info;
+    memset(&info, 0xA5, sizeof(info));
+    const char* error = nullptr;
+    TEST_ASSERT_FALSE(image_asset_parse(data, size, &info, &error));
+    TEST_ASSERT_NULL(info.frames);
+    TEST_ASSERT_EQUAL_UINT16(0, info.frameCount);
+    TEST_ASSERT_EQUAL_UINT8(0, info.frameDelayMs);
+    TEST_ASSERT_NOT_NULL(error);
+    TEST_ASSERT_EQUAL_STRING(reason, error);
+}
+
+void setUp(void)
+{
+    sid_test_setup_default_panel();
+}
+
+void tearDown(void)
+{
+}
+
+void test_truncated_header(void)
+{
+    make_asset(1, 50);
+    expect_reject(nullptr, 111, "no data");
+    for (size_t size = 0; size < IMAGE_ASSET_HEADER_SIZE; ++size) {
+        expect_reject(s_asset, size, "truncated header");
+    }
+}
+
+void test_zero_frame_count(void)
+{
+    make_asset(0, 50);
+    expect_reject(s_asset, IMAGE_ASSET_HEADER_SIZE, "zero frame count");
+    expect_reject(s_asset, IMAGE_ASSET_HEADER_SIZE + IMAGE_ASSET_FRAME_SIZE, "zero frame count");
+}
+
+void test_zero_frame_delay(void)
+{
+    size_t size = make_asset(2, 0);
+    expect_reject(s_asset, size, "zero frame delay");
+}
+
+// 负载少于帧数所需（会读出数组之外）与多出尾部数据都拒绝，含差1字节
+void test_payload_mismatch(void)
+{
+    for (uint16_t frames = 1; frames <= TEST_MAX_FRAMES; ++frames) {
+        size_t size = make_asset(frames, 50);
+        expect_reject(s_asset, size - 1, "payload length does not match frame count");
+        expect_reject(s_asset, size - IMAGE_ASSET_FRAME_SIZE, "payload length does not match frame count");
+        expect_reject(s_asset, size + 1, "payload length does not match frame count");
+        expect_reject(s_asset, size + 16, "payload length does not match frame count");
+    }
+    // 帧数高字节：大帧数配小数组
+    make_asset(0x0101, 50);
+    expect_reject(s_asset, IMAGE_ASSET_HEADER_SIZE + IMAGE_ASSET_FRAME_SIZE, "payload length does not match frame count");
+}
+
+void test_valid_asset_in_place(void)
+{
+    const uint8_t delays[] = {1, 50, 255};
+    for (size_t d = 0; d < sizeof(delays); ++d) {
+        size_t size = make_asset(TEST_MAX_FRAMES, delays[d]);
+        ImageAssetInfo info;
+        const char* error = "unset";
+        TEST_ASSERT_TRUE(image_asset_parse(s_asset, size, &info, &error));
+        TEST_ASSERT_NULL(error);
+        TEST_ASSERT_EQUAL_PTR(s_asset + IMAGE_ASSET_HEADER_SIZE, info.frames);
+        TEST_ASSERT_EQUAL_UINT16(TEST_MAX_FRAMES, info.frameCount);
+        TEST_ASSERT_EQUAL_UINT8(delays[d], info.frameDelayMs);
+    }
+}
+
+// 无效素材：效果播放黑帧、无常驻帧，帧数按1帧处理
+void test_invalid_asset_plays_black(void)
+{
+    size_t size = make_asset(2, 50);
+    ImageDataEffect effect(s_asset, size + 1);
+    TEST_ASSERT_FALSE(effect.isValid());
+    TEST_ASSERT_EQUAL_STRING("payload length does not match frame count", effect.getError());
+    TEST_ASSERT_EQUAL_INT(1, effect.getFrameCount());
+    TEST_ASSERT_NULL(effect.frameData(0));
+    uint8_t frame[PANEL_MAX_CHIPS * 3];
+    memset(frame, 0x5A, sizeof(frame));
+    effect.renderFrame(0, frame, panel_frame_size());
+    for (int i = 0; i < panel_frame_size(); ++i) {
+        TEST_ASSERT_EQUAL_UINT8(0, frame[i]);
+    }
+
+    TEST_ASSERT_TRUE(effect.setImageData(s_asset, size));
+    TEST_ASSERT_EQUAL_INT(2, effect.getFrameCount());
+    TEST_ASSERT_EQUAL_PTR(s_asset + IMAGE_ASSET_HEADER_SIZE + IMAGE_ASSET_FRAME_SIZE, effect.frameData(1));
+    TEST_ASSERT_NULL(effect.frameData(2));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_truncated_header);
+    RUN_TEST(test_zero_frame_count);
+    RUN_TEST(test_zero_frame_delay);
+    RUN_TEST(test_payload_mismatch);
+    RUN_TEST(test_valid_asset_in_place);
+    RUN_TEST(test_invalid_asset_plays_black);
+    return UNITY_END();
+}
@@ -0,0 +1,226 @@
+// 叠加层混合：32位SWAR实现与逐字节标量参考逐字节一致
+// （全部模式 x 全部不透明度 x 全部 (下层,层) 字节对；含非4字节对齐的长度与地址，及 REPLACE 的黑色透明像素）；
+// 主机基准报告每帧合成耗时随层数的变化
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_support.h"
+#include "layer_compositor.hpp"
+
+static const LayerBlendMode MODES[] = {LAYER_REPLACE, LAYER_ADD, LAYER_MULTIPLY, LAYER_ALPHA, LAYER_MAX};
+static const int MODE_COUNT = sizeof(MODES) / sizeof(MODES[0]);
+static int s_benchFrameSize = 0;
+
+// 标量参考：不透明度 0..255 对应 alpha 0..256（255 为1.0），按通道运算
+static uint8_t reference_byte(uint8_t a, uint8_t b, LayerBlendMode mode, uint8_t opacity)
+{
+    uint32_t alpha = opacity + (opacity >> 7);
+    uint32_t scaled = (b * alpha) >> 8;
+    switch (mode) {
+    case LAYER_ADD:
+        return a + scaled > 255 ? 255 : (uint8_t)(a + scaled);
+    case LAYER_MAX:
+        return scaled > a ? (uint8_t)scaled : a;
+    case LAYER_MULTIPLY: {
+        uint32_t m = 255 - (((255 - b) * alpha) >> 8);
+        return (uint8_t)((a * m + 127) / 255);
+    }
+    default:  // ALPHA / REPLACE 的非黑像素
+        return (uint8_t)(((a * (256 - alpha)) >> 8) + scaled);
+    }
+}
+
+static void reference_blend(uint8_t* dst, const uint8_t* src, int len, LayerBlendMode mode, uint8_t opacity)
+{
+    if (opacity == 0) {
+        return;
+    }
+    if (mode == LAYER_REPLACE) {
+        for (int i = 0; i + 2 < len; i += 3) {
+            if (src[i] == 0 && src[i + 1] == 0 && src[i + 2] == 0) {
+                continue;
+            }
+            for (int c = i; c < i + 3; ++c) {
+                dst[c] = reference_byte(dst[c], src[c], LAYER_ALPHA, opacity);
+            }
+        }
+        return;
+    }
+    for (int i = 0; i < len; ++i) {
+        dst[i] = reference_byte(dst[i], src[i], mode, opacity);
+    }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 所有 (a,b) 字节对排成一帧（65536字节，4字节一组），每种模式、每个不透明度逐字节比较
+void test_all_byte_pairs_match_scalar(void)
+{
+    static uint8_t base[65536];
+    static uint8_t layer[65536];
+    static uint8_t dst[65536];
+    static uint8_t expected[65536];
+    for (int i = 0; i < 65536; ++i) {
+        base[i] = (uint8_t)(i >> 8);
+        layer[i] = (uint8_t)i;
+    }
+    for (int m = 0; m < MODE_COUNT; ++m) {
+        if (MODES[m] == LAYER_REPLACE) {
+            continue;  // 按像素判断透明，下面单独覆盖
+        }
+        for (int opacity = 0; opacity < 256; ++opacity) {
+            memcpy(dst, base, sizeof(dst));
+            memcpy(expected, base, sizeof(expected));
+            layer_blend(dst, layer, sizeof(dst), MODES[m], (uint8_t)opacity);
+            reference_blend(expected, layer, sizeof(expected), MODES[m], (uint8_t)opacity);
+            if (memcmp(expected, dst, sizeof(dst)) != 0) {
+                char msg[64];
+                snprintf(msg, sizeof(msg), "mode %d opacity %d", (int)MODES[m], opacity);
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+    }
+}
+
+// 随机帧：长度与起始地址不按4字节对齐（覆盖尾部逐字节路径），层中约1/4像素为黑色
+void test_random_unaligned_frames_match_scalar(void)
+{
+    uint8_t dstBuf[3 * 97 + 8];
+    uint8_t srcBuf[3 * 97 + 8];
+    uint8_t expected[3 * 97 + 8];
+    srand(18);
+    for (int n = 0; n < 20000; ++n) {
+        int pixels = 1 + rand() % 97;
+        int len = pixels * 3;
+        uint8_t* dst = dstBuf + rand() % 4;
+        uint8_t* src = srcBuf + rand() % 4;
+        for (int i = 0; i < len; ++i) {
+            dst[i] = (uint8_t)rand();
+            src[i] = (uint8_t)rand();
+        }
+        for (int p = 0; p < pixels; ++p) {
+            if (rand() % 4 == 0) {
+                memset(src + p * 3, 0, 3);
+            }
+        }
+        LayerBlendMode mode = MODES[rand() % MODE_COUNT];
+        uint8_t opacity = (uint8_t)(n % 7 == 0 ? 255 : rand());
+        memcpy(expected, dst, len);
+        layer_blend(dst, src, len, mode, opacity);
+        reference_blend(expected, src, len, mode, opacity);
+        if (memcmp(expected, dst, len) != 0) {
+            char msg[80];
+            snprintf(msg, sizeof(msg), "iteration %d mode %d opacity %d len %d", n, (int)mode, opacity, len);
+            TEST_FAIL_MESSAGE(msg);
+        }
+    }
+}
+
+// REPLACE：黑色像素不改变下层，非黑像素全不透明时整像素替换
+void test_replace_black_is_transparent(void)
+{
+    uint8_t dst[12] = {10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120};
+    const uint8_t src[12] = {0, 0, 0, 1, 0, 0, 0, 0, 0, 255, 128, 0};
+    const uint8_t expected[12] = {10, 20, 30, 1, 0, 0, 70, 80, 90, 255, 128, 0};
+    layer_blend(dst, src, sizeof(dst), LAYER_REPLACE, 255);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, dst, sizeof(dst));
+}
+
+// 基准用层效果：2帧、20ms帧间隔，按帧号填充固定图案
+class PatternEffect : public AnimEffect {
+public:
+    void renderFrame(int index, uint8_t* dst, int frameSize) override
+    {
+        for (int i = 0; i < frameSize; ++i) {
+            dst[i] = (uint8_t)(i * 29 + index * 101 + 1);
+        }
+    }
+    const char* getName() const override { return "Pattern"; }
+    int getFrameCount() const override { return 2; }
+    int getFrameDelay() const override { return 20; }
+};
+
+static void render_layer(void*, AnimEffect* effect, int index, uint8_t* dst)
+{
+    effect->renderFrame(index, dst, s_benchFrameSize);
+}
+
+// 每帧合成耗时：6x6（108字节）与 32x32（3072字节）帧，0..3 层、各混合模式。
+// 层帧未到期（只混合）与每帧都到期（渲染+混合）两种情况；不透明度为0的层跳过，不比一层可见层更贵
+void test_composite_cost_by_layer_count(void)
+{
+    static const char* MODE_NAMES[] = {"replace", "add", "multiply", "alpha", "max"};
+    static uint8_t base[3072];
+    static uint8_t frame[3072];
+    static uint8_t pixels[LAYER_MAX_COUNT][3072];
+    uint8_t* buffers[LAYER_MAX_COUNT] = {pixels[0], pixels[1], pixels[2]};
+    PatternEffect effects[LAYER_MAX_COUNT];
+    const int frameSizes[] = {108, 3072};
+    volatile uint32_t sink = 0;
+    for (int i = 0; i < (int)sizeof(base); ++i) {
+        base[i] = (uint8_t)(i * 13 + 7);
+    }
+    for (size_t s = 0; s < sizeof(frameSizes) / sizeof(frameSizes[0]); ++s) {
+        s_benchFrameSize = frameSizes[s];
+        for (int m = 0; m < MODE_COUNT; ++m) {
+            char msg[200];
+            int len = snprintf(msg, sizeof(msg), "%4d B %-8s ns/frame (blend only / render+blend):", s_benchFrameSize,
+                               MODE_NAMES[m]);
+            double blendOnly[LAYER_MAX_COUNT + 1];
+            for (int layers = 0; layers <= LAYER_MAX_COUNT; ++layers) {
+                LayerCompositor compositor;
+                compositor.init(buffers, s_benchFrameSize, render_layer, nullptr);
+                for (int l = 0; l < layers; ++l) {
+                    compositor.add(&effects[l], MODES[m], 77);
+                }
+                uint64_t nowUs = 0;
+                compositor.composite(frame, nowUs);
+                // 层帧未到期：时间停在首帧之后
+                blendOnly[layers] = bench_best([&](int) {
+                    memcpy(frame, base, s_benchFrameSize);
+                    compositor.composite(frame, nowUs);
+                    sink = sink + frame[0];
+                }, 200).ns;
+                // 每帧都跨过层帧间隔
+                double rendered = bench_best([&](int) {
+                    memcpy(frame, base, s_benchFrameSize);
+                    nowUs += 20000;
+                    compositor.composite(frame, nowUs);
+                    sink = sink + frame[0];
+                }, 200).ns;
+                len += snprintf(msg + len, sizeof(msg) - len, " %dL %.0f/%.0f", layers, blendOnly[layers], rendered);
+            }
+            TEST_MESSAGE(msg);
+            if (s_benchFrameSize == 3072) {
+                LayerCompositor compositor;
+                compositor.init(buffers, s_benchFrameSize, render_layer, nullptr);
+                for (int l = 0; l < LAYER_MAX_COUNT; ++l) {
+                    compositor.add(&effects[l], MODES[m], 0);
+                }
+                double hidden = bench_best([&](int) {
+                    memcpy(frame, base, s_benchFrameSize);
+                    compositor.composite(frame, 0);
+                    sink = sink + frame[0];
+                }, 200).ns;
+                TEST_ASSERT_TRUE(hidden < blendOnly[1]);
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_all_byte_pairs_match_scalar);
+    RUN_TEST(test_random_unaligned_frames_match_scalar);
+    RUN_TEST(test_replace_black_is_transparent);
+    RUN_TEST(test_composite_cost_by_layer_count);
+    return UNITY_END();
+}
@@ -0,0 +1,172 @@
+// 多通道输出：引脚白名单校验；各子链长度之和等于链长，逐通道线上数据拼接后与单通道发送一致
+#include <unity.h>
+#include "sid_test_support.h"
+
+static const uint8_t FREE_OUTPUT_PINS[] = {4, 13, 14, 16, 17, 18, 19, 21, 22, 23, 25, 27, 32};
+
+static uint32_t s_seed = 1;
+
+static uint8_t next_random(void)
+{
+    s_seed = s_seed * 1103515245u + 12345u;
+    return (uint8_t)(s_seed >> 16);
+}
+
+static bool is_free_output_pin(int gpio)
+{
+    for (size_t i = 0; i < sizeof(FREE_OUTPUT_PINS); ++i) {
+        if (FREE_OUTPUT_PINS[i] == gpio) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void setUp(void)
+{
+    fake_nvs().clear();
+}
+
+void tearDown(void)
+{
+}
+
+void test_only_free_output_pins_accepted(void)
+{
+    for (int gpio = 0; gpio < 256; ++gpio) {
+        PanelChannel ch = {36, (uint8_t)gpio};
+        bool saved = panel_save(6, 6, nullptr, &ch, 1);
+        char msg[32];
+        snprintf(msg, sizeof(msg), "gpio %d", gpio);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(is_free_output_pin(gpio), saved, msg);
+    }
+    // 板载外设与启动相关引脚
+    const uint8_t reserved[] = {0, 1, 2, 3, 5, 6, 11, 12, 15, 20, 24, 26, 28, 31, 33, 34, 39};
+    for (size_t i = 0; i < sizeof(reserved); ++i) {
+        PanelChannel ch = {36, reserved[i]};
+        TEST_ASSERT_FALSE(panel_save(6, 6, nullptr, &ch, 1));
+    }
+}
+
+void test_invalid_splits_rejected(void)
+{
+    PanelChannel shortSplit[2] = {{100, 25}, {155, 27}};
+    TEST_ASSERT_FALSE(panel_save(16, 16, nullptr, shortSplit, 2));
+    PanelChannel longSplit[2] = {{100, 25}, {157, 27}};
+    TEST_ASSERT_FALSE(panel_save(16, 16, nullptr, longSplit, 2));
+    PanelChannel emptyPart[2] = {{256, 25}, {0, 27}};
+    TEST_ASSERT_FALSE(panel_save(16, 16, nullptr, emptyPart, 2));
+    PanelChannel samePin[2] = {{128, 25}, {128, 25}};
+    TEST_ASSERT_FALSE(panel_save(16, 16, nullptr, samePin, 2));
+    PanelChannel tooMany[PANEL_MAX_CHANNELS + 1] = {{50, 4}, {50, 13}, {50, 14}, {50, 16}, {56, 17}};
+    TEST_ASSERT_FALSE(panel_save(16, 16, nullptr, tooMany, PANEL_MAX_CHANNELS + 1));
+}
+
+// 在 layout 划分下发送 frame，逐通道解码并核对子链长度与拼接结果
+static void check_split(const uint16_t* order, const PanelChannel* layout, int count,
+                        const uint8_t* frame, const uint8_t* expected)
+{
+    TEST_ASSERT_TRUE(sid_test_setup_panel(16, 16, order, layout, count));
+    sid_rmt_set_async(false);
+    sid_test_full_brightness();
+    sid_power_set_budget_ma(0);
+
+    const PanelDescriptor& panel = panel_get();
+    TEST_ASSERT_EQUAL_INT(count, panel.channelCount);
+    int total = 0;
+    for (int c = 0; c < count; ++c) {
+        total += panel.channels[c].chipCount;
+    }
+    TEST_ASSERT_EQUAL_INT(panel.chipCount, total);
+
+    send_data(frame, panel_frame_size(), 0x1234);
+
+    uint8_t decoded[PANEL_MAX_CHIPS * 3];
+    int chips = 0;
+    for (int c = 0; c < count; ++c) {
+        SidDecodedFrame sub;
+        TEST_ASSERT_TRUE(sid_test_decode_last(sid_test_rmt_for_panel_channel(c), decoded + chips * 3,
+                                              sizeof(decoded) - chips * 3, &sub));
+        TEST_ASSERT_EQUAL_INT(layout[c].chipCount, sub.chipCount);
+        TEST_ASSERT_EQUAL_HEX16(0x1234, sub.gain);
+        chips += sub.chipCount;
+    }
+    TEST_ASSERT_EQUAL_INT(panel_chip_count(), chips);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, decoded, panel_frame_size());
+}
+
+void test_split_matches_single_channel(void)
+{
+    static uint16_t order[256];
+    for (int i = 0; i < 256; ++i) {
+        order[i] = (uint16_t)i;
+    }
+    for (int i = 255; i > 0; --i) {
+        int j = next_random() % (i + 1);
+        uint16_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+    uint8_t frame[256 * 3];
+    for (size_t i = 0; i < sizeof(frame); ++i) {
+        frame[i] = next_random();
+    }
+
+    // 单通道发送的链上数据作为基准
+    PanelChannel single[1] = {{256, 25}};
+    uint8_t expected[256 * 3];
+    TEST_ASSERT_TRUE(sid_test_setup_panel(16, 16, order, single, 1));
+    sid_rmt_set_async(false);
+    sid_test_full_brightness();
+    sid_power_set_budget_ma(0);
+    send_data(frame, sizeof(frame), 0x1234);
+    TEST_ASSERT_EQUAL_INT(256, sid_test_decode_chain(expected, sizeof(expected)));
+    for (int i = 0; i < 256; ++i) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(&frame[order[i] * 3], &expected[i * 3], 3);
+    }
+
+    PanelChannel two[2] = {{100, 25}, {156, 27}};
+    check_split(order, two, 2, frame, expected);
+    PanelChannel three[3] = {{1, 4}, {200, 32}, {55, 13}};
+    check_split(order, three, 3, frame, expected);
+    PanelChannel fourEven[4] = {{64, 16}, {64, 17}, {64, 18}, {64, 19}};
+    check_split(order, fourEven, 4, frame, expected);
+    PanelChannel fourUneven[4] = {{10, 21}, {20, 22}, {30, 23}, {196, 14}};
+    check_split(order, fourUneven, 4, frame, expected);
+}
+
+// 通道划分随机生成，多轮核对
+void test_random_splits(void)
+{
+    uint8_t frame[256 * 3];
+    uint8_t expected[256 * 3];
+    for (int round = 0; round < 50; ++round) {
+        for (size_t i = 0; i < sizeof(frame); ++i) {
+            frame[i] = next_random();
+        }
+        for (int i = 0; i < 256; ++i) {
+            memcpy(&expected[i * 3], &frame[i * 3], 3);
+        }
+        int count = 1 + next_random() % PANEL_MAX_CHANNELS;
+        PanelChannel layout[PANEL_MAX_CHANNELS];
+        int remaining = 256;
+        for (int c = 0; c < count; ++c) {
+            int left = count - c - 1;
+            int size = (c == count - 1) ? remaining : 1 + next_random() % (remaining - left);
+            layout[c].chipCount = (uint16_t)size;
+            layout[c].gpio = FREE_OUTPUT_PINS[(round + c * 3) % sizeof(FREE_OUTPUT_PINS)];
+            remaining -= size;
+        }
+        check_split(nullptr, layout, count, frame, expected);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_only_free_output_pins_accepted);
+    RUN_TEST(test_invalid_splits_rejected);
+    RUN_TEST(test_split_matches_single_channel);
+    RUN_TEST(test_random_splits);
+    return UNITY_END();
+}
@@ -0,0 +1,91 @@
+// 面板规模基准：36/144/256/1024颗芯片下每帧渲染+链序转换+编码的耗时与线上时长随芯片数线性增长
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include "sid_test_support.h"
+#include "anim_effect.hpp"
+
+struct ScalingPoint {
+    uint16_t width;
+    uint16_t height;
+    double nsPerChip;      // 主机上每颗芯片的渲染+编码耗时
+    uint32_t wireUs;       // 单通道每帧线上时长
+};
+
+static ScalingPoint s_points[] = {
+    {6, 6, 0, 0},
+    {12, 12, 0, 0},
+    {16, 16, 0, 0},
+    {32, 32, 0, 0},
+};
+static const int POINT_COUNT = sizeof(s_points) / sizeof(s_points[0]);
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 取多轮中最快一轮，减少主机调度抖动
+static double measure_ns_per_chip(AnimEffect* effect)
+{
+    const int frameSize = panel_frame_size();
+    static uint8_t matrix[PANEL_MAX_CHIPS * 3];
+    static uint8_t chain[PANEL_MAX_CHIPS * 3];
+    const int framesPerRound = 2048 / panel_chip_count() + 8;
+    double best = 1e30;
+    for (int round = 0; round < 7; ++round) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int f = 0; f < framesPerRound; ++f) {
+            effect->renderFrame(f % effect->getFrameCount(), matrix, frameSize);
+            sid_matrix_to_chain(matrix, chain, frameSize);
+            send_chain_data(chain, frameSize, 0xFFFF);
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        double perChip = ns / framesPerRound / panel_chip_count();
+        if (perChip < best) {
+            best = perChip;
+        }
+    }
+    return best;
+}
+
+void test_scaling(void)
+{
+    CandleFlameEffect candle;
+    for (int i = 0; i < POINT_COUNT; ++i) {
+        ScalingPoint& p = s_points[i];
+        TEST_ASSERT_TRUE(sid_test_setup_panel(p.width, p.height, nullptr));
+        sid_rmt_set_async(false);
+        sid_test_full_brightness();
+        sid_power_set_budget_ma(0);
+        TEST_ASSERT_EQUAL_INT(p.width * p.height, panel_chip_count());
+
+        p.nsPerChip = measure_ns_per_chip(&candle);
+        p.wireUs = sid_rmt_current_frame_wire_us();
+
+        char msg[96];
+        snprintf(msg, sizeof(msg), "%4d chips: %.1f ns/chip render+encode, wire %u us/frame, max %u fps",
+                 panel_chip_count(), p.nsPerChip, (unsigned)p.wireUs, (unsigned)sid_rmt_current_max_fps());
+        TEST_MESSAGE(msg);
+    }
+
+    // 编码开销按芯片线性：每芯片耗时不随链长明显增加（阈值放宽以容忍主机抖动）
+    for (int i = 1; i < POINT_COUNT; ++i) {
+        TEST_ASSERT_TRUE(s_points[i].nsPerChip < s_points[1].nsPerChip * 3.0);
+    }
+    // 线上时长 = 固定帧头帧尾 + 每芯片24位，差分应严格按芯片数成比例
+    uint32_t perChipUs0 = (s_points[1].wireUs - s_points[0].wireUs) / (144 - 36);
+    uint32_t perChipUs1 = (s_points[3].wireUs - s_points[2].wireUs) / (1024 - 256);
+    TEST_ASSERT_UINT_WITHIN(1, perChipUs0, perChipUs1);
+    TEST_ASSERT_TRUE(s_points[3].wireUs > s_points[0].wireUs);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_scaling);
+    return UNITY_END();
+}
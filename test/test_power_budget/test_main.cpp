@@ -0,0 +1,195 @@
+// 功率预算：估算值与电流值表（每码值1mA）及64位参考一致；限流器在预算内收敛、不振荡、
+// 负载下降后放开；发送路径上线上码值对应的电流不超出预算
+#include <unity.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sid_test_support.h"
+#include "power_budget.h"
+#include "cct_table.h"
+
+#define TEST_BUDGET_MA 8000
+#define TEST_CHIPS 36
+
+// 模拟发送路径的一帧：按亮度与当前缩放查表缩放、统计码值和、推进限流器，返回本帧估算电流
+static uint32_t run_frame(PowerBudget* pb, const uint8_t* img, int chips, uint8_t brightness)
+{
+    uint32_t sums[3] = {0, 0, 0};
+    for (int i = 0; i < chips * 3; ++i) {
+        uint32_t v = (uint32_t)img[i] * brightness * pb->scaleQ12 / (100u * POWER_SCALE_ONE);
+        sums[i % 3] += v > 255 ? 255 : v;
+    }
+    power_budget_update(pb, sums);
+    return pb->estimateMa;
+}
+
+static void fill(uint8_t* img, uint8_t value)
+{
+    memset(img, value, TEST_CHIPS * 3);
+}
+
+void setUp(void)
+{
+    sid_test_setup_default_panel();
+    sid_rmt_set_async(false);
+    sid_test_full_brightness();
+}
+
+void tearDown(void)
+{
+    sid_power_set_budget_ma(0);
+}
+
+// 色温表每一行即一颗芯片的实测电流（mA）
+void test_estimate_matches_current_table(void)
+{
+    PowerBudget pb;
+    power_budget_init(&pb, 0);
+    for (int i = 0; i < CCT_TABLE_STEPS * CCT_TABLE_DUV_VARIANTS; ++i) {
+        uint32_t sums[3] = {0, 0, 0};
+        power_accumulate(CCT_TABLE_RGB[i], 1, sums);
+        uint32_t expected = (uint32_t)CCT_TABLE_RGB[i][0] + CCT_TABLE_RGB[i][1] + CCT_TABLE_RGB[i][2];
+        TEST_ASSERT_EQUAL_UINT32(expected, power_estimate_ma(&pb, sums));
+        // 表名中的 200mA：每行三路合计约200mA
+        TEST_ASSERT_UINT_WITHIN(1, 200, expected);
+    }
+}
+
+void test_estimate_matches_64bit_reference(void)
+{
+    PowerBudget pb;
+    power_budget_init(&pb, 0);
+    srand(25);
+    for (int n = 0; n < 100000; ++n) {
+        uint32_t sums[3];
+        unsigned long long ua = 0;
+        for (int c = 0; c < 3; ++c) {
+            pb.uaPerCode[c] = (uint16_t)(rand() & 0xFFFF);
+            sums[c] = (uint32_t)(rand() % (PANEL_MAX_CHIPS * 255 + 1));
+            ua += (unsigned long long)sums[c] * pb.uaPerCode[c];
+        }
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)((ua + 500) / 1000), power_estimate_ma(&pb, sums));
+    }
+}
+
+// 6x6 全白 100%（27540mA）对 8000mA 预算：若干帧内收敛到预算内，此后不再超出、不回弹，也不过度压低
+void test_limiter_converges_without_oscillation(void)
+{
+    PowerBudget pb;
+    power_budget_init(&pb, TEST_BUDGET_MA);
+    uint8_t white[TEST_CHIPS * 3];
+    fill(white, 255);
+    int settle = -1;
+    uint32_t prev = 0;
+    for (int f = 0; f < 60; ++f) {
+        uint32_t est = run_frame(&pb, white, TEST_CHIPS, 100);
+        if (f == 0) {
+            TEST_ASSERT_EQUAL_UINT32(TEST_CHIPS * 3 * 255, est);
+        }
+        if (settle < 0 && est <= TEST_BUDGET_MA) {
+            settle = f;
+        }
+        if (settle >= 0) {
+            TEST_ASSERT_TRUE(est <= TEST_BUDGET_MA);
+            TEST_ASSERT_TRUE(f == settle || est <= prev);
+        }
+        prev = est;
+    }
+    TEST_ASSERT_TRUE(settle >= 0 && settle <= 10);
+    TEST_ASSERT_TRUE(prev >= TEST_BUDGET_MA - (TEST_BUDGET_MA >> POWER_HYSTERESIS_SHIFT));
+}
+
+// 负载下降后放开到 1.0，放开过程中不超出预算；预算内不缩放；预算0不限流
+void test_limiter_release_and_bypass(void)
+{
+    PowerBudget pb;
+    power_budget_init(&pb, TEST_BUDGET_MA);
+    uint8_t white[TEST_CHIPS * 3];
+    uint8_t grey[TEST_CHIPS * 3];
+    fill(white, 255);
+    fill(grey, 64);
+    for (int f = 0; f < 30; ++f) {
+        run_frame(&pb, white, TEST_CHIPS, 100);
+    }
+    TEST_ASSERT_TRUE(pb.scaleQ12 < POWER_SCALE_ONE);
+    int released = -1;
+    for (int f = 0; f < 200 && released < 0; ++f) {
+        TEST_ASSERT_TRUE(run_frame(&pb, grey, TEST_CHIPS, 100) <= TEST_BUDGET_MA);
+        if (pb.scaleQ12 == POWER_SCALE_ONE) {
+            released = f;
+        }
+    }
+    TEST_ASSERT_TRUE(released >= 0);
+
+    power_budget_init(&pb, 20000);
+    for (int f = 0; f < 10; ++f) {
+        run_frame(&pb, white, TEST_CHIPS, 50);
+    }
+    TEST_ASSERT_EQUAL_UINT32(POWER_SCALE_ONE, pb.scaleQ12);
+
+    power_budget_init(&pb, 0);
+    for (int f = 0; f < 10; ++f) {
+        run_frame(&pb, white, TEST_CHIPS, 100);
+    }
+    TEST_ASSERT_EQUAL_UINT32(POWER_SCALE_ONE, pb.scaleQ12);
+    TEST_ASSERT_EQUAL_UINT32(TEST_CHIPS * 3 * 255, pb.estimateMa);
+}
+
+// 黑白交替：全黑帧不含负载信息、保持缩放，白帧稳态下不超出预算
+void test_limiter_alternating_black_white(void)
+{
+    PowerBudget pb;
+    power_budget_init(&pb, TEST_BUDGET_MA);
+    uint8_t white[TEST_CHIPS * 3];
+    uint8_t black[TEST_CHIPS * 3];
+    fill(white, 255);
+    fill(black, 0);
+    for (int f = 0; f < 100; ++f) {
+        uint32_t est = run_frame(&pb, (f & 1) ? white : black, TEST_CHIPS, 100);
+        if (f > 20) {
+            TEST_ASSERT_TRUE(est <= TEST_BUDGET_MA);
+        }
+    }
+}
+
+// 发送路径：限流缩放并入亮度表，解码出的线上码值之和即估算电流，收敛后不超出预算
+void test_sender_enforces_budget(void)
+{
+    sid_power_set_budget_ma(TEST_BUDGET_MA);
+    TEST_ASSERT_EQUAL_UINT32(TEST_BUDGET_MA, sid_power_get_budget_ma());
+    int chips = panel_chip_count();
+    uint8_t frame[PANEL_MAX_CHIPS * 3];
+    uint8_t wire[PANEL_MAX_CHIPS * 3];
+    memset(frame, 255, chips * 3);
+    for (int f = 0; f < 40; ++f) {
+        send_chain_data(frame, chips * 3, 0xFFFF);
+        TEST_ASSERT_EQUAL_INT(chips, sid_test_decode_chain(wire, sizeof(wire)));
+        uint32_t wireMa = 0;
+        for (int i = 0; i < chips * 3; ++i) {
+            wireMa += wire[i];
+        }
+        TEST_ASSERT_EQUAL_UINT32(wireMa, sid_power_estimate_ma());
+        if (f >= 10) {
+            TEST_ASSERT_TRUE(wireMa <= TEST_BUDGET_MA);
+        }
+    }
+    TEST_ASSERT_TRUE(sid_power_scale_q12() < POWER_SCALE_ONE);
+
+    // 取消预算后按放开速率逐帧回到 1.0
+    sid_power_set_budget_ma(0);
+    for (int f = 0; f < 60; ++f) {
+        send_chain_data(frame, chips * 3, 0xFFFF);
+    }
+    TEST_ASSERT_EQUAL_UINT16(POWER_SCALE_ONE, sid_power_scale_q12());
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_estimate_matches_current_table);
+    RUN_TEST(test_estimate_matches_64bit_reference);
+    RUN_TEST(test_limiter_converges_without_oscillation);
+    RUN_TEST(test_limiter_release_and_bypass);
+    RUN_TEST(test_limiter_alternating_black_white);
+    RUN_TEST(test_sender_enforces_budget);
+    return UNITY_END();
+}
@@ -0,0 +1,146 @@
+// 异步双缓冲发送：下一帧的编码与本帧传输重叠，且线序缓冲在其传输完成前不被复用
+#include <unity.h>
+#include "sid_test_support.h"
+
+static FakeRmtChannel* s_ch;
+
+// 阻塞钩子在发送端等待通道空闲时被调用：记录此刻状态后完成在途传输
+static uint32_t s_hook_calls;
+static uint32_t s_hook_sent;
+static bool s_hook_busy;
+
+static void record_and_complete(void)
+{
+    uint32_t sent = 0;
+    sid_rmt_get_frame_stats(&sent, nullptr);
+    s_hook_calls++;
+    s_hook_sent = sent;
+    s_hook_busy = s_ch->busy;
+    fake_rmt_complete_all();
+}
+
+static void fill_frame(uint8_t* frame, int size, int seed)
+{
+    for (int i = 0; i < size; ++i) {
+        frame[i] = (uint8_t)(seed * 31 + i * 7);
+    }
+}
+
+static void check_last_completed(const uint8_t* expected, int size)
+{
+    uint8_t decoded[PANEL_MAX_CHIPS * 3];
+    SidDecodedFrame out;
+    TEST_ASSERT_TRUE_MESSAGE(sid_test_decode_last(s_ch, decoded, sizeof(decoded), &out), out.error);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, decoded, size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, s_ch->lastData, size);
+}
+
+void setUp(void)
+{
+    sid_test_setup_default_panel();
+    sid_test_full_brightness();
+    sid_rmt_set_async(true);
+    s_ch = sid_test_rmt_for_panel_channel(0);
+    s_hook_calls = 0;
+    s_hook_sent = 0;
+    s_hook_busy = false;
+    fake_block_hook().fn = record_and_complete;
+}
+
+void tearDown(void)
+{
+    fake_block_hook().fn = fake_rmt_complete_all;
+    sid_rmt_set_async(false);
+}
+
+void test_encode_overlaps_transmission(void)
+{
+    const int size = panel_frame_size();
+    uint8_t a[PANEL_MAX_CHIPS * 3], b[PANEL_MAX_CHIPS * 3];
+    fill_frame(a, size, 1);
+    fill_frame(b, size, 2);
+
+    send_chain_data(a, size, 0xFFFF);
+    // 启动即返回：帧A仍在线上
+    TEST_ASSERT_TRUE(s_ch->busy);
+    TEST_ASSERT_EQUAL_UINT32(0, s_ch->completed);
+    const uint8_t* slotA = s_ch->src;
+
+    send_chain_data(b, size, 0xFFFF);
+    // 发送端等待通道空闲时，帧B已编码并计入发送，帧A仍在传输
+    TEST_ASSERT_EQUAL_UINT32(1, s_hook_calls);
+    TEST_ASSERT_EQUAL_UINT32(2, s_hook_sent);
+    TEST_ASSERT_TRUE(s_hook_busy);
+    // 帧B写入另一块缓冲，帧A完整发出
+    TEST_ASSERT_TRUE(s_ch->src != slotA);
+    TEST_ASSERT_EQUAL_UINT32(1, s_ch->completed);
+    TEST_ASSERT_TRUE(s_ch->lastSrc == slotA);
+    check_last_completed(a, size);
+    TEST_ASSERT_EQUAL_UINT32(0, s_ch->sourceChanged);
+    TEST_ASSERT_EQUAL_UINT32(0, s_ch->writesWhileBusy);
+}
+
+// 传输完成时机随机（有时在下一帧编码前，有时要等发送端阻塞），每帧都按原内容发出
+void test_buffer_not_reused_before_completion(void)
+{
+    const int size = panel_frame_size();
+    static uint8_t frames[200][PANEL_MAX_CHIPS * 3];
+    uint32_t rng = 12345;
+    uint32_t checked = 0;
+    for (int i = 0; i < 200; ++i) {
+        fill_frame(frames[i], size, i);
+        uint32_t before = s_ch->completed;
+        send_chain_data(frames[i], size, 0xFFFF);
+        rng = rng * 1103515245 + 12345;
+        if ((rng >> 16) % 3 == 0) {
+            fake_rmt_complete_all();
+        }
+        if (s_ch->completed != before) {
+            check_last_completed(frames[s_ch->completed - 1], size);
+            checked++;
+        }
+    }
+    fake_rmt_complete_all();
+    check_last_completed(frames[199], size);
+    TEST_ASSERT_EQUAL_UINT32(200, s_ch->completed);
+    TEST_ASSERT_GREATER_THAN_UINT32(100, checked);
+    TEST_ASSERT_EQUAL_UINT32(0, s_ch->sourceChanged);
+    TEST_ASSERT_EQUAL_UINT32(0, s_ch->writesWhileBusy);
+}
+
+void test_sync_mode_waits_for_completion(void)
+{
+    const int size = panel_frame_size();
+    uint8_t a[PANEL_MAX_CHIPS * 3];
+    fill_frame(a, size, 3);
+    sid_rmt_set_async(false);
+    send_chain_data(a, size, 0xFFFF);
+    TEST_ASSERT_FALSE(s_ch->busy);
+    TEST_ASSERT_EQUAL_UINT32(1, s_ch->completed);
+    check_last_completed(a, size);
+}
+
+// 关闭异步时等在途帧发完，之后的同步发送不与其重叠
+void test_disable_async_drains_in_flight_frame(void)
+{
+    const int size = panel_frame_size();
+    uint8_t a[PANEL_MAX_CHIPS * 3];
+    fill_frame(a, size, 4);
+    send_chain_data(a, size, 0xFFFF);
+    TEST_ASSERT_TRUE(s_ch->busy);
+    sid_rmt_set_async(false);
+    TEST_ASSERT_FALSE(s_ch->busy);
+    check_last_completed(a, size);
+    send_chain_data(a, size, 0xFFFF);
+    TEST_ASSERT_EQUAL_UINT32(0, s_ch->writesWhileBusy);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_encode_overlaps_transmission);
+    RUN_TEST(test_buffer_not_reused_before_completion);
+    RUN_TEST(test_sync_mode_waits_for_completion);
+    RUN_TEST(test_disable_async_drains_in_flight_frame);
+    return UNITY_END();
+}
@@ -0,0 +1,158 @@
+// 重复帧抑制：相同帧在保活周期内跳过；哈希相同但内容不同的帧必须发送
+#include <unity.h>
+#include <unordered_map>
+#include "sid_test_support.h"
+
+#define KEEPALIVE_MS 1000
+
+static uint32_t s_sent, s_skipped;
+
+static void stats_delta(uint32_t* sent, uint32_t* skipped)
+{
+    uint32_t a, b;
+    sid_rmt_get_frame_stats(&a, &b);
+    *sent = a - s_sent;
+    *skipped = b - s_skipped;
+}
+
+void setUp(void)
+{
+    sid_test_setup_default_panel();
+    sid_test_full_brightness();
+    sid_rmt_set_keepalive_ms(KEEPALIVE_MS);
+    sid_rmt_get_frame_stats(&s_sent, &s_skipped);
+}
+
+void tearDown(void)
+{
+    sid_rmt_set_async(false);
+}
+
+static void check_identical_frames_skipped(void)
+{
+    const int size = panel_frame_size();
+    uint8_t frame[PANEL_MAX_CHIPS * 3];
+    memset(frame, 0x40, size);
+    for (int i = 0; i < 10; ++i) {
+        send_chain_data(frame, size, 0xFFFF);
+        fake_clock_advance_ms(50);
+    }
+    uint32_t sent, skipped;
+    stats_delta(&sent, &skipped);
+    TEST_ASSERT_EQUAL_UINT32(1, sent);
+    TEST_ASSERT_EQUAL_UINT32(9, skipped);
+
+    // 保活周期到达后强制重发
+    fake_clock_advance_ms(KEEPALIVE_MS);
+    send_chain_data(frame, size, 0xFFFF);
+    stats_delta(&sent, &skipped);
+    TEST_ASSERT_EQUAL_UINT32(2, sent);
+
+    // 内容变化立即发送
+    frame[5] ^= 1;
+    send_chain_data(frame, size, 0xFFFF);
+    stats_delta(&sent, &skipped);
+    TEST_ASSERT_EQUAL_UINT32(3, sent);
+}
+
+void test_identical_frames_skipped_sync(void)
+{
+    check_identical_frames_skipped();
+}
+
+void test_identical_frames_skipped_async(void)
+{
+    sid_rmt_set_async(true);
+    check_identical_frames_skipped();
+}
+
+// FNV-1a 32位，与发送端线序帧哈希相同（亮度100%时线序字节即帧内容 + 增益 + 哨兵）
+static uint32_t fnv1a(uint32_t h, const uint8_t* data, int len)
+{
+    for (int i = 0; i < len; ++i) {
+        h = (h ^ data[i]) * 16777619UL;
+    }
+    return h;
+}
+
+// 随机改写末8字节做生日搜索，找出哈希相同而内容不同的两帧
+// （只改4字节时 FNV-1a 是一一映射，不会碰撞）
+static void fill_tail(uint8_t* tail8, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i) {
+        tail8[i] = (uint8_t)(v >> (i * 8));
+    }
+}
+
+static bool find_collision(uint8_t* a, uint8_t* b, int size)
+{
+    const uint8_t trailer[3] = {0xFF, 0xFF, 0x00};
+    uint32_t prefix = fnv1a(2166136261UL, a, size - 8);
+    std::unordered_map<uint32_t, uint64_t> seen;
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    for (int n = 0; n < (1 << 22); ++n) {
+        rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint8_t tail8[8];
+        fill_tail(tail8, rng);
+        uint32_t h = fnv1a(fnv1a(prefix, tail8, 8), trailer, 3);
+        std::unordered_map<uint32_t, uint64_t>::iterator it = seen.find(h);
+        if (it != seen.end() && it->second != rng) {
+            memcpy(b, a, size - 8);
+            fill_tail(a + size - 8, it->second);
+            memcpy(b + size - 8, tail8, 8);
+            return true;
+        }
+        seen[h] = rng;
+    }
+    return false;
+}
+
+static void check_collision_sent(void)
+{
+    const int size = panel_frame_size();
+    uint8_t a[PANEL_MAX_CHIPS * 3], b[PANEL_MAX_CHIPS * 3];
+    for (int i = 0; i < size; ++i) {
+        a[i] = (uint8_t)(i * 13);
+    }
+    TEST_ASSERT_TRUE(find_collision(a, b, size));
+    TEST_ASSERT_EQUAL_HEX32(fnv1a(2166136261UL, a, size), fnv1a(2166136261UL, b, size));
+    TEST_ASSERT_TRUE(memcmp(a, b, size) != 0);
+
+    send_chain_data(a, size, 0xFFFF);
+    send_chain_data(b, size, 0xFFFF);
+    uint32_t sent, skipped;
+    stats_delta(&sent, &skipped);
+    TEST_ASSERT_EQUAL_UINT32(2, sent);
+    TEST_ASSERT_EQUAL_UINT32(0, skipped);
+
+    fake_rmt_complete_all();
+    uint8_t decoded[PANEL_MAX_CHIPS * 3];
+    TEST_ASSERT_EQUAL_INT(panel_chip_count(), sid_test_decode_chain(decoded, sizeof(decoded)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(b, decoded, size);
+
+    // 再发一次b：内容确实相同，跳过
+    send_chain_data(b, size, 0xFFFF);
+    stats_delta(&sent, &skipped);
+    TEST_ASSERT_EQUAL_UINT32(1, skipped);
+}
+
+void test_hash_collision_is_sent_sync(void)
+{
+    check_collision_sent();
+}
+
+void test_hash_collision_is_sent_async(void)
+{
+    sid_rmt_set_async(true);
+    check_collision_sent();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_identical_frames_skipped_sync);
+    RUN_TEST(test_identical_frames_skipped_async);
+    RUN_TEST(test_hash_collision_is_sent_sync);
+    RUN_TEST(test_hash_collision_is_sent_async);
+    return UNITY_END();
+}
@@ -0,0 +1,171 @@
+// SID位编码：translator 输出的item与原逐位分支编码器（build_sid_rmt_items）逐字一致，
+// 覆盖全部字节值在 R/G/B 各位置及增益高低字节；主机基准对比每帧编码耗时
+#include <unity.h>
+#include <stdio.h>
+#include <vector>
+#include "sid_test_support.h"
+#include "bench_support.h"
+
+#define LEGACY_RESET_TICKS 16320
+
+// 原编码器：帧头Reset + 每芯片24位 + 16位增益 + 帧尾Reset，逐位分支、逐字段写入
+static void legacy_build_sid_rmt_items(const uint32_t* data, int chip_count, uint16_t gain, rmt_item32_t* items, int* item_count)
+{
+    int idx = 0;
+    items[idx].level0 = 0;
+    items[idx].duration0 = LEGACY_RESET_TICKS;
+    items[idx].level1 = 0;
+    items[idx].duration1 = 300;
+    idx++;
+    for (int i = 0; i < chip_count; ++i) {
+        uint32_t d = data[i];
+        for (int bit = 23; bit >= 0; --bit) {
+            if (d & (1U << bit)) {
+                items[idx].level0 = 1;
+                items[idx].duration0 = SID_TEST_T1H;
+                items[idx].level1 = 0;
+                items[idx].duration1 = SID_TEST_T1L;
+            } else {
+                items[idx].level0 = 1;
+                items[idx].duration0 = SID_TEST_T0H;
+                items[idx].level1 = 0;
+                items[idx].duration1 = SID_TEST_T0L;
+            }
+            idx++;
+        }
+    }
+    for (int bit = 15; bit >= 0; --bit) {
+        if (gain & (1U << bit)) {
+            items[idx].level0 = 1;
+            items[idx].duration0 = SID_TEST_T1H;
+            items[idx].level1 = 0;
+            items[idx].duration1 = SID_TEST_T1L;
+        } else {
+            items[idx].level0 = 1;
+            items[idx].duration0 = SID_TEST_T0H;
+            items[idx].level1 = 0;
+            items[idx].duration1 = SID_TEST_T0L;
+        }
+        idx++;
+    }
+    items[idx].level0 = 0;
+    items[idx].duration0 = LEGACY_RESET_TICKS;
+    items[idx].level1 = 0;
+    items[idx].duration1 = 100;
+    idx++;
+    *item_count = idx;
+}
+
+static void to_chip_words(const uint8_t* rgb, int chips, uint32_t* words)
+{
+    for (int i = 0; i < chips; ++i) {
+        words[i] = ((uint32_t)rgb[i * 3] << 16) | ((uint32_t)rgb[i * 3 + 1] << 8) | rgb[i * 3 + 2];
+    }
+}
+
+static uint32_t low_ticks(const uint32_t* items, int count)
+{
+    uint32_t ticks = 0;
+    for (int i = 0; i < count; ++i) {
+        ticks += (items[i] & 0x7FFF) + ((items[i] >> 16) & 0x7FFF);
+    }
+    return ticks;
+}
+
+void setUp(void)
+{
+    sid_rmt_set_async(false);
+    sid_rmt_set_timing_profile(SID_TIMING_STANDARD);
+}
+
+void tearDown(void)
+{
+}
+
+// 16x16 面板：芯片 i 为 (i, i+85, i+170)，每个字节值在 R/G/B 各位置各出现一次；
+// 256 帧的增益覆盖全部高/低字节值。数据与增益item逐字相同；帧头拆成8个item、帧尾均分到两个字段，
+// 总低电平与原帧头/帧尾相同
+void test_items_match_legacy_encoder(void)
+{
+    TEST_ASSERT_TRUE(sid_test_setup_panel(16, 16, nullptr));
+    sid_test_full_brightness();
+    sid_power_set_budget_ma(0);
+    const int chips = panel_chip_count();
+    std::vector<uint8_t> frame(chips * 3);
+    std::vector<uint32_t> words(chips);
+    std::vector<rmt_item32_t> legacy(2 + 24 * chips + 16);
+    for (int k = 0; k < 256; ++k) {
+        for (int i = 0; i < chips; ++i) {
+            frame[i * 3 + 0] = (uint8_t)(i + k);
+            frame[i * 3 + 1] = (uint8_t)(i + k + 85);
+            frame[i * 3 + 2] = (uint8_t)(i + k + 170);
+        }
+        const uint16_t gain = (uint16_t)((k << 8) | (k ^ 0xA5));
+        send_chain_data(frame.data(), chips * 3, gain);
+        const FakeRmtChannel* ch = sid_test_rmt_for_panel_channel(0);
+
+        to_chip_words(frame.data(), chips, words.data());
+        int legacyCount = 0;
+        legacy_build_sid_rmt_items(words.data(), chips, gain, legacy.data(), &legacyCount);
+        const int dataItems = 24 * chips + 16;
+        // 帧头8个 + 数据/增益 + 帧尾1个
+        TEST_ASSERT_EQUAL_INT(legacyCount + 7, ch->lastItemCount);
+        TEST_ASSERT_EQUAL_UINT32(legacy[0].duration0 + legacy[0].duration1, low_ticks(ch->lastItems, 8));
+        for (int i = 0; i < dataItems; ++i) {
+            if (ch->lastItems[8 + i] != legacy[1 + i].val) {
+                char msg[64];
+                snprintf(msg, sizeof(msg), "frame %d item %d", k, i);
+                TEST_ASSERT_EQUAL_HEX32_MESSAGE(legacy[1 + i].val, ch->lastItems[8 + i], msg);
+            }
+        }
+        TEST_ASSERT_EQUAL_UINT32(legacy[legacyCount - 1].duration0 + legacy[legacyCount - 1].duration1,
+                                 low_ticks(ch->lastItems + 8 + dataItems, 1));
+    }
+}
+
+// 每帧编码耗时：原编码器（芯片字 -> item数组）与 translator（线序字节流 -> item），36 / 1024 颗芯片
+void test_encode_cost(void)
+{
+    TEST_ASSERT_TRUE(sid_test_setup_panel(32, 32, nullptr));
+    const FakeRmtChannel* ch = sid_test_rmt_for_panel_channel(0);
+    TEST_ASSERT_NOT_NULL(ch);
+    sample_to_rmt_t translator = ch->translator;
+    const int chipCounts[] = {36, 1024};
+    for (size_t n = 0; n < sizeof(chipCounts) / sizeof(chipCounts[0]); ++n) {
+        const int chips = chipCounts[n];
+        // 线序流：RGB + 增益2字节 + 帧尾哨兵（非帧起点，translator 不插入帧头）
+        std::vector<uint8_t> wire(chips * 3 + 3);
+        for (size_t i = 0; i < wire.size(); ++i) {
+            wire[i] = (uint8_t)(i * 151 + 7);
+        }
+        std::vector<uint32_t> words(chips);
+        to_chip_words(wire.data(), chips, words.data());
+        std::vector<rmt_item32_t> items(2 + 24 * chips + 16 + 8);
+        volatile uint32_t sink = 0;
+
+        BenchResult legacy = bench_best([&](int) {
+            int count = 0;
+            legacy_build_sid_rmt_items(words.data(), chips, 0xFFFF, items.data(), &count);
+            sink = sink + items[count / 2].val;
+        }, 2048 / chips + 16);
+        BenchResult table = bench_best([&](int) {
+            size_t used = 0, produced = 0;
+            translator(wire.data(), items.data(), wire.size(), wire.size() * 8, &used, &produced);
+            sink = sink + items[produced / 2].val;
+        }, 2048 / chips + 16);
+
+        char msg[160];
+        snprintf(msg, sizeof(msg), "%4d chips/frame: branchy encoder %.0f ns (%.0f cycles), item-word table %.0f ns (%.0f cycles)",
+                 chips, legacy.ns, legacy.cycles, table.ns, table.cycles);
+        TEST_MESSAGE(msg);
+        TEST_ASSERT_TRUE(table.ns < legacy.ns);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_items_match_legacy_encoder);
+    RUN_TEST(test_encode_cost);
+    return UNITY_END();
+}
@@ -0,0 +1,126 @@
+// 流式 translator：经 RMT 替身按块调用（首块整块、之后半块），输出波形须与一次性整帧编码逐段一致
+#include <unity.h>
+#include <vector>
+#include "sid_test_support.h"
+
+struct Run {
+    int level;
+    uint32_t ticks;
+    bool operator==(const Run& o) const { return level == o.level && ticks == o.ticks; }
+};
+
+static void append_run(std::vector<Run>& runs, int level, uint32_t ticks)
+{
+    if (ticks == 0) {
+        return;
+    }
+    if (!runs.empty() && runs.back().level == level) {
+        runs.back().ticks += ticks;
+    } else {
+        Run r = {level, ticks};
+        runs.push_back(r);
+    }
+}
+
+// item序列 -> 电平段（相邻同电平合并，duration为0结束）
+static std::vector<Run> to_runs(const uint32_t* items, int count)
+{
+    std::vector<Run> runs;
+    for (int i = 0; i < count; ++i) {
+        uint32_t w = items[i];
+        uint32_t d0 = w & 0x7FFF, d1 = (w >> 16) & 0x7FFF;
+        if (d0 == 0) break;
+        append_run(runs, (w >> 15) & 1, d0);
+        if (d1 == 0) break;
+        append_run(runs, w >> 31, d1);
+    }
+    return runs;
+}
+
+// 参照：整帧一次性编码（帧头Reset + 每芯片24位 + 16位增益 + 帧尾Reset）
+static std::vector<Run> reference_runs(const uint8_t* wire, int chips, uint16_t gain, const SidTimingProfile& timing)
+{
+    std::vector<Run> runs;
+    append_run(runs, 0, timing.headLowTicks);
+    for (int i = 0; i < chips * 3 + 2; ++i) {
+        uint8_t byte = i < chips * 3 ? wire[i] : (i == chips * 3 ? gain >> 8 : gain & 0xFF);
+        for (int bit = 7; bit >= 0; --bit) {
+            bool one = (byte >> bit) & 1;
+            append_run(runs, 1, one ? SID_TEST_T1H : SID_TEST_T0H);
+            append_run(runs, 0, one ? SID_TEST_T1L : SID_TEST_T0L);
+        }
+    }
+    append_run(runs, 0, timing.tailLowTicks);
+    return runs;
+}
+
+static void check_panel(uint16_t width, uint16_t height, size_t first, size_t next)
+{
+    TEST_ASSERT_TRUE(sid_test_setup_panel(width, height, nullptr));
+    sid_test_full_brightness();
+    fake_rmt().firstChunk = first;
+    fake_rmt().nextChunk = next;
+    const int size = panel_frame_size();
+    std::vector<uint8_t> frame(size);
+    for (int i = 0; i < size; ++i) {
+        frame[i] = (uint8_t)(i * 151 + width);
+    }
+    const uint16_t gain = (uint16_t)(0x8001 + width * 257);
+    const SidTimingProfile* profiles[] = {&SID_TIMING_STANDARD, &SID_TIMING_SID_MIN_SAFE};
+    for (int p = 0; p < 2; ++p) {
+        TEST_ASSERT_TRUE(sid_rmt_set_timing_profile(*profiles[p]));
+        send_chain_data(frame.data(), size, gain);
+        const FakeRmtChannel* ch = sid_test_rmt_for_panel_channel(0);
+        TEST_ASSERT_EQUAL_UINT32(0, ch->chunkErrors);
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)size + 3, ch->consumed);
+        std::vector<Run> got = to_runs(ch->lastItems, ch->lastItemCount);
+        std::vector<Run> want = reference_runs(frame.data(), panel_chip_count(), gain, *profiles[p]);
+        TEST_ASSERT_EQUAL_UINT32(want.size(), got.size());
+        TEST_ASSERT_TRUE(got == want);
+    }
+}
+
+void setUp(void)
+{
+    sid_rmt_set_async(false);
+}
+
+void tearDown(void)
+{
+    fake_rmt().firstChunk = 64;
+    fake_rmt().nextChunk = 32;
+    sid_rmt_set_timing_profile(SID_TIMING_STANDARD);
+}
+
+// 1..48颗芯片的单行链：帧尾哨兵落在各种块内位置（含恰好填满一块）
+void test_chain_lengths_driver_chunks(void)
+{
+    for (uint16_t n = 1; n <= 48; ++n) {
+        check_panel(n, 1, 64, 32);
+    }
+}
+
+void test_large_panels_driver_chunks(void)
+{
+    check_panel(16, 16, 64, 32);
+    check_panel(32, 32, 64, 32);
+}
+
+// 其他块长（RMT内存块数不同时驱动的请求量）同样逐段一致
+void test_other_chunk_sizes(void)
+{
+    for (uint16_t n = 1; n <= 24; ++n) {
+        check_panel(n, 1, 128, 64);
+        check_panel(n, 1, 16, 8);
+    }
+    check_panel(32, 32, 128, 64);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_chain_lengths_driver_chunks);
+    RUN_TEST(test_large_panels_driver_chunks);
+    RUN_TEST(test_other_chunk_sizes);
+    return UNITY_END();
+}
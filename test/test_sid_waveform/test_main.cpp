@@ -0,0 +1,171 @@
+// SID波形：经 RMT 替身按驱动分块调用 translator，把输出的item解码回位、复位时长与增益，
+// 逐个时序档校验
+#include <unity.h>
+#include "sid_test_support.h"
+
+static const SidTimingProfile* const PROFILES[] = {&SID_TIMING_STANDARD, &SID_TIMING_SID_MIN_SAFE};
+static const int PROFILE_COUNT = sizeof(PROFILES) / sizeof(PROFILES[0]);
+
+void setUp(void)
+{
+    sid_test_setup_default_panel();
+    sid_rmt_set_async(false);
+    sid_test_full_brightness();
+}
+
+void tearDown(void)
+{
+    sid_rmt_set_timing_profile(SID_TIMING_STANDARD);
+}
+
+static uint32_t expected_frame_ticks(const SidTimingProfile& timing, int chips)
+{
+    return timing.headLowTicks + timing.tailLowTicks + ((uint32_t)chips * 24 + 16) * SID_TEST_BIT_TICKS;
+}
+
+static void check_round_trip(const SidTimingProfile& timing, uint16_t gain, int seed)
+{
+    const int size = panel_frame_size();
+    uint8_t frame[PANEL_MAX_CHIPS * 3];
+    uint8_t decoded[PANEL_MAX_CHIPS * 3];
+    for (int i = 0; i < size; ++i) {
+        frame[i] = (uint8_t)(i * 37 + seed);
+    }
+    send_chain_data(frame, size, gain);
+
+    const FakeRmtChannel* ch = sid_test_rmt_for_panel_channel(0);
+    TEST_ASSERT_NOT_NULL(ch);
+    TEST_ASSERT_EQUAL_UINT32(0, ch->chunkErrors);
+    SidDecodedFrame out;
+    TEST_ASSERT_TRUE_MESSAGE(sid_test_decode_last(ch, decoded, sizeof(decoded), &out), out.error);
+    TEST_ASSERT_EQUAL_INT(panel_chip_count(), out.chipCount);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, decoded, size);
+    TEST_ASSERT_EQUAL_HEX16(gain, out.gain);
+    TEST_ASSERT_EQUAL_UINT32(timing.headLowTicks, out.headLowTicks);
+    TEST_ASSERT_EQUAL_UINT32(timing.tailLowTicks, out.tailLowTicks);
+    TEST_ASSERT_EQUAL_UINT32(expected_frame_ticks(timing, out.chipCount), out.totalTicks);
+    // 线上时长模型与实际波形一致
+    TEST_ASSERT_EQUAL_UINT32((out.totalTicks + 79) / 80, sid_rmt_chain_wire_us(out.chipCount, timing));
+}
+
+void test_round_trip_each_profile(void)
+{
+    for (int p = 0; p < PROFILE_COUNT; ++p) {
+        TEST_ASSERT_TRUE(sid_rmt_set_timing_profile(*PROFILES[p]));
+        check_round_trip(*PROFILES[p], 0xA55A, 11);
+        check_round_trip(*PROFILES[p], 0xFFFF, 0);
+        check_round_trip(*PROFILES[p], 0x0000, 200);
+    }
+}
+
+// 每个字节值（全部位组合）都经过一次编码
+void test_every_byte_value(void)
+{
+    const int size = panel_frame_size();
+    uint8_t frame[PANEL_MAX_CHIPS * 3];
+    uint8_t decoded[PANEL_MAX_CHIPS * 3];
+    for (int p = 0; p < PROFILE_COUNT; ++p) {
+        TEST_ASSERT_TRUE(sid_rmt_set_timing_profile(*PROFILES[p]));
+        for (int base = 0; base < 256; base += size) {
+            for (int i = 0; i < size; ++i) {
+                frame[i] = (uint8_t)(base + i);
+            }
+            send_chain_data(frame, size, 0x1234);
+            SidDecodedFrame out;
+            TEST_ASSERT_TRUE_MESSAGE(sid_test_decode_last(sid_test_rmt_for_panel_channel(0), decoded, sizeof(decoded), &out),
+                                     out.error);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, decoded, size);
+        }
+    }
+}
+
+// 矩阵序帧经面板链序映射后上线
+void test_matrix_order_follows_chain_order(void)
+{
+    const PanelDescriptor& panel = panel_get();
+    const int size = panel_frame_size();
+    uint8_t frame[PANEL_MAX_CHIPS * 3];
+    uint8_t decoded[PANEL_MAX_CHIPS * 3];
+    for (int i = 0; i < size; ++i) {
+        frame[i] = (uint8_t)(i * 7 + 3);
+    }
+    send_data(frame, size, 0xFFFF);
+    TEST_ASSERT_EQUAL_INT(panel.chipCount, sid_test_decode_chain(decoded, sizeof(decoded)));
+    for (int i = 0; i < panel.chipCount; ++i) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(&frame[panel.chainOrder[i] * 3], &decoded[i * 3], 3);
+    }
+}
+
+// 相邻两帧之间的低电平（上一帧帧尾 + 本帧帧头）不短于芯片锁存时长
+void test_inter_frame_reset_meets_latch_time(void)
+{
+    for (int p = 0; p < PROFILE_COUNT; ++p) {
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(SID_TEST_RESET_TICKS, PROFILES[p]->tailLowTicks + PROFILES[p]->headLowTicks);
+    }
+}
+
+void test_invalid_profile_rejected(void)
+{
+    const SidTimingProfile tooShort = {"too-short", 4, 1};
+    const SidTimingProfile tooLong = {"too-long", 16320, 70000};
+    TEST_ASSERT_TRUE(sid_rmt_set_timing_profile(SID_TIMING_SID_MIN_SAFE));
+    TEST_ASSERT_FALSE(sid_rmt_set_timing_profile(tooShort));
+    TEST_ASSERT_FALSE(sid_rmt_set_timing_profile(tooLong));
+    TEST_ASSERT_EQUAL_UINT32(SID_TIMING_SID_MIN_SAFE.headLowTicks, sid_rmt_get_timing_profile().headLowTicks);
+    check_round_trip(SID_TIMING_SID_MIN_SAFE, 0x5AA5, 1);
+}
+
+// 按编号选档：保存后重启（重新 sid_rmt_init）仍生效，不保存则重启回到标准档
+void test_select_profile_by_id(void)
+{
+    TEST_ASSERT_EQUAL_UINT8(SID_TIMING_PROFILE_STANDARD, sid_rmt_get_timing_profile_id());
+    TEST_ASSERT_FALSE(sid_rmt_select_timing_profile(SID_TIMING_PROFILE_COUNT, true));
+    TEST_ASSERT_EQUAL_UINT8(SID_TIMING_PROFILE_STANDARD, sid_rmt_get_timing_profile_id());
+
+    TEST_ASSERT_TRUE(sid_rmt_select_timing_profile(SID_TIMING_PROFILE_SID_MIN_SAFE, true));
+    TEST_ASSERT_EQUAL_UINT8(SID_TIMING_PROFILE_SID_MIN_SAFE, sid_rmt_get_timing_profile_id());
+    check_round_trip(SID_TIMING_SID_MIN_SAFE, 0xFFFF, 2);
+
+    sid_rmt_set_timing_profile(SID_TIMING_STANDARD);
+    sid_rmt_init();
+    TEST_ASSERT_EQUAL_UINT8(SID_TIMING_PROFILE_SID_MIN_SAFE, sid_rmt_get_timing_profile_id());
+    check_round_trip(SID_TIMING_SID_MIN_SAFE, 0xFFFF, 3);
+
+    TEST_ASSERT_TRUE(sid_rmt_select_timing_profile(SID_TIMING_PROFILE_STANDARD, false));
+    sid_rmt_init();
+    TEST_ASSERT_EQUAL_UINT8(SID_TIMING_PROFILE_SID_MIN_SAFE, sid_rmt_get_timing_profile_id());
+
+    TEST_ASSERT_TRUE(sid_rmt_select_timing_profile(SID_TIMING_PROFILE_STANDARD, true));
+    sid_rmt_init();
+    TEST_ASSERT_EQUAL_UINT8(SID_TIMING_PROFILE_STANDARD, sid_rmt_get_timing_profile_id());
+    check_round_trip(SID_TIMING_STANDARD, 0xFFFF, 4);
+
+    const SidTimingProfile custom = {"custom", 1000, 20000};
+    TEST_ASSERT_TRUE(sid_rmt_set_timing_profile(custom));
+    TEST_ASSERT_EQUAL_UINT8(SID_TIMING_PROFILE_CUSTOM, sid_rmt_get_timing_profile_id());
+}
+
+// NVS中的编号无效时回退标准档
+void test_invalid_stored_profile_falls_back(void)
+{
+    Preferences prefs;
+    prefs.begin("sid_timing", false);
+    prefs.putUChar("id", 7);
+    prefs.end();
+    TEST_ASSERT_TRUE(sid_rmt_select_timing_profile(SID_TIMING_PROFILE_SID_MIN_SAFE, false));
+    sid_rmt_init();
+    TEST_ASSERT_EQUAL_UINT8(SID_TIMING_PROFILE_STANDARD, sid_rmt_get_timing_profile_id());
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip_each_profile);
+    RUN_TEST(test_every_byte_value);
+    RUN_TEST(test_matrix_order_follows_chain_order);
+    RUN_TEST(test_inter_frame_reset_meets_latch_time);
+    RUN_TEST(test_invalid_profile_rejected);
+    RUN_TEST(test_select_profile_by_id);
+    RUN_TEST(test_invalid_stored_profile_falls_back);
+    return UNITY_END();
+}
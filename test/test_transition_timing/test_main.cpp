@@ -0,0 +1,142 @@
+// 过渡按时间而非帧数推进：在 20/50/100fps 下，色温过渡、效果跨淡入与亮度斜坡
+// 都在请求时长之后的一帧之内完成，完成帧即为目标画面/亮度
+#include <unity.h>
+#include "sid_test_support.h"
+#include "anim_test_access.h"
+
+static const int FPS[] = {20, 50, 100};
+static const int FPS_COUNT = sizeof(FPS) / sizeof(FPS[0]);
+static const uint32_t DURATIONS_MS[] = {300, 1000, 1234, 1999};
+static const int DURATION_COUNT = sizeof(DURATIONS_MS) / sizeof(DURATIONS_MS[0]);
+
+static AnimSystem& anim_system(void)
+{
+    static AnimSystem anim;
+    static bool initialized = false;
+    if (!initialized) {
+        anim.init();
+        initialized = true;
+    }
+    return anim;
+}
+
+// 逐拍播放直到过渡结束，返回完成帧的显示时刻；完成帧须与 target 渲染结果一致
+static uint64_t run_until_done(AnimSystem& anim, int periodMs, AnimEffect* target)
+{
+    int drop = 0;
+    uint64_t showUs = 0;
+    AnimSystemTestAccess::setFrameDelay(anim, periodMs);
+    for (int n = 0; AnimSystemTestAccess::transitionActive(anim); ++n) {
+        TEST_ASSERT_TRUE_MESSAGE(n < 10000, "transition never finished");
+        showUs = AnimSystemTestAccess::tick(anim, &drop);
+        TEST_ASSERT_EQUAL_INT(0, drop);
+    }
+    int frameSize = AnimSystemTestAccess::frameSize(anim);
+    uint8_t expected[PANEL_MAX_CHIPS * 3];
+    AnimSystemTestAccess::renderEffectFrame(anim, target, 0, expected);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expected, AnimSystemTestAccess::latestFrame(anim), frameSize,
+                                          "finishing frame is the target");
+    return showUs;
+}
+
+static void assert_within_one_frame(uint64_t startUs, uint64_t doneUs, uint32_t durationMs, int periodMs)
+{
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%ums at %dfps finished after %lluus", (unsigned)durationMs, 1000 / periodMs,
+             (unsigned long long)(doneUs - startUs));
+    TEST_ASSERT_TRUE_MESSAGE(doneUs >= startUs + (uint64_t)durationMs * 1000, msg);
+    TEST_ASSERT_TRUE_MESSAGE(doneUs < startUs + (uint64_t)durationMs * 1000 + (uint64_t)periodMs * 1000, msg);
+}
+
+void setUp(void)
+{
+    sid_test_setup_default_panel();
+    sid_rmt_set_async(false);
+    sid_test_full_brightness();
+}
+
+void tearDown(void)
+{
+}
+
+void test_color_temp_transition_duration(void)
+{
+    AnimSystem& anim = anim_system();
+    ColorTempEffect cct(5, 3);
+    anim.stop();
+    anim.setCrossfadeMs(0);
+    anim.setEffect(&cct);
+    anim.start();
+    for (int f = 0; f < FPS_COUNT; ++f) {
+        int periodMs = 1000 / FPS[f];
+        for (int d = 0; d < DURATION_COUNT; ++d) {
+            anim.setStaticTransitionMs((int)DURATIONS_MS[d]);
+            uint64_t startUs = (uint64_t)esp_timer_get_time();
+            anim.updateColorTemp((uint8_t)(10 + 20 * d), (uint8_t)(1 + f), true);
+            uint64_t doneUs = run_until_done(anim, periodMs, &cct);
+            assert_within_one_frame(startUs, doneUs, DURATIONS_MS[d], periodMs);
+        }
+    }
+}
+
+void test_crossfade_duration(void)
+{
+    AnimSystem& anim = anim_system();
+    // 静态出入场：完成帧即目标效果的唯一一帧
+    ColorTempEffect cct(30, 2);
+    WhiteStaticEffect white(200);
+    AnimEffect* effects[] = {&cct, &white};
+    anim.stop();
+    anim.setCrossfadeMs(0);
+    anim.setEffect(&white);
+    anim.start();
+    int n = 0;
+    for (int f = 0; f < FPS_COUNT; ++f) {
+        int periodMs = 1000 / FPS[f];
+        for (int d = 0; d < DURATION_COUNT; ++d) {
+            AnimEffect* target = effects[n++ % 2];
+            anim.setCrossfadeMs((int)DURATIONS_MS[d]);
+            uint64_t startUs = (uint64_t)esp_timer_get_time();
+            anim.setEffect(target);
+            uint64_t doneUs = run_until_done(anim, periodMs, target);
+            assert_within_one_frame(startUs, doneUs, DURATIONS_MS[d], periodMs);
+        }
+    }
+}
+
+// 亮度斜坡由发送路径每帧取值：第一个取到目标亮度的帧落在时长之后一帧之内
+void test_brightness_ramp_duration(void)
+{
+    static const EaseCurve EASES[] = {EASE_LINEAR, EASE_PERCEPTUAL, EASE_IN_OUT_CUBIC};
+    uint8_t level = 100;
+    for (int f = 0; f < FPS_COUNT; ++f) {
+        uint32_t periodUs = 1000000u / FPS[f];
+        for (int d = 0; d < DURATION_COUNT; ++d) {
+            uint8_t target = level == 100 ? 10 : 100;
+            uint64_t startUs = (uint64_t)esp_timer_get_time();
+            start_brightness_ramp(target, DURATIONS_MS[d], EASES[d % 3]);
+            uint64_t doneUs = 0;
+            for (int n = 0; n < 10000; ++n) {
+                uint64_t nowUs = (uint64_t)esp_timer_get_time();
+                uint8_t b = get_brightness_frame();
+                if (!brightness_ramp_active()) {
+                    TEST_ASSERT_EQUAL_UINT8(target, b);
+                    doneUs = nowUs;
+                    break;
+                }
+                fake_clock_advance_us(periodUs);
+            }
+            assert_within_one_frame(startUs, doneUs, DURATIONS_MS[d], (int)(periodUs / 1000));
+            level = target;
+        }
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_color_temp_transition_duration);
+    RUN_TEST(test_crossfade_duration);
+    RUN_TEST(test_brightness_ramp_duration);
+    return UNITY_END();
+}
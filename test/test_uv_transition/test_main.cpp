@@ -0,0 +1,191 @@
+// 色温过渡的 u'v' 路径：沿途偏离普朗克轨迹的最大 Δu'v' 不超过两端自身偏移加 0.002，
+// 而 gamma RGB 直线混合中途明显偏绿/偏紫；两端精确，黑色一端只渐变亮度；报告逐帧求值耗时
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "uv_transition.h"
+#include "gamma_lut.h"
+#include "cct_engine.h"
+
+// 路径相对两端偏移的允许增量（u'v'），约为恰可察觉色差的一半
+#define UV_PATH_MAX_EXCURSION 0.002
+
+static double s_matrix[9];
+static double s_locusU[9501];
+static double s_locusV[9501];
+static int s_locusCount = 0;
+
+// 普朗克轨迹 1000-20000K（Krystek 1985 近似，CIE 1960 uv），换算到 u'v'
+static void build_locus(void)
+{
+    s_locusCount = 0;
+    for (double T = 1000; T <= 20000; T += 2) {
+        double u = (0.860117757 + 1.54118254e-4 * T + 1.28641212e-7 * T * T) / (1 + 8.42420235e-4 * T + 7.08145163e-7 * T * T);
+        double v = (0.317398726 + 4.22806245e-5 * T + 4.20481691e-8 * T * T) / (1 - 2.89741816e-5 * T + 1.61456053e-7 * T * T);
+        s_locusU[s_locusCount] = u;
+        s_locusV[s_locusCount] = 1.5 * v;
+        s_locusCount++;
+    }
+}
+
+// 8位RGB（码值线性）在灯具模型下到轨迹的最短距离；黑色记为0
+static double locus_distance(const uint8_t rgb[3])
+{
+    double lin[3] = {rgb[0] / 255.0, rgb[1] / 255.0, rgb[2] / 255.0};
+    double X = 0, Y = 0, Z = 0;
+    for (int k = 0; k < 3; ++k) {
+        X += s_matrix[k] * lin[k];
+        Y += s_matrix[3 + k] * lin[k];
+        Z += s_matrix[6 + k] * lin[k];
+    }
+    if (Y <= 1e-9) {
+        return 0;
+    }
+    double d = X + 15 * Y + 3 * Z;
+    double up = 4 * X / d;
+    double vp = 9 * Y / d;
+    double best = 1e9;
+    for (int i = 0; i < s_locusCount; ++i) {
+        double dist = hypot(s_locusU[i] - up, s_locusV[i] - vp);
+        if (dist < best) {
+            best = dist;
+        }
+    }
+    return best;
+}
+
+static UvFixture s_fixture;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 色温表中跨度不同的档位对（含DUV变体），双向过渡，逐 1/256 进度取最大偏离
+void test_max_locus_deviation(void)
+{
+    static const int PAIRS[][2] = {{1, 61}, {12, 50}, {1, 50}, {12, 36}, {31, 61}, {50, 51}, {1, 12}};
+    static const uint8_t DUVS[][2] = {{3, 3}, {1, 5}, {5, 1}, {2, 4}};
+    double worstPath = 0;
+    double worstGamma = 0;
+    char msg[160];
+    for (size_t p = 0; p < sizeof(PAIRS) / sizeof(PAIRS[0]); ++p) {
+        for (size_t d = 0; d < sizeof(DUVS) / sizeof(DUVS[0]); ++d) {
+            uint8_t from[3], to[3];
+            TEST_ASSERT_TRUE(cct_grid_rgb8((uint8_t)PAIRS[p][0], DUVS[d][0], &from[0], &from[1], &from[2]));
+            TEST_ASSERT_TRUE(cct_grid_rgb8((uint8_t)PAIRS[p][1], DUVS[d][1], &to[0], &to[1], &to[2]));
+            for (int dir = 0; dir < 2; ++dir) {
+                const uint8_t* a = dir ? to : from;
+                const uint8_t* b = dir ? from : to;
+                UvTransition tr;
+                TEST_ASSERT_TRUE(uv_transition_plan(&tr, &s_fixture, a, b));
+                double ends = fmax(locus_distance(a), locus_distance(b));
+                double maxPath = 0;
+                double maxGamma = 0;
+                for (uint32_t s = 0; s <= 256; ++s) {
+                    uint8_t out[3];
+                    uv_transition_eval(&tr, s * 256, out);
+                    maxPath = fmax(maxPath, locus_distance(out));
+                    gamma_blend_frame(a, b, out, 3, s * GAMMA_BLEND_ONE / 256, true);
+                    maxGamma = fmax(maxGamma, locus_distance(out));
+                }
+                worstPath = fmax(worstPath, maxPath - ends);
+                worstGamma = fmax(worstGamma, maxGamma - ends);
+                if (maxPath - ends > UV_PATH_MAX_EXCURSION) {
+                    snprintf(msg, sizeof(msg), "%uK/%u -> %uK/%u: u'v' path %.4f from locus, endpoints %.4f",
+                             cct_step_kelvin((uint8_t)PAIRS[p][dir]), DUVS[d][dir],
+                             cct_step_kelvin((uint8_t)PAIRS[p][1 - dir]), DUVS[d][1 - dir], maxPath, ends);
+                    TEST_FAIL_MESSAGE(msg);
+                }
+            }
+        }
+    }
+    snprintf(msg, sizeof(msg), "max du'v' beyond endpoints: u'v' path %.4f, gamma RGB blend %.4f", worstPath, worstGamma);
+    TEST_MESSAGE(msg);
+    // 对照：RGB直线混合的偏离远大于路径
+    TEST_ASSERT_TRUE(worstGamma > 10 * worstPath);
+}
+
+void test_endpoints_exact(void)
+{
+    for (int t = 1; t <= CCT_STEP_COUNT; t += 3) {
+        for (int u = 1; u <= CCT_STEP_COUNT; u += 7) {
+            uint8_t a[3], b[3], out[3];
+            cct_grid_rgb8((uint8_t)t, (uint8_t)(1 + t % 5), &a[0], &a[1], &a[2]);
+            cct_grid_rgb8((uint8_t)u, (uint8_t)(1 + u % 5), &b[0], &b[1], &b[2]);
+            UvTransition tr;
+            TEST_ASSERT_TRUE(uv_transition_plan(&tr, &s_fixture, a, b));
+            uv_transition_eval(&tr, 0, out);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(a, out, 3);
+            uv_transition_eval(&tr, 65536, out);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(b, out, 3);
+        }
+    }
+}
+
+// 黑色一端保持另一端色度只渐变亮度；两端都是黑色时不规划
+void test_black_endpoint(void)
+{
+    uint8_t black[3] = {0, 0, 0};
+    uint8_t white[3];
+    uint8_t out[3];
+    cct_grid_rgb8(30, 3, &white[0], &white[1], &white[2]);
+    UvTransition tr;
+    TEST_ASSERT_TRUE(uv_transition_plan(&tr, &s_fixture, black, white));
+    uv_transition_eval(&tr, 0, out);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(black, out, 3);
+    uv_transition_eval(&tr, 65536, out);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(white, out, 3);
+    double ends = locus_distance(white);
+    for (uint32_t s = 32; s < 256; s += 32) {
+        uv_transition_eval(&tr, s * 256, out);
+        TEST_ASSERT_TRUE(locus_distance(out) <= ends + UV_PATH_MAX_EXCURSION);
+    }
+    TEST_ASSERT_FALSE(uv_transition_plan(&tr, &s_fixture, black, black));
+}
+
+// 主机基准：逐帧求值与 gamma RGB 混合的单色耗时（仅报告）
+void test_eval_cost(void)
+{
+    uint8_t a[3], b[3], out[3];
+    cct_grid_rgb8(1, 3, &a[0], &a[1], &a[2]);
+    cct_grid_rgb8(61, 3, &b[0], &b[1], &b[2]);
+    UvTransition tr;
+    TEST_ASSERT_TRUE(uv_transition_plan(&tr, &s_fixture, a, b));
+    const int N = 2000000;
+    volatile unsigned sink = 0;
+    clock_t t0 = clock();
+    for (int i = 0; i < N; ++i) {
+        uv_transition_eval(&tr, (uint32_t)(i * 13) & 0xFFFF, out);
+        sink = sink + out[0];
+    }
+    clock_t t1 = clock();
+    for (int i = 0; i < N; ++i) {
+        gamma_blend_frame(a, b, out, 3, (uint32_t)(i * 13) & 0xFFF, true);
+        sink = sink + out[0];
+    }
+    clock_t t2 = clock();
+    char msg[128];
+    snprintf(msg, sizeof(msg), "per frame: u'v' eval %.1f ns, gamma RGB blend %.1f ns",
+             (t1 - t0) * 1e9 / CLOCKS_PER_SEC / N, (t2 - t1) * 1e9 / CLOCKS_PER_SEC / N);
+    TEST_MESSAGE(msg);
+}
+
+int main(void)
+{
+    for (int i = 0; i < 9; ++i) {
+        s_matrix[i] = UV_FIXTURE_DEFAULT_MATRIX[i];
+    }
+    build_locus();
+    uv_fixture_init(&s_fixture, UV_FIXTURE_DEFAULT_MATRIX);
+    UNITY_BEGIN();
+    RUN_TEST(test_max_locus_deviation);
+    RUN_TEST(test_endpoints_exact);
+    RUN_TEST(test_black_endpoint);
+    RUN_TEST(test_eval_cost);
+    return UNITY_END();
+}